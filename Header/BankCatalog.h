@@ -0,0 +1,111 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct BankReadOptions;
+
+namespace BankCatalogStatics
+{
+    constexpr std::string_view CATALOG_HEADER = "# OpenSoundbankConverter bank catalog v1";
+    constexpr std::string_view DEFAULT_CATALOG_NAME = "bank_catalog.tsv";
+}
+
+struct CatalogPreset final
+{
+    std::string m_presetName;
+    uint32_t m_numVoices = 0u;
+    uint16_t m_index = 0ui16;
+
+    // Union of the voices' key zones
+    uint8_t m_keyLow = 0ui8;
+    uint8_t m_keyHigh = 127ui8;
+};
+
+struct CatalogSample final
+{
+    std::string m_sampleName;
+    uint64_t m_numFrames = 0u;
+    uint32_t m_sampleRate = 0u;
+    uint32_t m_channels = 1u;
+    uint16_t m_index = 0ui16;
+    bool m_isLooping = false;
+};
+
+struct CatalogSequence final
+{
+    std::string m_sequenceName;
+    uint64_t m_size = 0u; // MIDI data bytes
+    uint16_t m_index = 0ui16;
+};
+
+struct CatalogBank final
+{
+    // Empty when the file could not be read, it is only read again once the file changes
+    [[nodiscard]] bool IsValid() const { return !m_bankName.empty(); }
+
+    std::filesystem::path m_file;
+    std::string m_bankName;
+    uint64_t m_fileHash = 0u; // FNV-1a of the file
+    uint64_t m_fileSize = 0u;
+    int64_t m_fileWriteTime = 0;
+    std::vector<CatalogPreset> m_presets{};
+    std::vector<CatalogSample> m_samples{};
+    std::vector<CatalogSequence> m_sequences{};
+};
+
+struct CatalogUpdateResult final
+{
+    uint32_t m_numUnchanged = 0u;
+    uint32_t m_numIndexed = 0u;
+    uint32_t m_numFailed = 0u;
+    uint32_t m_numRemoved = 0u;
+};
+
+template<typename T>
+struct CatalogMatch final
+{
+    const CatalogBank* m_bank = nullptr;
+    const T* m_item = nullptr;
+};
+
+/*
+ * Persistent index of the presets, samples and sequences in a library of banks, so searching it never opens a bank.
+ * Stored tab separated (a bank line followed by its preset / sample / sequence lines) and saved through a temp file and rename.
+ * Update only reads banks whose size and write time changed, and of those only parses the ones whose content hash changed too.
+ */
+struct BankCatalog final
+{
+    [[nodiscard]] bool Load(const std::filesystem::path& catalogFile);
+    [[nodiscard]] bool Save(const std::filesystem::path& catalogFile) const;
+
+    // Indexes new and changed banks in parallel and drops banks whose file no longer exists
+    CatalogUpdateResult Update(const std::vector<std::filesystem::path>& files, const BankReadOptions& readOptions);
+
+    [[nodiscard]] const CatalogBank* FindBank(const std::filesystem::path& file) const;
+
+    // Case-insensitive, a match anywhere in the name counts
+    [[nodiscard]] std::vector<CatalogMatch<CatalogSequence>> FindSequences(const std::string_view& name) const;
+    [[nodiscard]] std::vector<CatalogMatch<CatalogPreset>> FindPresets(const std::string_view& name) const;
+
+    // Presets whose key range spans all of [keyLow, keyHigh]
+    [[nodiscard]] std::vector<CatalogMatch<CatalogPreset>> FindPresetsCovering(uint8_t keyLow, uint8_t keyHigh) const;
+
+    [[nodiscard]] const std::vector<CatalogBank>& GetBanks() const { return m_banks; }
+
+private:
+    [[nodiscard]] static bool IndexBank(const std::filesystem::path& file, const BankReadOptions& readOptions, const CatalogBank* previousBank,
+        CatalogBank& outBank, bool& outParsed);
+    [[nodiscard]] static bool ContainsCI(const std::string_view& str, const std::string_view& subStr);
+
+    [[nodiscard]] static std::string SerializeBank(const CatalogBank& bank);
+    [[nodiscard]] static bool DeserializeLine(const std::string& line, std::vector<CatalogBank>& banks);
+
+    void RebuildIndices();
+
+    std::vector<CatalogBank> m_banks{};
+    std::unordered_map<std::string, size_t> m_bankIndices{};
+};
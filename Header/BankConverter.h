@@ -1,10 +1,31 @@
 #pragma once
+#include "Header/IO/BufferPool.h"
+#include <filesystem>
 
+struct AsyncIOBackend;
 struct BankWriteOptions;
+struct BinaryWriter;
 struct Soundbank;
 
+// Encoded bank that has not been written to disk yet
+struct BankOutputFile final
+{
+	std::filesystem::path m_path;
+	BinaryBuffer m_data{};
+};
+
 namespace BankConverter
 {
 	[[nodiscard]] bool CreateSF2(const Soundbank& bank, const BankWriteOptions& options);
 	[[nodiscard]] bool CreateE4B(const Soundbank& bank, const BankWriteOptions& options);
-};
\ No newline at end of file
+
+	// Writes a folder of .sfz presets and WAV samples through 'ioBackend', returns the folder in 'outFolder'
+	[[nodiscard]] bool CreateSFZ(const Soundbank& bank, const BankWriteOptions& options, AsyncIOBackend& ioBackend, std::filesystem::path& outFolder);
+
+	// Encodes into memory, the output path is resolved from the save folder but nothing is written
+	[[nodiscard]] bool EncodeSF2(const Soundbank& bank, const BankWriteOptions& options, BankOutputFile& outFile);
+	[[nodiscard]] bool EncodeE4B(const Soundbank& bank, const BankWriteOptions& options, BankOutputFile& outFile);
+	[[nodiscard]] bool EncodeSnapshot(const Soundbank& bank, const BankWriteOptions& options, BankOutputFile& outFile);
+
+	void WriteE4BData(const Soundbank& bank, BinaryWriter& writer);
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include "Header/Data/Soundbank.h"
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace BankDetailsCacheStatics
+{
+    // Banks kept after their details window is closed, the least recently viewed is dropped first
+    constexpr size_t MAX_CACHED_BANKS = 16;
+}
+
+enum struct EBankDetailsState final : uint8_t
+{
+    NOT_LOADED,
+    LOADING,
+    READY,
+    FAILED
+};
+
+// A parsed bank without its sample data, only the size of each sample is kept
+struct BankDetails final
+{
+    explicit BankDetails(Soundbank&& bank);
+
+    Soundbank m_bank;
+    std::vector<size_t> m_sampleSizes{}; // Values per sample, indexed like m_bank.m_samples
+
+    // Made once on the loader thread rather than every frame
+    std::vector<std::string> m_presetLabels{};
+    std::vector<size_t> m_firstVoiceIndices{}; // Per preset, into all of the bank's voices in preset order
+    size_t m_numVoices = 0;
+};
+
+/*
+ * Recently viewed banks for the "View Details" window, keyed by path and write time.
+ * Banks are parsed one at a time on a loader thread, so opening a large bank never stalls the UI, and reopening one is instant.
+ */
+struct BankDetailsCache final
+{
+    BankDetailsCache() = default;
+    BankDetailsCache(BankDetailsCache const&) = delete; BankDetailsCache& operator=(const BankDetailsCache&) = delete;
+    ~BankDetailsCache();
+
+    // Starts loading the bank unless it is already cached (and unchanged on disk) or loading
+    void Load(const std::filesystem::path& file);
+
+    // Does not touch the disk, so it can be called every frame
+    [[nodiscard]] EBankDetailsState GetDetails(const std::filesystem::path& file, std::shared_ptr<const BankDetails>& outDetails) const;
+
+private:
+    struct CacheEntry final
+    {
+        std::string m_key;
+        std::shared_ptr<const BankDetails> m_details;
+        int64_t m_fileWriteTime = 0;
+        uint64_t m_lastUsed = 0u;
+        EBankDetailsState m_state = EBankDetailsState::LOADING;
+    };
+
+    void LoaderThread();
+    void EvictOldest();
+    [[nodiscard]] CacheEntry* FindEntry(const std::string& key);
+
+    std::vector<CacheEntry> m_entries{};
+    std::deque<std::filesystem::path> m_pendingLoads{};
+    std::thread m_loaderThread;
+    std::condition_variable m_loadCondition;
+    mutable std::mutex m_mutex;
+    uint64_t m_useCounter = 0u;
+    bool m_isShuttingDown = false;
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct BankDetails;
+
+enum struct EDetailsRowType final : uint8_t
+{
+    SECTION, // m_index is EDetailsSection
+    PRESET,
+    VOICE, // m_subIndex is the voice within the preset
+    VOICE_INFO,
+    SAMPLE,
+    SAMPLE_INFO,
+    SEQUENCE,
+    SEQUENCE_EXTRACT
+};
+
+enum struct EDetailsSection final : uint8_t
+{
+    PRESETS,
+    SAMPLES,
+    SEQUENCES
+};
+
+namespace BankDetailsViewStatics
+{
+    constexpr std::array SECTION_NAMES{"Presets", "Samples", "Sequences"};
+
+    // Lines listed under an open voice / sample, one row each
+    constexpr uint16_t NUM_VOICE_INFO_LINES = 7ui16;
+    constexpr uint16_t NUM_SAMPLE_INFO_LINES = 6ui16;
+}
+
+struct DetailsRow final
+{
+    EDetailsRowType m_type = EDetailsRowType::SECTION;
+    uint8_t m_depth = 0ui8;
+    uint16_t m_line = 0ui16; // For the info rows
+    uint32_t m_index = 0u;
+    uint32_t m_subIndex = 0u;
+};
+
+/*
+ * The bank details tree flattened into one row per visible line, so the window can clip it and only draw what is on screen.
+ * Open nodes are tracked here rather than by ImGui, and the rows are only rebuilt when a node is opened or closed.
+ */
+struct BankDetailsView final
+{
+    // Everything starts closed again when the bank changes
+    void SetBank(const std::shared_ptr<const BankDetails>& details);
+    [[nodiscard]] const BankDetails* GetBank() const { return m_details.get(); }
+
+    [[nodiscard]] const std::vector<DetailsRow>& GetRows();
+
+    [[nodiscard]] bool IsOpen(const DetailsRow& row) const;
+    void SetOpen(const DetailsRow& row, bool isOpen);
+
+private:
+    [[nodiscard]] const uint8_t* GetOpenState(const DetailsRow& row) const;
+    void RebuildRows();
+
+    std::shared_ptr<const BankDetails> m_details;
+    std::vector<DetailsRow> m_rows{};
+    std::array<uint8_t, BankDetailsViewStatics::SECTION_NAMES.size()> m_sectionsOpen{};
+    std::vector<uint8_t> m_presetsOpen{};
+    std::vector<uint8_t> m_voicesOpen{}; // Indexed like BankDetails::m_firstVoiceIndices
+    std::vector<uint8_t> m_samplesOpen{};
+    std::vector<uint8_t> m_sequencesOpen{};
+    bool m_rowsDirty = true;
+};
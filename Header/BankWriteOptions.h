@@ -9,6 +9,23 @@ struct BankWriteOptions final
     
     bool m_useConverterSpecificData = true;
 
+    // SF2 output is written as SF3, with every sample FLAC compressed
+    bool m_compressSamples = false;
+
+    // Conversion
+
+    // Cap on the memory held by banks being converted at once, workers wait for memory to free up before starting another bank
+    uint32_t m_memoryBudgetMB = 1024u;
+
+    // Writes per-bank stage timings and counters (JSON + Chrome trace) next to the converted banks
+    bool m_exportProfiles = false;
+
+    // Strips leading and trailing silence from samples, loops are kept intact
+    bool m_trimSilence = false;
+
+    // Samples at any other rate are resampled to this one, 0 keeps every sample at its own rate
+    uint32_t m_targetSampleRate = 0u;
+
     // Saving
     
     std::filesystem::path m_saveFolder;
@@ -0,0 +1,63 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+enum struct EBatchStatus final : uint8_t
+{
+    PENDING,
+    DONE,
+    FAILED
+};
+
+struct BatchManifestEntry final
+{
+    std::filesystem::path m_inputFile;
+    std::filesystem::path m_outputFile;
+    uint64_t m_inputHash = 0u; // FNV-1a of the input file
+    uint64_t m_inputSize = 0u;
+    int64_t m_inputWriteTime = 0;
+    double m_durationMs = 0.;
+    EBatchStatus m_status = EBatchStatus::PENDING;
+};
+
+namespace BatchManifestStatics
+{
+    constexpr std::string_view MANIFEST_HEADER = "# OpenSoundbankConverter batch manifest v1";
+    constexpr std::string_view DEFAULT_MANIFEST_NAME = "conversion_manifest.tsv";
+
+    // Indexed by EBatchStatus
+    constexpr std::array STATUS_NAMES{std::string_view("PENDING"), std::string_view("DONE"), std::string_view("FAILED")};
+}
+
+/*
+ * Tab separated record of every bank in a batch conversion.
+ * Completions are appended as single lines (one write each), a later line for the same input replaces the earlier one on load.
+ * Save compacts the journal by writing a temp file and renaming it over the manifest.
+ */
+struct BatchManifest final
+{
+    [[nodiscard]] bool Load(const std::filesystem::path& manifestFile);
+    [[nodiscard]] bool Save(const std::filesystem::path& manifestFile) const;
+    [[nodiscard]] bool AppendEntry(const std::filesystem::path& manifestFile, const BatchManifestEntry& entry) const;
+
+    [[nodiscard]] BatchManifestEntry* FindEntry(const std::filesystem::path& inputFile);
+    BatchManifestEntry& AddOrUpdateEntry(const BatchManifestEntry& entry);
+
+    [[nodiscard]] const std::vector<BatchManifestEntry>& GetEntries() const { return m_entries; }
+
+    // Manifest paths are stored as UTF-8 regardless of platform
+    [[nodiscard]] static std::string PathToUTF8(const std::filesystem::path& path);
+    [[nodiscard]] static std::filesystem::path PathFromUTF8(const std::string_view& str);
+
+private:
+    [[nodiscard]] static std::string GetEntryKey(const std::filesystem::path& inputFile);
+    [[nodiscard]] static std::string SerializeEntry(const BatchManifestEntry& entry);
+    [[nodiscard]] static bool DeserializeEntry(const std::string& line, BatchManifestEntry& outEntry);
+
+    std::vector<BatchManifestEntry> m_entries{};
+    std::unordered_map<std::string, size_t> m_entryIndices{};
+};
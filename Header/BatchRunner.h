@@ -0,0 +1,48 @@
+#pragma once
+#include "Header/BatchManifest.h"
+#include "Header/ConversionPipeline.h"
+#include <mutex>
+
+struct BatchSummary final
+{
+    uint32_t m_numSkipped = 0u;
+    uint32_t m_numConverted = 0u;
+    uint32_t m_numFailed = 0u;
+};
+
+/*
+ * Resumable batch conversion on top of ConversionPipeline.
+ * Every finished bank is journaled to the manifest straight away, a rerun with the same manifest skips banks that are
+ * already done (and whose input is unchanged), and retries the ones that failed or never finished.
+ */
+struct BatchRunner final
+{
+    BatchRunner() : m_pipeline(ConversionPipelineStatics::DEFAULT_NUM_TRANSFORM_WORKERS) {}
+    BatchRunner(BatchRunner const&) = delete; BatchRunner& operator=(const BatchRunner&) = delete;
+
+    // Returns false if a batch is already running
+    bool Start(const std::filesystem::path& manifestFile, std::vector<ConversionJob>&& jobs, const BankReadOptions& readOptions,
+        const BankWriteOptions& writeOptions);
+
+    // Blocks until the batch is done and compacts the manifest
+    BatchSummary Wait();
+
+    [[nodiscard]] bool IsRunning() const { return m_pipeline.IsRunning(); }
+    [[nodiscard]] uint32_t GetNumBanksInProgress() const { return m_pipeline.GetNumBanksInProgress(); }
+    [[nodiscard]] BatchSummary GetSummary() const;
+    [[nodiscard]] std::vector<std::filesystem::path> GetFailedInputs() const;
+
+    [[nodiscard]] static std::filesystem::path GetExpectedOutputFile(const ConversionJob& job, const BankWriteOptions& writeOptions);
+
+private:
+    // Only looks at the file system, when just the write time differs the job is flagged for the transform worker to compare hashes
+    [[nodiscard]] bool IsUpToDate(const BatchManifestEntry& entry, ConversionJob& job, const BankWriteOptions& writeOptions) const;
+    void OnBankComplete(const ConversionResult& result);
+
+    ConversionPipeline m_pipeline;
+    BatchManifest m_manifest;
+    std::filesystem::path m_manifestFile;
+    std::vector<std::filesystem::path> m_failedInputs{};
+    mutable std::mutex m_manifestMutex;
+    BatchSummary m_summary{};
+};
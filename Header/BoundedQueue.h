@@ -0,0 +1,71 @@
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <queue>
+
+/*
+ * Fixed capacity queue used between pipeline stages.
+ * Push blocks while the queue is full, which is what applies backpressure to the stage before it.
+ */
+template<typename T>
+struct BoundedQueue final
+{
+    explicit BoundedQueue(const size_t capacity) : m_capacity(capacity) {}
+    BoundedQueue(BoundedQueue const&) = delete; BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // Returns false if the queue was closed before the item could be pushed
+    bool Push(T&& item)
+    {
+        std::unique_lock uLock(m_mutex);
+        m_notFull.wait(uLock, [this] { return m_isClosed || m_items.size() < m_capacity; });
+        if (m_isClosed) { return false; }
+
+        m_items.push(std::move(item));
+        uLock.unlock();
+
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    // Returns nullopt once the queue is closed and fully drained
+    [[nodiscard]] std::optional<T> Pop()
+    {
+        std::unique_lock uLock(m_mutex);
+        m_notEmpty.wait(uLock, [this] { return m_isClosed || !m_items.empty(); });
+        if (m_items.empty()) { return std::nullopt; }
+
+        std::optional<T> outItem(std::move(m_items.front()));
+        m_items.pop();
+        uLock.unlock();
+
+        m_notFull.notify_one();
+        return outItem;
+    }
+
+    void Close()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_isClosed = true;
+        }
+
+        m_notEmpty.notify_all();
+        m_notFull.notify_all();
+    }
+
+    void Reset()
+    {
+        std::lock_guard lock(m_mutex);
+        m_items = {};
+        m_isClosed = false;
+    }
+
+private:
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+    std::queue<T> m_items{};
+    std::mutex m_mutex;
+    size_t m_capacity = 0;
+    bool m_isClosed = false;
+};
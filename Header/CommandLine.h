@@ -0,0 +1,36 @@
+#pragma once
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/*
+ * Headless entry points, used when the executable is started with arguments.
+ * Arguments are UTF-8 and exclude the executable path.
+ */
+namespace CommandLine
+{
+    // Returns the process exit code
+    [[nodiscard]] int Run(const std::vector<std::string>& args);
+    void PrintUsage();
+
+    // batch --to <sf2|e4b|sfz|osb> --out <folder> [--manifest <file>] [--memory-mb <n>] [--profile] [--sf3] [--trim] [--rate <44100|48000>] <files or folders...>
+    [[nodiscard]] int RunBatch(const std::vector<std::string>& args);
+
+    // catalog --catalog <file> [--sequence <name>] [--preset <name>] [--keys <low>-<high>] [files or folders to index...]
+    [[nodiscard]] int RunCatalog(const std::vector<std::string>& args);
+
+    // snapshot <osb files or folders...>
+    [[nodiscard]] int RunSnapshotInfo(const std::vector<std::string>& args);
+
+    // verify --baseline <file> [--update] <sf2/sf3 files or folders...>
+    [[nodiscard]] int RunVerify(const std::vector<std::string>& args);
+
+    // Expands folders (recursively) into the files matching any of the extensions
+    [[nodiscard]] std::vector<std::filesystem::path> GatherInputFiles(const std::vector<std::filesystem::path>& inputs,
+        const std::vector<std::string_view>& extensions);
+    [[nodiscard]] std::filesystem::path PathFromArg(const std::string& arg);
+
+    // MIDI key number or note name (C4 = 60, sharps only)
+    [[nodiscard]] bool ParseKey(const std::string_view& str, uint8_t& outKey);
+    [[nodiscard]] bool HasExtensionCI(const std::filesystem::path& file, const std::string_view& extension);
+}
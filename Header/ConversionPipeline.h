@@ -0,0 +1,152 @@
+#pragma once
+#include "Header/BankConverter.h"
+#include "Header/BankReadOptions.h"
+#include "Header/BankWriteOptions.h"
+#include "Header/BoundedQueue.h"
+#include "Header/IO/AsyncIO.h"
+#include "Header/MemoryBudget.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+
+struct BankProfile;
+
+struct BinaryReader;
+
+enum struct EBankFormat final : uint8_t
+{
+    E4B,
+    SF2,
+    SFZ, // Output only
+    SNAPSHOT // .osb, see BankSnapshot
+};
+
+struct ConversionJob final
+{
+    std::filesystem::path m_file;
+    EBankFormat m_sourceFormat = EBankFormat::E4B;
+    EBankFormat m_targetFormat = EBankFormat::SF2;
+
+    // When set, a bank whose input still hashes to this is reported as unchanged instead of converted
+    uint64_t m_unchangedInputHash = 0u;
+};
+
+struct ConversionResult final
+{
+    std::filesystem::path m_inputFile;
+    std::filesystem::path m_outputFile;
+    uint64_t m_inputHash = 0u; // FNV-1a of the input file
+    uint64_t m_inputSize = 0u; // Size and write time are taken before the read, so a change made mid-conversion is seen next run
+    int64_t m_inputWriteTime = 0;
+    double m_durationMs = 0.;
+    size_t m_jobIndex = 0;
+    bool m_succeeded = false;
+    bool m_wasUnchanged = false; // See ConversionJob::m_unchangedInputHash, nothing was written
+};
+
+// Called once per job as it finishes (or fails), may be called from any pipeline or I/O thread
+using ConversionCompleteCallback = std::function<void(const ConversionResult& result)>;
+
+namespace ConversionPipelineStatics
+{
+    constexpr uint32_t DEFAULT_NUM_TRANSFORM_WORKERS = 4u;
+    constexpr size_t QUEUE_CAPACITY = 2;
+
+    // Number of input files read ahead of the transform workers
+    constexpr size_t PREFETCH_DEPTH = 4;
+
+    // Outputs are written under this suffix and renamed once complete, so a partial file never has the final name
+    constexpr std::string_view TEMP_FILE_SUFFIX = ".tmp";
+
+    /*
+     * Rough peak memory per byte of input file: the file itself, the decoded bank and the encoded output.
+     * SF2 input also holds TinySoundFont's float copy of the samples while parsing.
+     */
+    constexpr size_t E4B_MEMORY_FACTOR = 3;
+    constexpr size_t SF2_MEMORY_FACTOR = 5;
+    constexpr size_t SNAPSHOT_MEMORY_FACTOR = 3;
+}
+
+/*
+ * Converts banks in three stages: a reader thread, transform workers (parse + encode into memory) and a writer thread.
+ * The stages are joined by bounded queues and every bank reserves its estimated memory before it is read,
+ * so the reader waits instead of pulling in another large bank once the budget is used up.
+ * File I/O goes through an AsyncIOBackend, the reader keeps a few files prefetching and the writer never waits on a write.
+ */
+struct ConversionPipeline final
+{
+    explicit ConversionPipeline(uint32_t numTransformWorkers);
+    ConversionPipeline(ConversionPipeline const&) = delete; ConversionPipeline& operator=(const ConversionPipeline&) = delete;
+    ~ConversionPipeline();
+
+    // Returns false if the previous conversion is still running
+    bool Start(std::vector<ConversionJob>&& jobs, const BankReadOptions& readOptions, const BankWriteOptions& writeOptions,
+        ConversionCompleteCallback&& onComplete = {});
+    void Cancel();
+    void Wait();
+
+    [[nodiscard]] bool IsRunning() const { return m_numBanksInProgress.load() > 0u; }
+    [[nodiscard]] uint32_t GetNumBanksInProgress() const { return m_numBanksInProgress.load(); }
+    [[nodiscard]] size_t GetBytesInFlight() const { return m_memoryBudget.GetBytesInUse(); }
+
+    [[nodiscard]] static size_t GetEstimatedBankMemory(const ConversionJob& job);
+
+private:
+    // Follows a bank through every stage
+    struct BankTicket final
+    {
+        std::filesystem::path m_inputFile;
+        std::chrono::steady_clock::time_point m_startTime{};
+        uint64_t m_inputHash = 0u;
+        size_t m_jobIndex = 0;
+        size_t m_reservedBytes = 0;
+        std::shared_ptr<BankProfile> m_profile; // Only set when exporting profiles
+        uint64_t m_inputSize = 0u;
+        int64_t m_inputWriteTime = 0;
+        bool m_wasUnchanged = false;
+    };
+
+    struct ReadItem final
+    {
+        ConversionJob m_job;
+        std::unique_ptr<BinaryReader> m_reader;
+        BankTicket m_ticket;
+    };
+
+    struct PendingRead final
+    {
+        ConversionJob m_job;
+        uint64_t m_requestId = 0u;
+        BankTicket m_ticket;
+        std::chrono::steady_clock::time_point m_submitTime{};
+    };
+
+    struct WriteItem final
+    {
+        BankOutputFile m_output;
+        BankTicket m_ticket;
+    };
+
+    void ReadStage(std::vector<ConversionJob> jobs);
+    void TransformStage();
+    [[nodiscard]] Soundbank ReadBank(const ConversionJob& job, BinaryReader& reader) const;
+    void WriteStage();
+    void FinishBank(const BankTicket& ticket, const std::filesystem::path& outputFile, bool succeeded);
+    void JoinAll();
+
+    BoundedQueue<ReadItem> m_readQueue;
+    BoundedQueue<WriteItem> m_writeQueue;
+    MemoryBudget m_memoryBudget;
+    std::unique_ptr<AsyncIOBackend> m_ioBackend;
+    BankReadOptions m_readOptions{};
+    BankWriteOptions m_writeOptions{};
+    ConversionCompleteCallback m_onComplete;
+    std::thread m_readThread;
+    std::vector<std::thread> m_transformThreads{};
+    std::thread m_writeThread;
+    std::atomic<uint32_t> m_numBanksInProgress{0u};
+    std::atomic<uint32_t> m_numActiveTransformWorkers{0u};
+    uint32_t m_numTransformWorkers = 0u;
+};
@@ -124,6 +124,15 @@ struct BankSequence final
     uint16_t m_index = 0ui16;
 };
 
+// An E4Ma chunk, only its index and name are known
+struct BankMultisampleMap final
+{
+    explicit BankMultisampleMap(const uint16_t index, std::string&& name) : m_mapName(std::move(name)), m_index(index) {}
+
+    std::string m_mapName;
+    uint16_t m_index = 0ui16;
+};
+
 struct Soundbank final
 {
     explicit Soundbank(std::string&& name) : m_bankName(std::move(name)) {}
@@ -136,5 +145,6 @@ struct Soundbank final
     std::vector<BankPreset> m_presets{};
     std::vector<BankSample> m_samples{};
     std::vector<BankSequence> m_sequences{};
+    std::vector<BankMultisampleMap> m_multisampleMaps{};
     uint8_t m_defaultPreset = 255ui8;
 };
\ No newline at end of file
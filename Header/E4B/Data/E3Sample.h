@@ -1,5 +1,7 @@
 #pragma once
 #include "Header/E4B/Helpers/E4BVariables.h"
+#include "Header/IO/BigEndian.h"
+#include <span>
 #include <vector>
 
 struct ReadLocationHandle;
@@ -26,6 +28,8 @@ struct E3SampleParams final
 
     void write(BinaryWriter& writer) const;
     void readAtLocation(ReadLocationHandle& readHandle);
+
+    struct Layout; // Where each field sits in the file
     
     uint32_t m_unknown = 0u;
     uint32_t m_leftChannelStart = static_cast<uint32_t>(E3SampleVariables::TOTAL_SAMPLE_DATA_READ_SIZE);
@@ -41,7 +45,7 @@ struct E3SampleParams final
 struct E3Sample final
 {
     explicit E3Sample(const E4TOCChunk& chunk, BinaryReader& reader);
-    explicit E3Sample(const BankSample& sample);
+    explicit E3Sample(const BankSample& sample); // Borrows the sample's data, so the sample has to outlive this
 
     void write(BinaryWriter& writer) const;
     
@@ -50,7 +54,7 @@ struct E3Sample final
     [[nodiscard]] std::vector<int16_t>& GetData() { return m_sampleData; }
 	[[nodiscard]] uint32_t GetSampleRate() const { return m_sampleRate; }
 	[[nodiscard]] uint32_t GetFormat() const { return m_format; }
-	[[nodiscard]] uint16_t GetIndex() const { return _byteswap_ushort(m_sampleIndex); }
+	[[nodiscard]] uint16_t GetIndex() const { return m_sampleIndex; }
     [[nodiscard]] uint32_t GetNumChannels() const;
     [[nodiscard]] uint32_t GetLoopStart() const;
     [[nodiscard]] uint32_t GetLoopEnd() const;
@@ -58,12 +62,13 @@ struct E3Sample final
     [[nodiscard]] bool IsLoopReleasing() const;
     
 private:
+    struct Layout; // Where each field sits in the file
 
     /*
      * Read data (follows SAMPLE_DATA_READ_SIZE)
      */
     
-	uint16_t m_sampleIndex = 0ui16; // requires byteswap
+	BigEndian<uint16_t> m_sampleIndex = 0ui16;
 	std::array<char, E4BVariables::EOS_E4_MAX_NAME_LEN> m_name{};
     
     E3SampleParams m_params = E3SampleParams(0u, 0u, 0u);
@@ -78,4 +83,5 @@ private:
      */
     
     std::vector<int16_t> m_sampleData{};
+    std::span<const int16_t> m_bankSampleData{}; // Written straight from the BankSample rather than copied
 };
\ No newline at end of file
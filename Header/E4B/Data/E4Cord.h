@@ -5,6 +5,8 @@ struct ReadLocationHandle;
 struct BinaryReader;
 struct BinaryWriter;
 
+constexpr uint64_t E4_CORD_DATA_SIZE = 4ull;
+
 enum struct EEOSCordSource final : uint8_t
 {
     SRC_OFF = 0ui8,
@@ -53,6 +55,8 @@ struct E4Cord final
     void SetSrc(const EEOSCordSource src) { m_src = src; }
     void SetDst(const EEOSCordDest dst) { m_dst = dst; }
 private:
+    struct Layout; // Where each field sits in the file
+
     EEOSCordSource m_src = EEOSCordSource::SRC_OFF;
     EEOSCordDest m_dst = EEOSCordDest::DST_OFF;
     int8_t m_amt = 0i8;
@@ -34,6 +34,8 @@ struct E4Envelope final
     [[nodiscard]] float GetRelease2Level() const;
 
 private:
+    struct Layout; // Where each field sits in the file
+
     /*
      * Uses the ADSR envelope as defined in the Emulator X3 manual
      */
@@ -18,6 +18,8 @@ struct E4LFO final
     [[nodiscard]] uint8_t GetShape() const { return m_shape; }
     [[nodiscard]] bool IsKeySync() const { return !m_keySync; }
 private:
+    struct Layout; // Where each field sits in the file
+
     uint8_t m_rate = 13ui8;
     uint8_t m_shape = 0ui8;
     uint8_t m_delay = 0ui8;
@@ -0,0 +1,26 @@
+#pragma once
+#include "Header/E4B/Helpers/E4BVariables.h"
+#include "Header/IO/BigEndian.h"
+
+struct BinaryReader;
+struct E4TOCChunk;
+
+constexpr auto MULTISAMPLE_MAP_DATA_READ_SIZE = 18ull;
+
+/*
+ * An E4Ma chunk. Only the index and name it starts with are known, like the other chunks.
+ * The layout of the map that follows is undocumented, so it is left unread.
+ */
+struct E4MultisampleMap final
+{
+    explicit E4MultisampleMap(const E4TOCChunk& chunk, BinaryReader& reader);
+
+    [[nodiscard]] uint16_t GetIndex() const { return m_mapIndex; }
+    [[nodiscard]] std::string_view GetName() const { return {m_name.data(), m_name.size()}; }
+
+protected:
+    struct Layout; // Where each field sits in the file
+
+    BigEndian<uint16_t> m_mapIndex = 0ui16;
+    std::array<char, E4BVariables::EOS_E4_MAX_NAME_LEN> m_name{};
+};
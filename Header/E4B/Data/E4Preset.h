@@ -1,9 +1,11 @@
 ﻿#pragma once
 #include "E4Voice.h"
 #include "Header/E4B/Helpers/E4BVariables.h"
+#include <span>
 
 struct BinaryWriter;
 struct BankPreset;
+struct BankVoice;
 struct BinaryReader;
 struct E4TOCChunk;
 
@@ -13,23 +15,28 @@ constexpr uint32_t TOTAL_PRESET_DATA_SIZE = 82u;
 struct E4Preset final
 {
     explicit E4Preset(const E4TOCChunk& chunk, BinaryReader& reader);
-    explicit E4Preset(const BankPreset& preset);
+    explicit E4Preset(const BankPreset& preset); // Borrows the preset's voices, so the preset has to outlive this
 
     void write(BinaryWriter& writer) const;
 
-    [[nodiscard]] uint16_t GetIndex() const { return _byteswap_ushort(m_index); }
-    [[nodiscard]] uint16_t GetNumVoices() const { return _byteswap_ushort(m_numVoices); }
-    [[nodiscard]] uint16_t GetDataSize() const { return _byteswap_ushort(m_dataSize); }
+    [[nodiscard]] uint16_t GetIndex() const { return m_index; }
+    [[nodiscard]] uint16_t GetNumVoices() const { return m_numVoices; }
+    [[nodiscard]] uint16_t GetDataSize() const { return m_dataSize; }
     [[nodiscard]] std::string_view GetName() const { return {m_name.data(), m_name.size()}; }
     [[nodiscard]] const std::vector<E4Voice>& GetVoices() const { return m_voices; }
 
+    // Preset data followed by every voice, as written
+    [[nodiscard]] uint32_t GetTotalDataSize() const;
+
 protected:
+    struct Layout; // Where each field sits in the file
+
     void readAtLocation(ReadLocationHandle& readHandle);
     
-    uint16_t m_index = 0ui16; // requires byteswap
+    BigEndian<uint16_t> m_index = 0ui16;
     std::array<char, E4BVariables::EOS_E4_MAX_NAME_LEN> m_name{};
-    uint16_t m_dataSize = 0ui16; // generally 82 // requires byteswap
-    uint16_t m_numVoices = 0ui16; // requires byteswap
+    BigEndian<uint16_t> m_dataSize = 0ui16; // generally 82
+    BigEndian<uint16_t> m_numVoices = 0ui16;
     std::array<int8_t, 4> m_possibleRedundant1{};
     int8_t m_transpose = 0i8;
     int8_t m_volume = 0i8;
@@ -42,4 +49,6 @@ protected:
      * Allocated data
      */
     std::vector<E4Voice> m_voices{};
+    std::span<const BankVoice> m_bankVoices{}; // Converted one E4 voice at a time while writing rather than all up front
+    std::vector<uint16_t> m_voiceGroups{}; // The E4 voice each bank voice is written into, as one of its zones
 };
\ No newline at end of file
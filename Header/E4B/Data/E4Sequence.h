@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "Header/E4B/Helpers/E4BVariables.h"
+#include "Header/IO/BigEndian.h"
 #include <vector>
 
 struct ReadLocationHandle;
@@ -15,18 +16,20 @@ struct E4Sequence final
 
     void write(BinaryWriter& writer) const;
 
-    [[nodiscard]] uint16_t GetIndex() const { return _byteswap_ushort(m_seqIndex); }
+    [[nodiscard]] uint16_t GetIndex() const { return m_seqIndex; }
     [[nodiscard]] std::string_view GetName() const { return {m_name.data(), m_name.size()}; }
     [[nodiscard]] std::vector<char>& GetData() { return m_midiData; }
     
 protected:
+    struct Layout; // Where each field sits in the file
+
     void readAtLocation(ReadLocationHandle& readHandle);
     
     /*
      * Read data (follows SEQUENCE_DATA_READ_SIZE)
      */
     
-    uint16_t m_seqIndex = 0ui16; // requires byteswap
+    BigEndian<uint16_t> m_seqIndex = 0ui16;
     std::array<char, E4BVariables::EOS_E4_MAX_NAME_LEN> m_name{};
 
     /*
@@ -19,6 +19,8 @@ constexpr uint32_t VOICE_1_ZONE_DATA_SIZE = 306u;
 
 constexpr size_t EOS_MAX_CORDS = 24;
 
+constexpr size_t EOS_MAX_ZONES_PER_VOICE = 127; // The zone count is stored as an int8
+
 struct E4Voice final
 {
     explicit E4Voice(const E4TOCChunk& chunk, uint16_t presetDataSize, uint16_t voiceOffset, BinaryReader& reader);
@@ -26,10 +28,19 @@ struct E4Voice final
 
     void write(BinaryWriter& writer) const;
 
+    /*
+     * The voice data with the size, zone count and key / velocity ranges cleared.
+     * Bank voices that match here only differ in what the zones hold, so they can be written as zones of one voice.
+     */
+    [[nodiscard]] std::array<char, VOICE_DATA_SIZE> GetSharedVoiceData() const;
+
+    // Adds the bank voice as another zone, the voice's ranges grow to cover every zone
+    void AddZone(const BankVoice& voice);
+
     [[nodiscard]] const std::vector<E4Zone>& GetZones() const { return m_zones; }
     [[nodiscard]] const E4ZoneNoteData& GetKeyZoneRange() const { return m_keyData; }
 	[[nodiscard]] const E4ZoneNoteData& GetVelocityRange() const { return m_velData; }
-	[[nodiscard]] uint16_t GetVoiceDataSize() const { return _byteswap_ushort(m_totalVoiceSize); }
+	[[nodiscard]] uint16_t GetVoiceDataSize() const { return m_totalVoiceSize; }
 	[[nodiscard]] float GetChorusWidth() const;
 	[[nodiscard]] float GetChorusAmount() const;
 	[[nodiscard]] uint16_t GetFilterFrequency() const;
@@ -59,9 +70,11 @@ struct E4Voice final
     void PopulateCordsFromBankVoice(const BankVoice& voice);
 
 private:
+    struct Layout; // Where each field sits in the file
+
     void readAtLocation(ReadLocationHandle& readHandle);
     
-	uint16_t m_totalVoiceSize = 0ui16; // requires byteswap
+	BigEndian<uint16_t> m_totalVoiceSize = 0ui16;
 	int8_t m_zoneCount = 1i8;
 	int8_t m_group = 0i8;
 	std::array<int8_t, 8> m_amplifierData{'\0', 100i8};
@@ -72,7 +85,7 @@ private:
 
 	int8_t m_possibleRedundant1 = 0i8;
 	uint8_t m_keyAssignGroup = 0ui8;
-	uint16_t m_keyDelay = 0ui16; // requires byteswap
+	BigEndian<uint16_t> m_keyDelay = 0ui16;
 	std::array<int8_t, 3> m_possibleRedundant2{};
 	uint8_t m_sampleOffset = 0ui8; // percent
 
@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include "Header/IO/BigEndian.h"
 #include <array>
 #include <cstdint>
 
@@ -26,6 +27,8 @@ struct E4ZoneNoteData final
     void SetHigh(const uint8_t high) { m_high = high; }
 
 private:
+    struct Layout; // Where each field sits in the file
+
     uint8_t m_low = 0ui8;
     uint8_t m_lowFade = 0ui8;
     uint8_t m_highFade = 0ui8;
@@ -36,7 +39,9 @@ struct E4Zone final
 {
     E4Zone() = default;
     explicit E4Zone(const uint16_t sampleIndex, const uint8_t originalKey)
-        : m_sampleIndex(_byteswap_ushort(sampleIndex)), m_originalKey(originalKey) {}
+        : m_sampleIndex(sampleIndex), m_originalKey(originalKey) {}
+    explicit E4Zone(const uint16_t sampleIndex, const uint8_t originalKey, const E4ZoneNoteData& keyData, const E4ZoneNoteData& velData)
+        : m_keyData(keyData), m_velData(velData), m_sampleIndex(sampleIndex), m_originalKey(originalKey) {}
 
     void write(BinaryWriter& writer) const;
     void readAtLocation(ReadLocationHandle& readHandle);
@@ -46,14 +51,16 @@ struct E4Zone final
     [[nodiscard]] double GetFineTune() const;
     [[nodiscard]] int8_t GetVolume() const { return m_volume; }
     [[nodiscard]] int8_t GetPan() const { return m_pan; }
-    [[nodiscard]] uint16_t GetSampleIndex() const { return _byteswap_ushort(m_sampleIndex); }
+    [[nodiscard]] uint16_t GetSampleIndex() const { return m_sampleIndex; }
     [[nodiscard]] uint8_t GetOriginalKey() const { return m_originalKey; }
     
 protected:
+    struct Layout; // Where each field sits in the file
+
     E4ZoneNoteData m_keyData;
     E4ZoneNoteData m_velData;
     
-    uint16_t m_sampleIndex = 0ui16; // requires byteswap
+    BigEndian<uint16_t> m_sampleIndex = 0ui16;
     int8_t m_possibleRedundant1 = 0i8;
     int8_t m_fineTune = 0i8; // Could be uint16, but it the voice fineTune follows int8.
 
@@ -13,7 +13,6 @@ namespace E4BHelpers
     [[nodiscard]] EEOSCordSource GetE4CordSrcFromRTControlSrc(ERealtimeControlSrc src);
     [[nodiscard]] EEOSCordDest GetE4CordDstFromRTControlDst(ERealtimeControlDst dst);
     [[nodiscard]] E4Cord GetE4CordFromBankRTControl(const BankRealtimeControl& control);
-    [[nodiscard]] std::vector<E4Voice> GetE4VoicesFromBankVoices(const std::vector<BankVoice>& voices);
     [[nodiscard]] std::array<char, E4BVariables::EOS_E4_MAX_NAME_LEN> ConvertToE4Name(const std::string_view& name);
     [[nodiscard]] std::array<char, E4BVariables::EOS_CHUNK_NAME_LEN> ConvertToE4ChunkName(const std::string_view& name);
 };
\ No newline at end of file
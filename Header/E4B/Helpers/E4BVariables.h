@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <cstdint>
 #include <string_view>
 
 namespace E4BVariables
@@ -19,6 +20,23 @@ namespace E4BVariables
 	constexpr std::string_view EOS_E4_SEQ_TAG = "E4s1";
 	constexpr std::string_view EOS_EMSt_TAG = "EMSt";
 
+	// A tag's 4 characters as one integer, in the order they sit in the file, so tags compare with a single load
+	[[nodiscard]] constexpr uint32_t MakeFourCC(const std::string_view& tag)
+	{
+		uint32_t fourCC(0u);
+		for (size_t i(0); i < EOS_CHUNK_NAME_LEN && i < tag.length(); ++i) { fourCC |= static_cast<uint32_t>(static_cast<uint8_t>(tag[i])) << (i * 8u); }
+		return fourCC;
+	}
+
+	constexpr uint32_t EOS_FORM_FOURCC = MakeFourCC(EOS_FORM_TAG);
+	constexpr uint32_t EOS_E4_FORMAT_FOURCC = MakeFourCC(EOS_E4_FORMAT_TAG);
+	constexpr uint32_t EOS_TOC_FOURCC = MakeFourCC(EOS_TOC_TAG);
+	constexpr uint32_t EOS_E4Ma_FOURCC = MakeFourCC(EOS_E4Ma_TAG);
+	constexpr uint32_t EOS_E4_PRESET_FOURCC = MakeFourCC(EOS_E4_PRESET_TAG);
+	constexpr uint32_t EOS_E3_SAMPLE_FOURCC = MakeFourCC(EOS_E3_SAMPLE_TAG);
+	constexpr uint32_t EOS_E4_SEQ_FOURCC = MakeFourCC(EOS_E4_SEQ_TAG);
+	constexpr uint32_t EOS_EMSt_FOURCC = MakeFourCC(EOS_EMSt_TAG);
+
 	constexpr uint32_t EOS_E4_MAX_NAME_LEN = 16u;
 	constexpr uint32_t EOS_NUM_SAMPLE_PARAMETERS = 9u;
 	constexpr uint32_t EOS_NUM_EXTRA_SAMPLE_PARAMETERS = 8u;
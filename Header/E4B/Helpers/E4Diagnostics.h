@@ -0,0 +1,55 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum struct EE4DiagnosticType final : uint8_t
+{
+    UNACCOUNTED_CORD, // A known source / destination pair the conversion does not carry over
+    UNKNOWN_CORD_SOURCE,
+    UNKNOWN_CORD_DEST
+};
+
+namespace E4DiagnosticsStatics
+{
+    constexpr std::array TYPE_NAMES{"Cord was not accounted", "Unknown cord source", "Unknown cord destination"};
+
+    // Distinct issues listed in a bank's summary, any past this are only counted
+    constexpr size_t MAX_SUMMARY_ISSUES = 16;
+}
+
+struct E4UnknownChunk final
+{
+    std::string m_name{};
+    uint32_t m_count = 0u;
+};
+
+struct E4DiagnosticIssue final
+{
+    EE4DiagnosticType m_type = EE4DiagnosticType::UNACCOUNTED_CORD;
+    uint8_t m_src = 0ui8;
+    uint8_t m_dst = 0ui8;
+    uint32_t m_count = 0u;
+    std::string m_firstPresetName{};
+    uint64_t m_firstVoiceIndex = 0u;
+};
+
+/*
+ * What could not be converted while reading one bank, kept as one entry per (type, source, destination) with a count and
+ * where it was first seen, plus the TOC chunks that were skipped. Logged as a single summary once the bank is read rather than a line per voice.
+ */
+struct E4Diagnostics final
+{
+    void Add(EE4DiagnosticType type, uint8_t src, uint8_t dst, std::string_view presetName, uint64_t voiceIndex);
+    void AddUnknownChunk(std::string_view chunkName);
+    void LogSummary(std::string_view bankName) const;
+
+    [[nodiscard]] const std::vector<E4DiagnosticIssue>& GetIssues() const { return m_issues; }
+    [[nodiscard]] const std::vector<E4UnknownChunk>& GetUnknownChunks() const { return m_unknownChunks; }
+
+private:
+    std::vector<E4DiagnosticIssue> m_issues{}; // In the order they were first seen, banks only have a handful
+    std::vector<E4UnknownChunk> m_unknownChunks{};
+};
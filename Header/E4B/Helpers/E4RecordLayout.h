@@ -0,0 +1,110 @@
+#pragma once
+#include "Header/IO/BigEndian.h"
+#include "Header/IO/BinaryReader.h"
+#include "Header/IO/BinaryWriter.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+template<typename T>
+struct E4MemberTraits;
+
+template<typename Record, typename T>
+struct E4MemberTraits<T Record::*> final
+{
+    using FieldType = T;
+};
+
+/*
+ * Where one member of a fixed size E4 record sits in the file, BigEndian<T> members are swapped on the way in and out.
+ * Nested records (envelopes, cords, etc.) can be a single field, as long as they are made of bytes only.
+ */
+template<auto Member, size_t Offset>
+struct E4Field final
+{
+    using FieldType = typename E4MemberTraits<decltype(Member)>::FieldType;
+    static_assert(std::is_trivially_copyable_v<FieldType>);
+
+    static constexpr size_t OFFSET = Offset;
+    static constexpr size_t SIZE = sizeof(FieldType);
+
+    template<typename Record>
+    static void Copy(Record& record, const char* data) { std::memcpy(&(record.*Member), data + Offset, SIZE); }
+
+    template<typename Record>
+    static void FixEndian(Record& record)
+    {
+        if constexpr (IS_BIG_ENDIAN_V<FieldType>) { (record.*Member).SwapFromFile(); }
+    }
+
+    template<typename Record>
+    static void Store(const Record& record, char* data)
+    {
+        if constexpr (IS_BIG_ENDIAN_V<FieldType>)
+        {
+            const auto fileValue((record.*Member).ToFile());
+            std::memcpy(data + Offset, &fileValue, SIZE);
+        }
+        else { std::memcpy(data + Offset, &(record.*Member), SIZE); }
+    }
+};
+
+namespace E4RecordLayoutStatics
+{
+    template<size_t Size, typename... Fields>
+    [[nodiscard]] consteval bool AreFieldsContiguous()
+    {
+        constexpr std::array offsets{Fields::OFFSET...};
+        constexpr std::array sizes{Fields::SIZE...};
+
+        size_t expectedOffset(0);
+        for (size_t i(0); i < offsets.size(); ++i)
+        {
+            if (offsets[i] != expectedOffset) { return false; }
+            expectedOffset += sizes[i];
+        }
+
+        return expectedOffset == Size;
+    }
+}
+
+/*
+ * The fields of a fixed size E4 record in file order.
+ * A record is bounds checked and copied in one go, then the big-endian fields are swapped, rather than reading field by field.
+ */
+template<size_t Size, typename... Fields>
+struct E4RecordLayout
+{
+    static constexpr size_t SIZE = Size;
+
+    static_assert(E4RecordLayoutStatics::AreFieldsContiguous<Size, Fields...>(), "E4 record fields must follow each other with no gaps and add up to the record size");
+
+    template<typename Record>
+    static void Decode(Record& record, const char* data)
+    {
+        (Fields::Copy(record, data), ...);
+        (Fields::FixEndian(record), ...);
+    }
+
+    template<typename Record>
+    static void Encode(const Record& record, char* data)
+    {
+        (Fields::Store(record, data), ...);
+    }
+
+    // Takes a BinaryReader or a ReadLocationHandle, the record is left as it was if the data runs out
+    template<typename Record, typename Reader>
+    static void Read(Record& record, Reader& reader)
+    {
+        if (const char* data = reader.readBytes(Size)) { Decode(record, data); }
+    }
+
+    template<typename Record>
+    static void Write(const Record& record, BinaryWriter& writer)
+    {
+        std::array<char, Size> data;
+        Encode(record, data.data());
+        writer.writeType(data.data(), Size);
+    }
+};
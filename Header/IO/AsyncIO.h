@@ -0,0 +1,53 @@
+#pragma once
+#include "Header/IO/BufferPool.h"
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string_view>
+
+#if defined(__linux__) && __has_include(<liburing.h>)
+#define HAS_IO_URING 1
+#else
+#define HAS_IO_URING 0
+#endif
+
+using AsyncWriteCallback = std::function<void(bool succeeded)>;
+
+/*
+ * Whole-file asynchronous reads and writes.
+ * Reads are handed back in the order the caller asks for them (WaitRead), writes report back through a callback that runs on an I/O thread.
+ */
+struct AsyncIOBackend
+{
+    AsyncIOBackend() = default;
+    AsyncIOBackend(AsyncIOBackend const&) = delete; AsyncIOBackend& operator=(const AsyncIOBackend&) = delete;
+    virtual ~AsyncIOBackend() = default;
+
+    // Returns the request id to pass to WaitRead
+    [[nodiscard]] virtual uint64_t SubmitRead(const std::filesystem::path& file) = 0;
+    [[nodiscard]] virtual bool WaitRead(uint64_t requestId, BinaryBuffer& outData) = 0;
+
+    virtual void SubmitWrite(const std::filesystem::path& file, BinaryBuffer&& data, AsyncWriteCallback&& onComplete) = 0;
+    virtual void WaitForWrites() = 0;
+
+    [[nodiscard]] virtual std::string_view GetName() const = 0;
+};
+
+enum struct EAsyncIOBackendType
+{
+    DEFAULT, // io_uring where available, otherwise threaded
+    THREADED,
+    IO_URING
+};
+
+namespace AsyncIO
+{
+    constexpr uint32_t DEFAULT_NUM_IO_THREADS = 4u;
+    constexpr uint32_t DEFAULT_QUEUE_DEPTH = 64u;
+
+    [[nodiscard]] std::unique_ptr<AsyncIOBackend> CreateBackend(EAsyncIOBackendType type = EAsyncIOBackendType::DEFAULT);
+
+    // Blocking helpers shared by the backends
+    [[nodiscard]] bool ReadWholeFile(const std::filesystem::path& file, BinaryBuffer& outData);
+    [[nodiscard]] bool WriteWholeFile(const std::filesystem::path& file, const BinaryBuffer& data);
+}
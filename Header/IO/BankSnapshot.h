@@ -0,0 +1,196 @@
+#pragma once
+#include "Header/Data/Soundbank.h"
+#include "Header/IO/BufferPool.h"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+/*
+ * Native snapshot of a Soundbank (.osb), so a bank can be inspected or exported again without re-parsing the E4B / SF2.
+ * Everything is fixed-size little-endian records at aligned offsets: a header, the preset / voice / sample / sequence tables,
+ * a string pool and finally the sample and MIDI data. A mapped or loaded file is used in place through BankSnapshotView.
+ */
+namespace BankSnapshotStatics
+{
+    constexpr std::array MAGIC{'O', 'S', 'B', 'K'};
+
+    // Bumped whenever a record changes, older snapshots are rejected and have to be made again from the source bank
+    constexpr uint32_t VERSION = 1u;
+
+    constexpr size_t SECTION_ALIGNMENT = 64;
+    constexpr size_t SAMPLE_ALIGNMENT = 16; // Each sample's data, so it can be read with aligned SIMD loads
+
+    constexpr std::string_view FILE_EXTENSION = ".osb";
+}
+
+static_assert(std::endian::native == std::endian::little, "Snapshots are stored little-endian and read in place");
+
+// Into the string pool, not null-terminated
+struct SnapshotString final
+{
+    uint32_t m_offset = 0u;
+    uint32_t m_length = 0u;
+};
+
+struct SnapshotHeader final
+{
+    std::array<char, 4> m_magic{};
+    uint32_t m_version = 0u;
+    uint32_t m_headerSize = 0u;
+    uint32_t m_numPresets = 0u;
+    uint32_t m_numVoices = 0u;
+    uint32_t m_numSamples = 0u;
+    uint32_t m_numSequences = 0u;
+    SnapshotString m_bankName{};
+    uint8_t m_defaultPreset = 0ui8;
+    std::array<uint8_t, 3> m_padding{};
+
+    // From the start of the file
+    uint64_t m_presetsOffset = 0u;
+    uint64_t m_voicesOffset = 0u;
+    uint64_t m_samplesOffset = 0u;
+    uint64_t m_sequencesOffset = 0u;
+    uint64_t m_stringsOffset = 0u;
+    uint64_t m_stringsSize = 0u;
+    uint64_t m_dataOffset = 0u;
+    uint64_t m_fileSize = 0u;
+};
+
+struct SnapshotPreset final
+{
+    SnapshotString m_name{};
+    uint32_t m_firstVoice = 0u; // Into the voice table, a preset's voices are contiguous
+    uint32_t m_numVoices = 0u;
+    uint16_t m_index = 0ui16;
+    uint16_t m_padding = 0ui16;
+};
+
+struct SnapshotRealtimeControl final
+{
+    uint8_t m_src = 0ui8; // ERealtimeControlSrc
+    uint8_t m_dst = 0ui8; // ERealtimeControlDst
+    uint16_t m_padding = 0ui16;
+    float m_amount = 0.f;
+};
+
+struct SnapshotEnvelope final
+{
+    double m_attackSec = 0.;
+    double m_decaySec = 0.;
+    double m_delaySec = 0.;
+    double m_holdSec = 0.;
+    double m_releaseSec = 0.;
+    float m_sustainDB = 0.f;
+    uint32_t m_padding = 0u;
+};
+
+struct SnapshotVoice final
+{
+    std::array<SnapshotRealtimeControl, MAX_REALTIME_CONTROLS> m_realtimeControls{};
+    SnapshotEnvelope m_ampEnv{};
+    SnapshotEnvelope m_filterEnv{};
+    double m_lfoRate = 0.;
+    double m_lfoDelay = 0.;
+    double m_fineTune = 0.;
+    float m_filterQ = 0.f;
+    float m_chorusAmount = 0.f;
+    float m_chorusWidth = 0.f;
+    uint16_t m_filterFrequency = 0ui16;
+    uint16_t m_sampleIndex = 0ui16;
+    uint8_t m_lfoShape = 0ui8;
+    uint8_t m_lfoKeySync = 0ui8;
+    uint8_t m_keyLow = 0ui8;
+    uint8_t m_keyHigh = 0ui8;
+    uint8_t m_velocityLow = 0ui8;
+    uint8_t m_velocityHigh = 0ui8;
+    uint8_t m_originalKey = 0ui8;
+    int8_t m_transpose = 0i8;
+    int8_t m_coarseTune = 0i8;
+    int8_t m_volume = 0i8;
+    int8_t m_pan = 0i8;
+    std::array<uint8_t, 5> m_padding{};
+};
+
+struct SnapshotSample final
+{
+    SnapshotString m_name{};
+    uint64_t m_dataOffset = 0u; // From the start of the file, SAMPLE_ALIGNMENT aligned
+    uint64_t m_numValues = 0u; // Interleaved, frames * channels
+    uint32_t m_sampleRate = 0u;
+    uint32_t m_loopStart = 0u;
+    uint32_t m_loopEnd = 0u;
+    uint32_t m_channels = 0u;
+    uint16_t m_index = 0ui16;
+    uint8_t m_isLooping = 0ui8;
+    uint8_t m_isLoopReleasing = 0ui8;
+    uint32_t m_padding = 0u;
+};
+
+struct SnapshotSequence final
+{
+    SnapshotString m_name{};
+    uint64_t m_dataOffset = 0u;
+    uint64_t m_size = 0u;
+    uint16_t m_index = 0ui16;
+    std::array<uint16_t, 3> m_padding{};
+};
+
+// The records are the file layout, any change here needs a VERSION bump
+static_assert(sizeof(SnapshotHeader) == 104 && sizeof(SnapshotPreset) == 20 && sizeof(SnapshotVoice) == 344
+    && sizeof(SnapshotSample) == 48 && sizeof(SnapshotSequence) == 32);
+
+/*
+ * Validated, read-only view over snapshot bytes (a mapped file or a loaded buffer), nothing is copied.
+ * Open checks every table, string and data range against the size, so the accessors can be used without further checks.
+ */
+struct BankSnapshotView final
+{
+    [[nodiscard]] bool Open(const char* data, size_t size);
+
+    [[nodiscard]] const SnapshotHeader& GetHeader() const { return *reinterpret_cast<const SnapshotHeader*>(m_data); }
+    [[nodiscard]] std::span<const SnapshotPreset> GetPresets() const { return GetTable<SnapshotPreset>(GetHeader().m_presetsOffset, GetHeader().m_numPresets); }
+    [[nodiscard]] std::span<const SnapshotVoice> GetVoices() const { return GetTable<SnapshotVoice>(GetHeader().m_voicesOffset, GetHeader().m_numVoices); }
+    [[nodiscard]] std::span<const SnapshotSample> GetSamples() const { return GetTable<SnapshotSample>(GetHeader().m_samplesOffset, GetHeader().m_numSamples); }
+    [[nodiscard]] std::span<const SnapshotSequence> GetSequences() const
+    {
+        return GetTable<SnapshotSequence>(GetHeader().m_sequencesOffset, GetHeader().m_numSequences);
+    }
+
+    [[nodiscard]] std::string_view GetString(const SnapshotString& str) const { return {&m_data[GetHeader().m_stringsOffset + str.m_offset], str.m_length}; }
+    [[nodiscard]] std::span<const int16_t> GetSampleData(const SnapshotSample& sample) const
+    {
+        return {reinterpret_cast<const int16_t*>(&m_data[sample.m_dataOffset]), static_cast<size_t>(sample.m_numValues)};
+    }
+
+    [[nodiscard]] std::span<const char> GetSequenceData(const SnapshotSequence& sequence) const
+    {
+        return {&m_data[sequence.m_dataOffset], static_cast<size_t>(sequence.m_size)};
+    }
+
+private:
+    template<typename T>
+    [[nodiscard]] std::span<const T> GetTable(const uint64_t offset, const uint32_t count) const
+    {
+        return {reinterpret_cast<const T*>(&m_data[offset]), count};
+    }
+
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+namespace BankSnapshot
+{
+    [[nodiscard]] BinaryBuffer Encode(const Soundbank& bank);
+    [[nodiscard]] bool Save(const Soundbank& bank, const std::filesystem::path& file);
+
+    // Records are copied field for field and each sample's data in one block, there is nothing to parse
+    [[nodiscard]] Soundbank Decode(const BankSnapshotView& view);
+
+    // Maps the file rather than reading it
+    [[nodiscard]] Soundbank Load(const std::filesystem::path& file);
+
+    [[nodiscard]] bool IsSnapshot(const char* data, size_t size);
+}
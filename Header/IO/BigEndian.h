@@ -0,0 +1,43 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+// std::byteswap is constexpr and compiles to a single instruction
+template<typename T>
+[[nodiscard]] constexpr T ByteSwap(const T value)
+{
+    static_assert(std::is_integral_v<T> && (sizeof(T) == 2 || sizeof(T) == 4));
+    return std::byteswap(value);
+}
+
+/*
+ * An integer that is big-endian in the file. It is kept in native order and only swapped when loaded from or stored to
+ * the file, so reading it is a plain load. It stays trivially copyable so records holding it can be copied in bulk.
+ */
+template<typename T>
+struct BigEndian final
+{
+    constexpr BigEndian() = default;
+    constexpr BigEndian(const T value) : m_value(value) {}
+
+    [[nodiscard]] constexpr operator T() const { return m_value; }
+
+    [[nodiscard]] static constexpr BigEndian FromFile(const T fileValue) { return BigEndian(ByteSwap(fileValue)); }
+    [[nodiscard]] constexpr T ToFile() const { return ByteSwap(m_value); }
+
+    // For a value that was copied in as raw file bytes
+    constexpr void SwapFromFile() { m_value = ByteSwap(m_value); }
+
+private:
+    T m_value{};
+};
+
+template<typename T>
+constexpr bool IS_BIG_ENDIAN_V = false;
+
+template<typename T>
+constexpr bool IS_BIG_ENDIAN_V<BigEndian<T>> = true;
+
+static_assert(std::is_trivially_copyable_v<BigEndian<uint32_t>> && sizeof(BigEndian<uint32_t>) == sizeof(uint32_t));
+static_assert(ByteSwap<uint16_t>(0x1234u) == 0x3412u && ByteSwap<uint32_t>(0x12345678u) == 0x78563412u);
@@ -1,5 +1,7 @@
 #pragma once
+#include "Header/IO/BigEndian.h"
 #include "Header/MathFunctions.h"
+#include "Header/IO/BufferPool.h"
 #include <assert.h>
 #include <filesystem>
 
@@ -12,8 +14,14 @@ enum struct EReaderFlags final
 struct BinaryReader final
 {
 	BinaryReader() = default;
+	~BinaryReader();
+	BinaryReader(BinaryReader const&) = delete; BinaryReader& operator=(const BinaryReader&) = delete;
+	
 	bool readFile(const std::filesystem::path& file);
 
+	// Takes over a buffer that was already read (e.g. prefetched by AsyncIO)
+	bool readData(BinaryBuffer&& data, const std::filesystem::path& file);
+
 	template<typename T>
     void readType(T* data, const size_t& size = sizeof(T), const EReaderFlags flags = EReaderFlags::NONE)
     {
@@ -31,11 +39,11 @@ struct BinaryReader final
             {
                 if constexpr (std::is_same_v<T, uint16_t>)
                 {
-                    *data = _byteswap_ushort(*data);
+                    *data = ByteSwap(*data);
                 }
                 else if constexpr (std::is_same_v<T, uint32_t>)
                 {
-                    *data = MathFunctions::byteswapUINT32(*data);
+                    *data = ByteSwap(*data);
                 }
                 else
                 {
@@ -61,11 +69,11 @@ struct BinaryReader final
             {
                 if constexpr (std::is_same_v<T, uint16_t>)
                 {
-                    *data = _byteswap_ushort(*data);
+                    *data = ByteSwap(*data);
                 }
                 else if constexpr (std::is_same_v<T, uint32_t>)
                 {
-                    *data = MathFunctions::byteswapUINT32(*data);
+                    *data = ByteSwap(*data);
                 }
                 else
                 {
@@ -76,6 +84,27 @@ struct BinaryReader final
         }
 	}
 
+	// Bounds checked once for a whole record, the caller copies what it needs out of the result
+	[[nodiscard]] const char* GetDataAtLocation(const size_t location, const size_t size) const
+	{
+        const bool valid(size != 0 && location + size <= m_readDataVector.size());
+        assert(valid);
+        return valid ? &m_readDataVector[location] : nullptr;
+	}
+
+	// Moves past size bytes, nullptr if they run past the end of the data
+	[[nodiscard]] const char* readBytes(const size_t size)
+	{
+        const char* data(GetDataAtLocation(m_readLocation, size));
+        if (data != nullptr)
+        {
+            m_readData += size;
+            m_readLocation += size;
+        }
+
+        return data;
+	}
+
 	void skipBytes(const size_t numBytes)
 	{
 	    const bool valid(!m_readDataVector.empty() && numBytes <= m_readDataVector.size()
@@ -89,11 +118,11 @@ struct BinaryReader final
 		}
 	}
 
-	[[nodiscard]] const std::vector<char>& GetData() const { return m_readDataVector; }
+	[[nodiscard]] const BinaryBuffer& GetData() const { return m_readDataVector; }
     [[nodiscard]] size_t GetReadLocation() const { return m_readLocation; }
     
 private:
-	std::vector<char> m_readDataVector{};
+	BinaryBuffer m_readDataVector{}; // Borrowed from the shared buffer pool
 	std::filesystem::path m_filePath;
 	char* m_readData = nullptr;
 	size_t m_readLocation = 0;
@@ -109,6 +138,14 @@ struct ReadLocationHandle final
         m_reader->readTypeAtLocation(data, m_dataOffset, size, flags);
         m_dataOffset += size;
     }
+
+    // Moves past size bytes, nullptr if they run past the end of the data
+    [[nodiscard]] const char* readBytes(const size_t size)
+    {
+        const char* data(m_reader->GetDataAtLocation(m_dataOffset, size));
+        m_dataOffset += size;
+        return data;
+    }
     
     BinaryReader* m_reader = nullptr;
     size_t m_dataOffset = 0;
@@ -1,19 +1,40 @@
 #pragma once
+#include "Header/IO/BufferPool.h"
 #include <filesystem>
 #include <cassert>
 
+namespace BinaryWriterStatics
+{
+	constexpr size_t INITIAL_WRITE_SIZE = 1000; // Start out at 1000 to avoid extra resizes
+}
+
 struct BinaryWriter final
 {
-	explicit BinaryWriter(const std::filesystem::path& file) : m_writeFile(file.native()), m_writeData(m_writeDataVector.data()) {}
+	// Writes into memory only, use TakeData to grab the result
+	BinaryWriter() : m_writeDataVector(BufferPool::GetSharedPool().Acquire(BinaryWriterStatics::INITIAL_WRITE_SIZE)),
+		m_writeData(m_writeDataVector.data()) {}
+	explicit BinaryWriter(const std::filesystem::path& file) : m_writeDataVector(BufferPool::GetSharedPool().Acquire(BinaryWriterStatics::INITIAL_WRITE_SIZE)),
+		m_writeFile(file.native()), m_writeData(m_writeDataVector.data()) {}
+	~BinaryWriter();
+	BinaryWriter(BinaryWriter const&) = delete; BinaryWriter& operator=(const BinaryWriter&) = delete;
 
 	[[nodiscard]] size_t GetWritePos() const { return m_bytesWritten; }
 	[[nodiscard]] bool finishWriting();
+	[[nodiscard]] BinaryBuffer TakeData();
+	[[nodiscard]] bool IsWritingToFile() const { return !m_writeFile.empty(); }
+
+	// Grows the buffer to totalSize once, for when the size of the output is known up front
+	void Reserve(size_t totalSize);
 
     void writeNull(const size_t nullLength)
     {
         assert(nullLength > 0);
         if(nullLength > 0)
         {
+            EnsureCanFitWrite(nullLength);
+
+            // Pooled buffers are not zero-filled, so the padding has to be written explicitly
+            std::memset(m_writeData, 0, nullLength);
             m_writeData += nullLength;
             m_bytesWritten += nullLength;
         }
@@ -25,13 +46,7 @@ struct BinaryWriter final
         static_assert(std::is_fundamental_v<T>);
 		if(data == nullptr) { assert(data != nullptr); return; }
 		
-		if (!CanFitWrite(size))
-		{
-			m_writeDataVector.resize(m_bytesWritten + size);
-			m_writeData = m_writeDataVector.data();
-			m_writeData += m_bytesWritten;
-		}
-        
+		EnsureCanFitWrite(size);
 		std::memcpy(m_writeData, data, size);
 		m_writeData += size;
 		m_bytesWritten += size;
@@ -50,7 +65,9 @@ struct BinaryWriter final
 
 private:
 	[[nodiscard]] bool CanFitWrite(size_t dataSize) const;
-	std::vector<char> m_writeDataVector = std::vector<char>(1000); // Start out at 1000 to avoid extra resizes
+	void EnsureCanFitWrite(size_t dataSize);
+
+	BinaryBuffer m_writeDataVector{}; // Borrowed from the shared buffer pool
 	std::wstring_view m_writeFile;
 	char* m_writeData = nullptr;
 	size_t m_bytesWritten = 0;
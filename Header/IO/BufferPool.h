@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+ * Allocator that default-initializes instead of value-initializing,
+ * so resizing a byte buffer does not zero-fill memory that is about to be overwritten.
+ */
+template<typename T, typename Alloc = std::allocator<T>>
+struct DefaultInitAllocator : Alloc
+{
+    using Alloc::Alloc;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = DefaultInitAllocator<U, typename std::allocator_traits<Alloc>::template rebind_alloc<U>>;
+    };
+
+    template<typename U>
+    void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>)
+    {
+        ::new(static_cast<void*>(ptr)) U;
+    }
+
+    template<typename U, typename... Args>
+    void construct(U* ptr, Args&&... args)
+    {
+        std::allocator_traits<Alloc>::construct(static_cast<Alloc&>(*this), ptr, std::forward<Args>(args)...);
+    }
+};
+
+using BinaryBuffer = std::vector<char, DefaultInitAllocator<char>>;
+
+struct MemoryBudget;
+
+namespace BufferPoolStatics
+{
+    // Shared by every reader, transform and I/O thread
+    constexpr size_t MAX_POOLED_BUFFERS = 8;
+    constexpr size_t MAX_POOLED_BYTES = 256 * 1024 * 1024;
+
+    // Number of acquires and releases between each high-water mark trim
+    constexpr uint32_t TRIM_INTERVAL = 32u;
+}
+
+/*
+ * Process-wide pool of byte buffers shared by BinaryReader and BinaryWriter.
+ * Buffers are often acquired on an I/O thread and released on a transform thread, so there is one locked pool rather than one per thread.
+ * Buffers larger than the high-water mark of the last two trim windows are freed, so a single huge bank
+ * does not pin its memory for the rest of the batch. The pool never holds more than MAX_POOLED_BYTES.
+ */
+struct BufferPool final
+{
+    BufferPool() = default;
+    BufferPool(BufferPool const&) = delete; BufferPool& operator=(const BufferPool&) = delete;
+
+    // Returns a buffer resized to 'size' (contents are not initialized)
+    [[nodiscard]] BinaryBuffer Acquire(size_t size);
+    void Release(BinaryBuffer&& buffer);
+    void Trim();
+
+    // Pooled bytes are counted against the budget while they sit idle, a buffer that does not fit is freed instead of pooled
+    void SetMemoryBudget(MemoryBudget* memoryBudget);
+
+    // Frees pooled buffers, largest first, until at least 'numBytes' have been given back
+    void Reclaim(size_t numBytes);
+
+    [[nodiscard]] size_t GetNumPooledBuffers() const;
+    [[nodiscard]] size_t GetPooledBytes() const;
+
+    [[nodiscard]] static BufferPool& GetSharedPool();
+
+private:
+    // All expect m_mutex to be held
+    void TrimBuffers();
+    void TickTrim();
+    void UntrackBytes(size_t numBytes);
+
+    mutable std::mutex m_mutex;
+    std::vector<BinaryBuffer> m_buffers{};
+    MemoryBudget* m_memoryBudget = nullptr;
+    size_t m_highWaterMark = 0;
+    size_t m_prevHighWaterMark = 0;
+    size_t m_pooledBytes = 0;
+    uint32_t m_callsSinceTrim = 0u;
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include "Header/IO/BufferPool.h"
+#include <ostream>
+
+/*
+ * Stream buffer that appends into a BinaryBuffer, lets std::ostream based writers (SF2) encode into memory.
+ */
+struct BufferStreamBuf final : std::streambuf
+{
+    explicit BufferStreamBuf(BinaryBuffer& buffer) : m_buffer(&buffer) {}
+
+protected:
+    int_type overflow(const int_type ch) override
+    {
+        if (traits_type::eq_int_type(ch, traits_type::eof())) { return traits_type::not_eof(ch); }
+
+        m_buffer->push_back(traits_type::to_char_type(ch));
+        return ch;
+    }
+
+    std::streamsize xsputn(const char* data, const std::streamsize size) override
+    {
+        m_buffer->insert(m_buffer->end(), data, std::next(data, size));
+        return size;
+    }
+
+private:
+    BinaryBuffer* m_buffer = nullptr;
+};
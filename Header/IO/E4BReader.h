@@ -2,10 +2,12 @@
 #include <filesystem>
 #include "Header/Data/Soundbank.h"
 #include "Header/E4B/Helpers/E4BVariables.h"
+#include "Header/IO/BigEndian.h"
 
 enum struct EEOSCordDest : uint8_t;
 enum struct EEOSCordSource : uint8_t;
 struct E4Cord;
+struct E4Diagnostics;
 struct E4Preset;
 struct E4LFO;
 struct E4Envelope;
@@ -24,13 +26,16 @@ struct E4TOCChunk final
     void read(BinaryReader& reader);
     
     [[nodiscard]] std::string_view GetName() const { return {m_chunkName.data(), m_chunkName.size()}; }
-    [[nodiscard]] uint32_t GetLength() const;
-    [[nodiscard]] uint32_t GetStartOffset() const;
+    [[nodiscard]] uint32_t GetFourCC() const { return E4BVariables::MakeFourCC(GetName()); }
+    [[nodiscard]] uint32_t GetLength() const { return m_chunkLength; }
+    [[nodiscard]] uint32_t GetStartOffset() const { return m_chunkStartOffset; }
     
 protected:
+    struct Layout; // Where each field sits in the file
+
     std::array<char, E4BVariables::EOS_CHUNK_NAME_LEN> m_chunkName{};
-    uint32_t m_chunkLength = 0u; // requires byteswap
-    uint32_t m_chunkStartOffset = 0u; // requires byteswap
+    BigEndian<uint32_t> m_chunkLength = 0u;
+    BigEndian<uint32_t> m_chunkStartOffset = 0u;
 };
 
 struct E4DataChunk final
@@ -43,16 +48,23 @@ struct E4DataChunk final
     void readAtLocation(ReadLocationHandle& readHandle);
     
     [[nodiscard]] std::string_view GetName() const { return {m_chunkName.data(), m_chunkName.size()}; }
-    [[nodiscard]] uint32_t GetLength() const;
+    [[nodiscard]] uint32_t GetFourCC() const { return E4BVariables::MakeFourCC(GetName()); }
+    [[nodiscard]] uint32_t GetLength() const { return m_chunkLength; }
     
 protected:
+    struct Layout; // Where each field sits in the file
+
     std::array<char, E4BVariables::EOS_CHUNK_NAME_LEN> m_chunkName{};
-    uint32_t m_chunkLength = 0u; // requires byteswap
+    BigEndian<uint32_t> m_chunkLength = 0u;
 };
 
 namespace E4BReader
 {
     [[nodiscard]] Soundbank ProcessFile(const std::filesystem::path& file);
+    [[nodiscard]] Soundbank ProcessFile(BinaryReader& reader, const std::filesystem::path& file);
+
+    // Reads only the header, the TOC and the sequence chunks from disk, the presets and samples are never loaded
+    [[nodiscard]] bool ReadSequences(const std::filesystem::path& file, std::vector<BankSequence>& outSequences);
     [[nodiscard]] BankVoice GetBankVoiceFromE4Zone(const E4Voice& e4Voice, const E4Zone& e4Zone);
     [[nodiscard]] ADSR_Envelope GetADSREnvelopeFromE4Envelope(const E4Envelope& e4Envelope);
     [[nodiscard]] BankLFO GetBankLFOFromE4LFO(const E4LFO& e4LFO);
@@ -60,5 +72,7 @@ namespace E4BReader
     [[nodiscard]] ERealtimeControlSrc GetBankRTControlSrcFromE4CordSrc(EEOSCordSource src);
     [[nodiscard]] ERealtimeControlDst GetBankRTControlDstFromE4CordDst(EEOSCordDest dst);
     [[nodiscard]] std::array<BankRealtimeControl, MAX_REALTIME_CONTROLS> GetBankRTControlsFromE4Voice(const E4Voice& voice);
-    void VerifyRealtimeCordsAccounted(const E4Preset& e4Preset, const E4Voice& e4Voice, uint64_t voiceIndex);
+
+    // Unknown or dropped cords are added to the bank's diagnostics rather than logged per voice
+    void VerifyRealtimeCordsAccounted(const E4Preset& e4Preset, const E4Voice& e4Voice, uint64_t voiceIndex, E4Diagnostics& diagnostics);
 };
\ No newline at end of file
@@ -1,20 +1,24 @@
 ﻿#pragma once
 #include "Header/Data/Soundbank.h"
+#include "Header/E4B/Data/E4Preset.h"
 
 struct BinaryWriter;
 
+// Borrows the bank rather than copying it, so the bank has to outlive the writer
 struct E4BWriter final
 {
+    explicit E4BWriter(const Soundbank& bank) : m_bank(bank) {}
+
     void BeginWriting(BinaryWriter& writer);
     void EndWriting(BinaryWriter& writer);
-
-    std::vector<BankPreset> m_presets;
-    std::vector<BankSample> m_samples;
     
 protected:
     [[nodiscard]] std::string ConvertNameToEmuName(const std::string_view& name) const;
+    [[nodiscard]] size_t GetTotalFileSize() const;
     void WriteTOC(BinaryWriter& writer);
     
+    const Soundbank& m_bank;
+    std::vector<E4Preset> m_presets{}; // Grouping plans for the bank's presets, built once in BeginWriting
     uint32_t m_totalFORMSize = 0u;
     uint32_t m_totalIndexingSize = 0u;
     bool m_beganWriting = false;
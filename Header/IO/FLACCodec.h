@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace FLACCodecStatics
+{
+    constexpr uint32_t BLOCK_SIZE = 4096u;
+    constexpr uint32_t MAX_FIXED_ORDER = 4u;
+    constexpr uint32_t MAX_PARTITION_ORDER = 8u;
+    constexpr uint32_t MAX_RICE_PARAM = 14u; // 15 is the escape code
+}
+
+/*
+ * Minimal FLAC codec for SF3 samples, so no external codec has to be bundled.
+ * The encoder writes 16-bit streams with fixed predictors and partitioned Rice residuals.
+ * The decoder reads any FLAC stream up to 24 bits (fixed and LPC subframes, all stereo modes) and returns 16-bit PCM.
+ */
+namespace FLACCodec
+{
+    // Interleaved when numChannels > 1
+    [[nodiscard]] std::vector<uint8_t> Encode(const int16_t* samples, size_t numFrames, uint32_t numChannels, uint32_t sampleRate);
+
+    [[nodiscard]] bool IsFLAC(const uint8_t* data, size_t size);
+    [[nodiscard]] bool Decode(const uint8_t* data, size_t size, std::vector<int16_t>& outSamples, uint32_t& outNumChannels, uint32_t& outSampleRate);
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+
+// Read-only memory map of a whole file, unmapped when destroyed
+struct MappedFile final
+{
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(MappedFile const&) = delete; MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] bool Open(const std::filesystem::path& file);
+    void Close();
+
+    [[nodiscard]] const char* GetData() const { return m_data; }
+    [[nodiscard]] size_t GetSize() const { return m_size; }
+
+private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+};
@@ -2,9 +2,11 @@
 #include <filesystem>
 
 struct BankReadOptions;
+struct BinaryReader;
 struct Soundbank;
 
 namespace SF2Reader
 {
     [[nodiscard]] Soundbank ProcessFile(const std::filesystem::path& file, const BankReadOptions& options);
+    [[nodiscard]] Soundbank ProcessFile(BinaryReader& reader, const std::filesystem::path& file, const BankReadOptions& options);
 };
\ No newline at end of file
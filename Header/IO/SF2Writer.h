@@ -1,17 +1,25 @@
 ﻿#pragma once
+#include <ostream>
 #include <string>
-#include <sf2cute.hpp>
+#include <vector>
 
-struct BankWriteOptions;
+struct BankPreset;
 struct BankRealtimeControl;
+struct BankWriteOptions;
+struct SF2InstrumentZones;
 struct Soundbank;
 
 struct SF2Writer final
 {
     [[nodiscard]] bool WriteData(const Soundbank& soundbank, const BankWriteOptions& options) const;
+    [[nodiscard]] bool WriteData(const Soundbank& soundbank, const BankWriteOptions& options, std::ostream& stream) const;
+    [[nodiscard]] std::string GetFileName(const Soundbank& soundbank, const BankWriteOptions& options) const;
     
 protected:
-    void WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const BankRealtimeControl& rtControl, const BankWriteOptions& options) const;
+    // Runs on the worker threads, one preset each
+    void BuildInstrument(const Soundbank& soundbank, const BankPreset& preset, const std::vector<int32_t>& shdrIndices, const BankWriteOptions& options,
+        SF2InstrumentZones& outZones) const;
+    void WriteModOrGen(SF2InstrumentZones& zones, const BankRealtimeControl& rtControl, const BankWriteOptions& options) const;
     [[nodiscard]] std::string ConvertNameToSFName(const std::string_view& name) const;
     
     bool m_beganWriting = false;
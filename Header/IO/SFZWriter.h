@@ -0,0 +1,47 @@
+#pragma once
+#include "Header/IO/BufferPool.h"
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+struct AsyncIOBackend;
+struct BankWriteOptions;
+struct BankPreset;
+struct BankSample;
+struct BankVoice;
+struct Soundbank;
+
+namespace SFZWriterStatics
+{
+    constexpr std::string_view SAMPLE_FOLDER_NAME = "samples";
+    constexpr std::string_view TEMP_FOLDER_SUFFIX = ".tmp";
+    constexpr std::string_view OLD_FOLDER_SUFFIX = ".old";
+
+    // Encoded files waiting on the I/O backend, encoders block past this so the bank never holds a second copy of all its PCM
+    constexpr size_t MAX_BYTES_IN_FLIGHT = 64 * 1024 * 1024;
+
+    // SFZ 'pan' is [-100, 100], bank pan is [-64, 63]
+    constexpr float BANK_PAN_TO_SFZ = 100.f / 64.f;
+    constexpr float MAX_RESONANCE_DB = 40.f;
+}
+
+/*
+ * Writes a bank as a folder with one .sfz per preset and a samples folder holding one WAV per sample.
+ * Presets reference the samples by relative path, so they are shared between presets and a sampler can stream each one from disk.
+ */
+struct SFZWriter final
+{
+    // Writes into '<save folder>/<bank name>', the folder is built under a temp name and renamed once every file is written.
+    // The backend may be shared with other banks, only this bank's writes are waited on.
+    [[nodiscard]] bool WriteData(const Soundbank& soundbank, const BankWriteOptions& options, AsyncIOBackend& ioBackend) const;
+    [[nodiscard]] std::string GetFolderName(const Soundbank& soundbank) const;
+
+protected:
+    [[nodiscard]] std::string GetPresetFileName(const BankPreset& preset) const;
+    [[nodiscard]] std::string GetSampleFileName(const BankSample& sample, size_t sampleIndex) const;
+    [[nodiscard]] std::string WritePreset(const Soundbank& soundbank, const BankPreset& preset) const;
+    void WriteRegion(std::string& outSFZ, const Soundbank& soundbank, const BankVoice& voice) const;
+    [[nodiscard]] BinaryBuffer EncodeWAV(const BankSample& sample) const;
+    [[nodiscard]] std::string ConvertNameToFileName(const std::string_view& name) const;
+    [[nodiscard]] bool ReplaceFolder(const std::filesystem::path& tempFolder, const std::filesystem::path& bankFolder) const;
+};
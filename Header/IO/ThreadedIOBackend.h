@@ -0,0 +1,50 @@
+#pragma once
+#include "Header/IO/AsyncIO.h"
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+
+// Portable backend, blocking stream I/O on a few dedicated threads so the CPU stages never wait on disk
+struct ThreadedIOBackend final : AsyncIOBackend
+{
+    explicit ThreadedIOBackend(uint32_t numThreads);
+    ~ThreadedIOBackend() override;
+
+    [[nodiscard]] uint64_t SubmitRead(const std::filesystem::path& file) override;
+    [[nodiscard]] bool WaitRead(uint64_t requestId, BinaryBuffer& outData) override;
+
+    void SubmitWrite(const std::filesystem::path& file, BinaryBuffer&& data, AsyncWriteCallback&& onComplete) override;
+    void WaitForWrites() override;
+
+    [[nodiscard]] std::string_view GetName() const override { return "Threaded"; }
+
+private:
+    struct IORequest final
+    {
+        std::filesystem::path m_file;
+        BinaryBuffer m_data{};
+        AsyncWriteCallback m_onComplete;
+        uint64_t m_requestId = 0u;
+        bool m_isWrite = false;
+    };
+
+    struct ReadResult final
+    {
+        BinaryBuffer m_data{};
+        bool m_succeeded = false;
+    };
+
+    void ProcessRequests();
+
+    std::condition_variable m_requestCondition;
+    std::condition_variable m_completeCondition;
+    std::mutex m_mutex;
+    std::queue<IORequest> m_requests{};
+    std::unordered_map<uint64_t, ReadResult> m_completedReads{};
+    std::vector<std::thread> m_threads{};
+    uint64_t m_nextRequestId = 1u;
+    uint32_t m_numPendingWrites = 0u;
+    bool m_isEnabled = true;
+};
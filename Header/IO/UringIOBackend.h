@@ -0,0 +1,64 @@
+#pragma once
+#include "Header/IO/AsyncIO.h"
+
+#if HAS_IO_URING
+#include <liburing.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+// Linux backend, every file is one read or write SQE (resubmitted on short transfers) reaped by a single completion thread
+struct UringIOBackend final : AsyncIOBackend
+{
+    explicit UringIOBackend(uint32_t queueDepth);
+    ~UringIOBackend() override;
+
+    [[nodiscard]] bool IsValid() const { return m_isValid; }
+
+    [[nodiscard]] uint64_t SubmitRead(const std::filesystem::path& file) override;
+    [[nodiscard]] bool WaitRead(uint64_t requestId, BinaryBuffer& outData) override;
+
+    void SubmitWrite(const std::filesystem::path& file, BinaryBuffer&& data, AsyncWriteCallback&& onComplete) override;
+    void WaitForWrites() override;
+
+    [[nodiscard]] std::string_view GetName() const override { return "io_uring"; }
+
+private:
+    struct IORequest final
+    {
+        BinaryBuffer m_data{};
+        AsyncWriteCallback m_onComplete;
+        uint64_t m_requestId = 0u;
+        size_t m_offset = 0;
+        int m_fileDescriptor = -1;
+        bool m_isWrite = false;
+    };
+
+    struct ReadResult final
+    {
+        BinaryBuffer m_data{};
+        bool m_succeeded = false;
+    };
+
+    void SubmitRequest(IORequest* request);
+    void CompleteRequest(IORequest* request, bool succeeded);
+    void ProcessCompletions();
+
+    // Called once the ring can no longer be waited on, anything submitted before or after fails
+    void FailOutstandingRequests();
+
+    io_uring m_ring{};
+    std::condition_variable m_completeCondition;
+    std::mutex m_submitMutex;
+    std::mutex m_resultMutex;
+    std::unordered_map<uint64_t, ReadResult> m_completedReads{};
+    std::unordered_set<IORequest*> m_submittedRequests{}; // Guarded by m_submitMutex
+    std::thread m_completionThread;
+    uint64_t m_nextRequestId = 1u;
+    uint32_t m_numPendingWrites = 0u;
+    bool m_isValid = false;
+    bool m_hasFailed = false; // Guarded by m_submitMutex
+};
+#endif
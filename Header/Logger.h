@@ -1,10 +1,15 @@
 #pragma once
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace Logger
 {
 	inline std::vector<std::string> m_logMessages{};
+	inline std::mutex m_logMutex;
+
+	// Also prints messages to stdout (command line mode)
+	inline bool m_echoToStdout = false;
 
     void LogToPlatform(const std::string& msg);
     
@@ -18,9 +23,13 @@ namespace Logger
 		// Remove the null-terminating character
 		stringBuffer.resize(newSize);
 
+		// Messages come in from the conversion worker threads
+		std::lock_guard lock(m_logMutex);
 	    LogToPlatform(stringBuffer);
 		m_logMessages.emplace_back(std::move(stringBuffer));
 	}
 
+	// Hold LockLogMessages while iterating
 	inline const std::vector<std::string>& GetLogMessages() { return m_logMessages; }
+	[[nodiscard]] inline std::unique_lock<std::mutex> LockLogMessages() { return std::unique_lock(m_logMutex); }
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 
 namespace MathFunctions
@@ -8,5 +9,10 @@ namespace MathFunctions
 	[[nodiscard]] float clamp_f(float value, float min, float max);
 	[[nodiscard]] double round_d_places(double value, uint32_t places);
 	[[nodiscard]] float round_f_places(float value, uint32_t places);
-    [[nodiscard]] uint32_t byteswapUINT32(uint32_t value);
+
+    constexpr uint64_t FNV1A_OFFSET_BASIS = 14695981039346656037ull;
+    constexpr uint64_t FNV1A_PRIME = 1099511628211ull;
+
+    // 64-bit FNV-1a, pass the previous result as 'hash' to continue hashing across buffers
+    [[nodiscard]] uint64_t hashFNV1a(const void* data, size_t size, uint64_t hash = FNV1A_OFFSET_BASIS);
 }
\ No newline at end of file
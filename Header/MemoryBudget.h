@@ -0,0 +1,41 @@
+#pragma once
+#include <condition_variable>
+#include <mutex>
+
+/*
+ * Counts the bytes held by banks that are in flight.
+ * Acquire blocks until the reservation fits, a single bank larger than the whole budget is still let through when nothing else is in flight.
+ * Spare bytes (idle pooled buffers) are counted apart and never block a reservation, the owner gives back whatever GetSpareOverflow reports.
+ */
+struct MemoryBudget final
+{
+    explicit MemoryBudget(const size_t budgetBytes) : m_budgetBytes(budgetBytes) {}
+    MemoryBudget(MemoryBudget const&) = delete; MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    // Returns false if the budget was cancelled while waiting
+    bool Acquire(size_t numBytes);
+
+    // Non-blocking version of Acquire
+    [[nodiscard]] bool TryAcquire(size_t numBytes);
+
+    // Only succeeds if the bytes fit under the budget next to the reservations, for memory that can be given back on demand such as pooled buffers
+    [[nodiscard]] bool TryAcquireSpare(size_t numBytes);
+    void Release(size_t numBytes);
+    void ReleaseSpare(size_t numBytes);
+    void Cancel();
+    void Reset(size_t budgetBytes);
+
+    [[nodiscard]] size_t GetBudget() const { return m_budgetBytes; }
+    [[nodiscard]] size_t GetBytesInUse() const;
+
+    // Spare bytes that no longer fit next to the reservations
+    [[nodiscard]] size_t GetSpareOverflow() const;
+
+private:
+    std::condition_variable m_condition;
+    mutable std::mutex m_mutex;
+    size_t m_budgetBytes = 0;
+    size_t m_bytesInUse = 0;
+    size_t m_spareBytes = 0;
+    bool m_isCancelled = false;
+};
@@ -2,7 +2,10 @@
 #include "Header/Data/Soundbank.h"
 #include "BankReadOptions.h"
 #include "BankWriteOptions.h"
-#include "ThreadPool.h"
+#include "BankDetailsCache.h"
+#include "BankDetailsView.h"
+#include "BatchRunner.h"
+#include "SequenceQuery.h"
 #include <array>
 #include <filesystem>
 #include <d3d11.h>
@@ -30,7 +33,7 @@ namespace E4BViewer
 	// Other
 
 	void AddFilePath(std::filesystem::path&& path);
-	inline ThreadPool m_threadPool(4u);
+	inline BatchRunner m_batchRunner;
 
 	// Rendering
 
@@ -48,13 +51,21 @@ namespace E4BViewer
 
     void DisplayConverter(const ImVec2& windowSize);
     void DisplayBankInfoWindow(const std::string_view& popupName);
+    void DisplayBankDetailsRow(const BankDetails& details, const DetailsRow& row);
     void DisplaySeqQueryPopup();
     
     void DisplayOptions();
     
     void DisplayConsole();
     
-    inline std::vector<Soundbank> m_tempResults;
+    // Parsed in the background, the window shows a loading indicator until the bank is ready
+    inline BankDetailsCache m_bankDetailsCache;
+    inline BankDetailsView m_bankDetailsView;
+    inline std::filesystem::path m_viewDetailsFile;
+
+    // Runs in the background, the popup shows whatever has been read so far
+    inline SequenceQuery m_sequenceQuery;
+    inline std::array<char, 64> m_seqQueryFilter{};
 	inline std::vector<std::filesystem::path> m_bankFiles{};
 	inline std::string m_conversionType;
     inline BankWriteOptions m_writeOptions{};
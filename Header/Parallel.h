@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+/*
+ * Fork-join helpers for splitting one bank's work over the cores.
+ * Every call shares one pool of hardware_concurrency - 1 threads and the caller works too, so nested calls stay within the core count.
+ */
+namespace Parallel
+{
+    // Never more workers than items, at least one
+    [[nodiscard]] uint32_t GetNumWorkers(size_t count);
+
+    // Runs func(index, workerIndex) for every index in [0, count), workers pull indices until none are left.
+    // workerIndex is in [0, GetNumWorkers(count)) and lets callers keep per-worker state without locking.
+    // The first exception thrown by func stops the remaining indices and is rethrown here once the workers are done.
+    void For(size_t count, const std::function<void(size_t, uint32_t)>& func);
+}
@@ -1,8 +1,14 @@
 ﻿#pragma once
 #include <filesystem>
+#include <string>
+#include <vector>
 
 namespace WindowsPlatform
 {
     [[nodiscard]] std::filesystem::path GetSaveFolder();
     [[nodiscard]] std::filesystem::path GetSavePath(const std::string_view& filename);
+
+    // Command line arguments as UTF-8, without the executable path
+    [[nodiscard]] std::vector<std::string> GetCommandLineArgs();
+    void AttachParentConsole();
 };
\ No newline at end of file
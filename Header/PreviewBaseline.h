@@ -0,0 +1,32 @@
+#pragma once
+#include "Header/PreviewRenderer.h"
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace PreviewBaselineStatics
+{
+    constexpr std::string_view BASELINE_HEADER = "# OpenSoundbankConverter preview baseline v1";
+}
+
+/*
+ * Tab separated store of bank fingerprints from a known good conversion, one line per rendered note.
+ * Floats are written with enough digits to round trip, so a reloaded baseline compares the same as a fresh one.
+ */
+struct PreviewBaseline final
+{
+    [[nodiscard]] bool Load(const std::filesystem::path& baselineFile);
+    [[nodiscard]] bool Save(const std::filesystem::path& baselineFile) const;
+
+    [[nodiscard]] const BankFingerprint* FindBank(const std::string& bankName) const;
+    void AddOrUpdateBank(BankFingerprint&& bank);
+
+    [[nodiscard]] const std::vector<BankFingerprint>& GetBanks() const { return m_banks; }
+
+private:
+    [[nodiscard]] static bool DeserializeNote(const std::string& line, std::string& outBankName, PresetFingerprint& outPreset, NoteFingerprint& outNote);
+
+    std::vector<BankFingerprint> m_banks{};
+    std::unordered_map<std::string, size_t> m_bankIndices{};
+};
@@ -0,0 +1,72 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+struct PreviewTestNote final
+{
+    uint8_t m_key = 60ui8;
+    uint8_t m_velocity = 127ui8;
+};
+
+namespace PreviewRendererStatics
+{
+    constexpr uint32_t SAMPLE_RATE = 44100u;
+    constexpr float NOTE_HOLD_SEC = 0.6f;
+    constexpr float NOTE_TAIL_SEC = 0.4f; // After the note off, catches the release
+
+    // Low to high keys at full velocity, plus a soft middle C for velocity-dependent envelopes and filters
+    constexpr std::array TEST_NOTES{PreviewTestNote{36ui8, 127ui8}, PreviewTestNote{48ui8, 127ui8}, PreviewTestNote{60ui8, 127ui8},
+        PreviewTestNote{72ui8, 127ui8}, PreviewTestNote{84ui8, 127ui8}, PreviewTestNote{60ui8, 40ui8}};
+
+    constexpr uint32_t NUM_RMS_FRAMES = 20u; // Over the whole note, 50 ms each
+    constexpr uint32_t NUM_SPECTRAL_BANDS = 16u; // Log spaced
+    constexpr uint32_t FFT_SIZE = 4096u; // Taken from the middle of the hold
+    constexpr float MIN_BAND_HZ = 40.f;
+    constexpr float MAX_BAND_HZ = 16000.f;
+    constexpr float SILENCE_DB = -120.f;
+
+    // Quieter than this is noise floor and is not compared
+    constexpr float MIN_COMPARED_RMS_DB = -60.f;
+    constexpr float MIN_COMPARED_BAND_DB = -40.f;
+
+    constexpr float RMS_TOLERANCE_DB = 1.5f;
+    constexpr float SPECTRAL_TOLERANCE_DB = 3.f;
+    constexpr float PITCH_TOLERANCE_CENTS = 5.f;
+}
+
+struct NoteFingerprint final
+{
+    PreviewTestNote m_note{};
+    float m_pitchHz = 0.f; // Strongest partial during the hold, 0 when silent
+    std::array<float, PreviewRendererStatics::NUM_RMS_FRAMES> m_rmsDB{}; // Envelope
+    std::array<float, PreviewRendererStatics::NUM_SPECTRAL_BANDS> m_bandsDB{}; // Relative to the total energy, filter and timbre
+};
+
+struct PresetFingerprint final
+{
+    std::string m_presetName;
+    uint32_t m_presetIndex = 0u; // Sorted by bank and program
+    std::vector<NoteFingerprint> m_notes{};
+};
+
+struct BankFingerprint final
+{
+    std::string m_bankName; // File name without extension, so an .sf2 and .sf3 of the same bank match
+    std::vector<PresetFingerprint> m_presets{};
+};
+
+/*
+ * Headless playback of converted banks through TinySoundFont, for catching conversion regressions without listening.
+ * Every preset plays the same test notes and the audio is reduced to loudness, spectral and pitch fingerprints.
+ */
+namespace PreviewRenderer
+{
+    // Reads an .sf2 or .sf3, presets are rendered in parallel
+    [[nodiscard]] bool FingerprintBank(const std::filesystem::path& file, BankFingerprint& outFingerprint);
+
+    // One line per difference past the tolerances, empty when the banks match
+    [[nodiscard]] std::vector<std::string> CompareFingerprints(const BankFingerprint& baseline, const BankFingerprint& current);
+}
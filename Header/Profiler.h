@@ -0,0 +1,147 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum struct EProfileStage : uint8_t
+{
+    FILE_READ,
+    E4B_TOC_PARSE,
+    E4B_VOICE_DECODE,
+    E4B_ZONE_TO_VOICE, // E4BReader::GetBankVoiceFromE4Zone
+    SF2_PARSE,
+    SF2_MODEL_BUILD, // Flat pdta arrays
+    SF2_RIFF_WRITE,
+    SF3_DECODE, // All samples, decoded in parallel
+    SF3_ENCODE, // All samples, encoded in parallel
+    SAMPLE_RESAMPLE, // All samples, converted in parallel
+    SAMPLE_TRIM, // All samples, scanned in parallel
+    SNAPSHOT_DECODE,
+    SNAPSHOT_ENCODE,
+    E4B_WRITE,
+    SFZ_WRITE, // Presets and WAV files
+    FILE_WRITE,
+    NUM_STAGES
+};
+
+enum struct EProfileCounter : uint8_t
+{
+    BYTES_READ,
+    BYTES_WRITTEN,
+    SAMPLES_PROCESSED,
+    BUFFER_ALLOCATIONS,
+    BUFFER_ALLOCATED_BYTES,
+    BYTES_TRIMMED, // Silence removed from samples
+    NUM_COUNTERS
+};
+
+namespace ProfilerStatics
+{
+    // Indexed by EProfileStage / EProfileCounter
+    constexpr std::array<std::string_view, static_cast<size_t>(EProfileStage::NUM_STAGES)> STAGE_NAMES{"FileRead", "E4BTOCParse", "E4BVoiceDecode",
+        "E4BZoneToVoice", "SF2Parse", "SF2ModelBuild", "SF2RIFFWrite", "SF3Decode", "SF3Encode", "SampleResample", "SampleTrim", "SnapshotDecode", "SnapshotEncode", "E4BWrite", "SFZWrite", "FileWrite"};
+    constexpr std::array<std::string_view, static_cast<size_t>(EProfileCounter::NUM_COUNTERS)> COUNTER_NAMES{"bytesRead", "bytesWritten",
+        "samplesProcessed", "bufferAllocations", "bufferAllocatedBytes", "bytesTrimmed"};
+
+    // Per-zone stages can fire thousands of times, past this only the stage totals keep counting
+    constexpr size_t MAX_TRACE_EVENTS = 8192;
+}
+
+struct ProfileTraceEvent final
+{
+    int64_t m_startUs = 0; // Since Profiler::GetEpoch
+    int64_t m_durationUs = 0;
+    uint32_t m_threadId = 0u;
+    EProfileStage m_stage = EProfileStage::FILE_READ;
+};
+
+struct ProfileStageTotal final
+{
+    std::chrono::nanoseconds m_duration{0};
+    uint64_t m_numCalls = 0u;
+};
+
+/*
+ * Timings and counters for a single bank.
+ * A bank is handed between the pipeline stages through queues, so only one thread touches its profile at a time.
+ * Stage totals are inclusive, nested stages (zone to voice inside voice decode) are also counted by their parent.
+ */
+struct BankProfile final
+{
+    explicit BankProfile(std::string&& bankName);
+
+    void AddStage(EProfileStage stage, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+    void AddCounter(const EProfileCounter counter, const uint64_t value) { m_counters[static_cast<size_t>(counter)] += value; }
+
+    [[nodiscard]] const std::string& GetBankName() const { return m_bankName; }
+    [[nodiscard]] const ProfileStageTotal& GetStageTotal(const EProfileStage stage) const { return m_stageTotals[static_cast<size_t>(stage)]; }
+    [[nodiscard]] uint64_t GetCounter(const EProfileCounter counter) const { return m_counters[static_cast<size_t>(counter)]; }
+
+    // Totals and counters
+    [[nodiscard]] std::string ToJSON() const;
+
+    // Chrome trace-event format, load in chrome://tracing or Perfetto
+    [[nodiscard]] std::string ToChromeTrace() const;
+
+private:
+    std::string m_bankName;
+    std::array<ProfileStageTotal, static_cast<size_t>(EProfileStage::NUM_STAGES)> m_stageTotals{};
+    std::array<uint64_t, static_cast<size_t>(EProfileCounter::NUM_COUNTERS)> m_counters{};
+    std::vector<ProfileTraceEvent> m_traceEvents{};
+    uint64_t m_numDroppedEvents = 0u;
+};
+
+/*
+ * Scoped timers and counters record into the bank profile bound to the calling thread.
+ * With no profile bound (profiling off) every call is a thread_local load and a branch.
+ */
+namespace Profiler
+{
+    [[nodiscard]] BankProfile* GetThreadProfile();
+    [[nodiscard]] std::chrono::steady_clock::time_point GetEpoch();
+    [[nodiscard]] uint32_t GetThreadId();
+
+    void AddCounter(EProfileCounter counter, uint64_t value);
+
+    // Writes "<bank>.profile.json" and "<bank>.trace.json" into the folder
+    [[nodiscard]] bool WriteBankProfile(const BankProfile& profile, const std::filesystem::path& folder);
+
+    // Binds a bank profile to the current thread for its lifetime (nullptr is allowed and binds nothing)
+    struct BankScope final
+    {
+        explicit BankScope(BankProfile* profile);
+        ~BankScope();
+        BankScope(BankScope const&) = delete; BankScope& operator=(const BankScope&) = delete;
+
+    private:
+        BankProfile* m_prevProfile = nullptr;
+    };
+
+    struct StageScope final
+    {
+        explicit StageScope(const EProfileStage stage) : m_profile(GetThreadProfile()), m_stage(stage)
+        {
+            if (m_profile != nullptr) { m_startTime = std::chrono::steady_clock::now(); }
+        }
+
+        ~StageScope() { End(); }
+
+        // Ends the stage before the scope does
+        void End()
+        {
+            if (m_profile != nullptr) { m_profile->AddStage(m_stage, m_startTime, std::chrono::steady_clock::now()); }
+            m_profile = nullptr;
+        }
+
+        StageScope(StageScope const&) = delete; StageScope& operator=(const StageScope&) = delete;
+
+    private:
+        BankProfile* m_profile = nullptr;
+        std::chrono::steady_clock::time_point m_startTime{};
+        EProfileStage m_stage;
+    };
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+struct Soundbank;
+
+namespace ResamplerStatics
+{
+    // Rates offered in the GUI and accepted on the command line
+    constexpr std::array SUPPORTED_RATES{44100u, 48000u};
+
+    // Filter phases between two input samples, the coefficients are interpolated between neighbouring phases
+    constexpr uint32_t NUM_PHASES = 256u;
+
+    // Taps either side of the output position when upsampling (enough for the Kaiser transition to end at Nyquist), widened by the ratio when downsampling
+    constexpr uint32_t HALF_TAPS = 48u;
+
+    // Passband edge as a fraction of the lower Nyquist, and the Kaiser beta (~87 dB stopband, beta / 0.1102 + 8.7)
+    constexpr double CUTOFF = 0.94;
+    constexpr double KAISER_BETA = 8.6;
+}
+
+/*
+ * Polyphase windowed-sinc sample rate conversion.
+ * The read position is stepped with an exact integer ratio (target / source reduced by their gcd), so the output has
+ * exactly the target rate and the result does not depend on the thread or machine it was computed on.
+ */
+namespace Resampler
+{
+    // Converts every sample that is not already at the target rate (in parallel) and moves the loop points with it.
+    // Rounding a loop to whole samples changes its length slightly, voices playing a looped sample get that back as fine tune.
+    void ResampleBank(Soundbank& bank, uint32_t targetRate);
+}
@@ -0,0 +1,142 @@
+#pragma once
+#include <sf2cute/generator_item.hpp>
+#include <sf2cute/modulator_item.hpp>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace SF2HydraStatics
+{
+    constexpr size_t NAME_LEN = 20; // Null terminator included
+    constexpr size_t NUM_GENERATORS = static_cast<size_t>(sf2cute::SFGenerator::kEndOper);
+
+    // A guess to reserve an instrument's generators with, most voices set fewer than this
+    constexpr size_t GENERATORS_PER_ZONE = 16;
+}
+
+/*
+ * pdta records as they sit in the file. SF2 is little-endian like everything we build for, so each array is written out in one go.
+ */
+#pragma pack(push, 1)
+struct SF2PresetHeader final
+{
+    std::array<char, SF2HydraStatics::NAME_LEN> m_name{};
+    uint16_t m_preset = 0ui16;
+    uint16_t m_bank = 0ui16;
+    uint16_t m_bagIndex = 0ui16;
+    uint32_t m_library = 0u;
+    uint32_t m_genre = 0u;
+    uint32_t m_morphology = 0u;
+};
+
+struct SF2Bag final
+{
+    uint16_t m_generatorIndex = 0ui16;
+    uint16_t m_modulatorIndex = 0ui16;
+};
+
+struct SF2ModList final
+{
+    uint16_t m_srcOper = 0ui16;
+    uint16_t m_destOper = 0ui16;
+    int16_t m_amount = 0i16;
+    uint16_t m_amtSrcOper = 0ui16;
+    uint16_t m_transOper = 0ui16;
+};
+
+struct SF2GenList final
+{
+    uint16_t m_oper = 0ui16;
+    uint16_t m_amount = 0ui16;
+};
+
+struct SF2InstHeader final
+{
+    std::array<char, SF2HydraStatics::NAME_LEN> m_name{};
+    uint16_t m_bagIndex = 0ui16;
+};
+
+struct SF2SampleHeader final
+{
+    std::array<char, SF2HydraStatics::NAME_LEN> m_name{};
+    uint32_t m_start = 0u;
+    uint32_t m_end = 0u;
+    uint32_t m_loopStart = 0u;
+    uint32_t m_loopEnd = 0u;
+    uint32_t m_sampleRate = 0u;
+    uint8_t m_originalKey = 0ui8;
+    int8_t m_correction = 0i8;
+    uint16_t m_sampleLink = 0ui16;
+    uint16_t m_sampleType = 0ui16;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(SF2PresetHeader) == 38 && sizeof(SF2Bag) == 4 && sizeof(SF2ModList) == 10 && sizeof(SF2GenList) == 4 &&
+    sizeof(SF2InstHeader) == 22 && sizeof(SF2SampleHeader) == 46);
+
+/*
+ * The zones of one instrument. Bag indices are relative to the instrument, so instruments can be built on their own
+ * (and in parallel) then appended to the hydra in order.
+ * Generators of the zone being built are kept by operator, so setting one twice keeps the last value, and are sorted into
+ * the order the spec wants (key range, velocity range, ..., sample ID) when the zone ends.
+ */
+struct SF2InstrumentZones final
+{
+    void Reserve(size_t numZones);
+
+    void BeginZone();
+    void SetGenerator(const sf2cute::SFGeneratorItem& generator);
+    void SetModulator(const sf2cute::SFModulatorItem& modulator);
+    void EndZone(uint16_t sampleIndex);
+
+    /*
+     * Moves generators and modulators that every zone sets into a global zone, taking the value most zones use, so only the
+     * zones that differ keep their own. Key / velocity ranges stay in the zones. Call once all zones are added.
+     */
+    void HoistGlobalZone();
+
+    // Instruments with the same records write the same zones, so presets can share one
+    [[nodiscard]] uint64_t GetHash() const;
+    [[nodiscard]] bool HasSameZones(const SF2InstrumentZones& other) const;
+
+    std::vector<SF2Bag> m_bags{};
+    std::vector<SF2ModList> m_modulators{};
+    std::vector<SF2GenList> m_generators{};
+
+private:
+    std::array<uint16_t, SF2HydraStatics::NUM_GENERATORS> m_zoneGenerators{};
+    std::bitset<SF2HydraStatics::NUM_GENERATORS> m_zoneGeneratorsSet{};
+};
+
+// The pdta list built straight into its flat arrays, each preset has a single zone pointing at its instrument
+struct SF2Hydra final
+{
+    void Reserve(size_t numPresets, size_t numSamples);
+    void ReserveZones(size_t numZones, size_t numModulators, size_t numGenerators);
+
+    void AddSample(std::string_view name, uint32_t start, uint32_t end, uint32_t loopStart, uint32_t loopEnd, uint32_t sampleRate, uint16_t sampleType);
+    // Returns the instrument index to give the presets using it
+    [[nodiscard]] uint16_t AddInstrument(std::string_view name, const SF2InstrumentZones& zones);
+    void AddPreset(std::string_view name, uint16_t presetNumber, uint16_t bank, uint16_t instrumentIndex);
+
+    // Adds the terminal records, false if there are more records than the 16 bit indices can reach
+    [[nodiscard]] bool Finish();
+
+    // LIST header included
+    [[nodiscard]] size_t GetListSize() const;
+    void Write(std::ostream& stream) const;
+
+private:
+    std::vector<SF2PresetHeader> m_presetHeaders{};
+    std::vector<SF2Bag> m_presetBags{};
+    std::vector<SF2ModList> m_presetModulators{};
+    std::vector<SF2GenList> m_presetGenerators{};
+    std::vector<SF2InstHeader> m_instHeaders{};
+    std::vector<SF2Bag> m_instBags{};
+    std::vector<SF2ModList> m_instModulators{};
+    std::vector<SF2GenList> m_instGenerators{};
+    std::vector<SF2SampleHeader> m_sampleHeaders{};
+};
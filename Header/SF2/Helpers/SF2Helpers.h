@@ -1,5 +1,7 @@
 ﻿#pragma once
 #include <cstdint>
+#include <ostream>
+#include <string_view>
 
 /*
 * Converter specific info
@@ -20,6 +22,8 @@ namespace SF2Helpers
     constexpr auto MIN_MAX_LFO1_TO_VOLUME = 15.f;
     constexpr auto MAX_FILTER_FREQ_HZ_CORDS(12000.f);
     constexpr auto MAX_SUSTAIN_VOL_ENV = 144.f;
+    constexpr uint32_t RIFF_CHUNK_HEADER_SIZE = 8u; // FourCC and size
+    constexpr uint32_t RIFF_LIST_HEADER_SIZE = 12u; // "LIST", size and FourCC
 
     [[nodiscard]] int16_t filterFreqPercentToCents(float filterFreq);
     [[nodiscard]] float centsToFilterFreqPercent(int16_t cents);
@@ -37,4 +41,8 @@ namespace SF2Helpers
     [[nodiscard]] constexpr float relPercentToValue(const float val) { return val / 10.f; }
 
     void InterleaveSamples(const int16_t* leftChannel, const int16_t* rightChannel, int16_t* outStereo, size_t sampleNum);
+
+    // size is everything after the size field, as RIFF wants
+    void WriteChunkHeader(std::ostream& stream, std::string_view fourCC, uint32_t size);
+    void WriteListHeader(std::ostream& stream, std::string_view fourCC, uint32_t size);
 };
\ No newline at end of file
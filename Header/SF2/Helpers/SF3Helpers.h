@@ -0,0 +1,28 @@
+#pragma once
+#include "Header/IO/BufferPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct BankSample;
+
+/*
+ * SF3 is an SF2 where each sample in 'smpl' is stored compressed, flagged by 0x10 in its sample type.
+ * For those samples the shdr start / end are byte offsets into 'smpl' and the loop points are relative to the decoded sample.
+ * We compress with FLAC, as that is what we can decode without a bundled codec (Ogg Vorbis samples are rejected on read).
+ */
+namespace SF3Helpers
+{
+    constexpr uint16_t SAMPLE_TYPE_COMPRESSED = 0x10u;
+    constexpr uint16_t SAMPLE_TYPE_ROM = 0x8000u;
+    constexpr uint32_t SHDR_RECORD_SIZE = 46u;
+    constexpr uint32_t NUM_TERMINATOR_SAMPLES = 46u;
+
+    // Each sample is encoded on its own, spread over the available cores. Stereo samples are skipped (like the SF2 writer) and come back empty.
+    [[nodiscard]] std::vector<std::vector<uint8_t>> CompressSamples(const std::vector<BankSample>& samples);
+
+    [[nodiscard]] bool IsCompressed(const char* data, size_t size);
+
+    // Rebuilds the bank as a plain SF2 image with PCM samples and absolute shdr offsets, which the SF2 reader can load directly
+    [[nodiscard]] bool DecompressToSF2(const char* data, size_t size, BinaryBuffer& outSF2);
+}
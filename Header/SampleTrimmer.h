@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+
+struct BankSample;
+struct Soundbank;
+
+namespace SampleTrimmerStatics
+{
+    // Peak below this on every channel counts as silence (about -66 dBFS)
+    constexpr int16_t SILENCE_THRESHOLD = 16i16;
+
+    // Kept before the first audible frame, so an attack that starts under the threshold is not clipped
+    constexpr uint32_t ATTACK_MARGIN_FRAMES = 32u;
+
+    // Samplers read a few frames either side of a loop for interpolation (SF2 requires 8)
+    constexpr uint32_t LOOP_GUARD_FRAMES = 8u;
+
+    // A sample that is silent throughout is cut down to this
+    constexpr uint32_t MIN_FRAMES = 32u;
+}
+
+struct SampleTrimResult final
+{
+    uint32_t m_numTrimmedSamples = 0u;
+    uint64_t m_bytesSaved = 0u;
+};
+
+/*
+ * Strips leading and trailing silence from samples. Loops are never cut into: trimming stops short of the loop
+ * (plus its guard frames) and the loop points are moved with the removed lead.
+ */
+namespace SampleTrimmer
+{
+    // Returns the number of frames removed from the front and back
+    [[nodiscard]] uint64_t TrimSample(BankSample& sample);
+
+    // Samples are scanned and trimmed in parallel
+    SampleTrimResult TrimBank(Soundbank& bank);
+}
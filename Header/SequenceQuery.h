@@ -0,0 +1,57 @@
+#pragma once
+#include "Header/Data/Soundbank.h"
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+struct SequenceQueryResult final
+{
+    std::filesystem::path m_file;
+    std::string m_bankName;
+    std::vector<BankSequence> m_sequences{};
+};
+
+/*
+ * Lists the sequences of a set of E4B banks on a background thread, reading only each bank's TOC and sequence chunks.
+ * Results can be fetched while the query runs, and are cached per file by size and write time so querying the same banks
+ * again only reads the ones that changed.
+ */
+struct SequenceQuery final
+{
+    SequenceQuery() = default;
+    SequenceQuery(SequenceQuery const&) = delete; SequenceQuery& operator=(const SequenceQuery&) = delete;
+    ~SequenceQuery() { Cancel(); }
+
+    // Cancels a query that is still running
+    void Start(std::vector<std::filesystem::path> files);
+    void Cancel();
+
+    [[nodiscard]] bool IsRunning() const { return m_isRunning.load(); }
+    [[nodiscard]] uint32_t GetNumFiles() const { return m_numFiles.load(); }
+    [[nodiscard]] uint32_t GetNumFilesDone() const { return m_numFilesDone.load(); }
+
+    // The banks read so far, in the order they were given (the results are shared with the cache, not copied)
+    [[nodiscard]] std::vector<std::shared_ptr<const SequenceQueryResult>> GetResults() const;
+
+private:
+    struct CacheEntry final
+    {
+        std::shared_ptr<const SequenceQueryResult> m_result;
+        uint64_t m_fileSize = 0u;
+        int64_t m_fileWriteTime = 0;
+    };
+
+    void Run(const std::vector<std::filesystem::path>& files);
+
+    std::thread m_thread;
+    mutable std::mutex m_resultsMutex;
+    std::vector<std::shared_ptr<const SequenceQueryResult>> m_results{}; // One per file, empty until it has been read
+    std::unordered_map<std::string, CacheEntry> m_cache{};
+    std::atomic<uint32_t> m_numFiles{0u};
+    std::atomic<uint32_t> m_numFilesDone{0u};
+    std::atomic<bool> m_isRunning{false};
+    std::atomic<bool> m_isCancelled{false};
+};
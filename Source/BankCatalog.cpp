@@ -0,0 +1,433 @@
+#include "Header/BankCatalog.h"
+#include "Header/BankReadOptions.h"
+#include "Header/BatchManifest.h"
+#include "Header/CommandLine.h"
+#include "Header/IO/BankSnapshot.h"
+#include "Header/IO/BinaryReader.h"
+#include "Header/IO/E4BReader.h"
+#include "Header/IO/SF2Reader.h"
+#include "Header/Logger.h"
+#include "Header/Parallel.h"
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <fstream>
+
+namespace
+{
+    template<typename T>
+    bool ParseValue(const std::string_view& str, T& outValue, const int base = 10)
+    {
+        return std::from_chars(str.data(), str.data() + str.size(), outValue, base).ec == std::errc();
+    }
+
+    // The last column takes the rest of the line, so it is always the name or path
+    template<size_t N>
+    bool SplitColumns(const std::string_view& line, std::array<std::string_view, N>& outColumns)
+    {
+        size_t columnStart(0);
+        for (size_t i(0); i < N; ++i)
+        {
+            const size_t columnEnd(i + 1 < N ? line.find('\t', columnStart) : line.length());
+            if (columnEnd == std::string_view::npos) { return false; }
+
+            outColumns[i] = line.substr(columnStart, columnEnd - columnStart);
+            columnStart = columnEnd + 1;
+        }
+
+        return true;
+    }
+
+    // Bank names come straight from the file, a line break in one would split the record
+    std::string SanitizeName(const std::string_view& name)
+    {
+        std::string outName(name);
+        std::ranges::replace_if(outName, [](const char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+        return outName;
+    }
+
+    std::string GetBankKey(const std::filesystem::path& file)
+    {
+        return BatchManifest::PathToUTF8(file.lexically_normal());
+    }
+
+    void AddPreset(CatalogBank& bank, const std::string_view& name, const uint16_t index, const uint32_t numVoices, const uint8_t keyLow, const uint8_t keyHigh)
+    {
+        auto& preset(bank.m_presets.emplace_back());
+        preset.m_presetName = SanitizeName(name);
+        preset.m_index = index;
+        preset.m_numVoices = numVoices;
+        preset.m_keyLow = keyLow;
+        preset.m_keyHigh = keyHigh;
+    }
+
+    void AddSample(CatalogBank& bank, const std::string_view& name, const uint16_t index, const uint64_t numValues, const uint32_t sampleRate,
+        const uint32_t channels, const bool isLooping)
+    {
+        auto& sample(bank.m_samples.emplace_back());
+        sample.m_sampleName = SanitizeName(name);
+        sample.m_index = index;
+        sample.m_numFrames = numValues / std::max(channels, 1u);
+        sample.m_sampleRate = sampleRate;
+        sample.m_channels = channels;
+        sample.m_isLooping = isLooping;
+    }
+
+    void AddSequence(CatalogBank& bank, const std::string_view& name, const uint16_t index, const uint64_t size)
+    {
+        auto& sequence(bank.m_sequences.emplace_back());
+        sequence.m_sequenceName = SanitizeName(name);
+        sequence.m_index = index;
+        sequence.m_size = size;
+    }
+
+    void FillFromSoundbank(const Soundbank& bank, CatalogBank& outBank)
+    {
+        outBank.m_bankName = SanitizeName(bank.m_bankName);
+
+        for (const auto& preset : bank.m_presets)
+        {
+            // An empty preset gets an inverted range, so it never covers any key
+            uint8_t keyLow(127ui8), keyHigh(0ui8);
+            for (const auto& voice : preset.m_voices)
+            {
+                keyLow = std::min(keyLow, voice.m_keyZone.m_low);
+                keyHigh = std::max(keyHigh, voice.m_keyZone.m_high);
+            }
+
+            AddPreset(outBank, preset.m_presetName, preset.m_index, static_cast<uint32_t>(preset.m_voices.size()), keyLow, keyHigh);
+        }
+
+        for (const auto& sample : bank.m_samples)
+        {
+            AddSample(outBank, sample.m_sampleName, sample.m_index, sample.m_sampleData.size(), sample.m_sampleRate, sample.m_channels, sample.m_isLooping);
+        }
+
+        for (const auto& sequence : bank.m_sequences) { AddSequence(outBank, sequence.m_sequenceName, sequence.m_index, sequence.m_midiData.size()); }
+    }
+
+    // Snapshots are indexed from their tables, the samples are never copied out
+    void FillFromSnapshot(const BankSnapshotView& view, CatalogBank& outBank)
+    {
+        outBank.m_bankName = SanitizeName(view.GetString(view.GetHeader().m_bankName));
+
+        const auto voices(view.GetVoices());
+        for (const auto& preset : view.GetPresets())
+        {
+            uint8_t keyLow(127ui8), keyHigh(0ui8);
+            for (const auto& voice : voices.subspan(preset.m_firstVoice, preset.m_numVoices))
+            {
+                keyLow = std::min(keyLow, voice.m_keyLow);
+                keyHigh = std::max(keyHigh, voice.m_keyHigh);
+            }
+
+            AddPreset(outBank, view.GetString(preset.m_name), preset.m_index, preset.m_numVoices, keyLow, keyHigh);
+        }
+
+        for (const auto& sample : view.GetSamples())
+        {
+            AddSample(outBank, view.GetString(sample.m_name), sample.m_index, sample.m_numValues, sample.m_sampleRate, sample.m_channels, sample.m_isLooping != 0ui8);
+        }
+
+        for (const auto& sequence : view.GetSequences()) { AddSequence(outBank, view.GetString(sequence.m_name), sequence.m_index, sequence.m_size); }
+    }
+}
+
+bool BankCatalog::Load(const std::filesystem::path& catalogFile)
+{
+    m_banks.clear();
+    m_bankIndices.clear();
+
+    std::ifstream ifs(catalogFile, std::ios::binary);
+    if (!ifs.is_open()) { return false; }
+
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+        if (line.empty() || line.front() == '#') { continue; }
+
+        // A bad line only loses that record, the bank is indexed again on the next update if its own line went
+        std::ignore = DeserializeLine(line, m_banks);
+    }
+
+    RebuildIndices();
+    return true;
+}
+
+bool BankCatalog::Save(const std::filesystem::path& catalogFile) const
+{
+    auto tempFile(catalogFile);
+    tempFile += ".tmp";
+
+    {
+        std::ofstream ofs(tempFile, std::ios::binary | std::ios::trunc);
+        if (!ofs.is_open()) { return false; }
+
+        ofs << BankCatalogStatics::CATALOG_HEADER << '\n';
+        for (const auto& bank : m_banks) { ofs << SerializeBank(bank); }
+
+        ofs.flush();
+        if (!ofs.good()) { return false; }
+    }
+
+    std::error_code errorCode;
+    std::filesystem::rename(tempFile, catalogFile, errorCode);
+    return !errorCode;
+}
+
+CatalogUpdateResult BankCatalog::Update(const std::vector<std::filesystem::path>& files, const BankReadOptions& readOptions)
+{
+    CatalogUpdateResult result{};
+
+    const auto numBanksBefore(m_banks.size());
+    std::erase_if(m_banks, [](const CatalogBank& bank)
+    {
+        std::error_code errorCode;
+        return !std::filesystem::exists(bank.m_file, errorCode);
+    });
+
+    result.m_numRemoved = static_cast<uint32_t>(numBanksBefore - m_banks.size());
+    RebuildIndices();
+
+    // Size and write time are enough to skip a bank without reading it
+    std::vector<std::filesystem::path> changedFiles{};
+    for (const auto& file : files)
+    {
+        std::error_code errorCode;
+        const auto fileSize(std::filesystem::file_size(file, errorCode));
+        if (errorCode) { continue; }
+
+        const auto fileWriteTime(std::filesystem::last_write_time(file, errorCode).time_since_epoch().count());
+        if (errorCode) { continue; }
+
+        const auto* bank(FindBank(file));
+        if (bank != nullptr && bank->m_fileSize == fileSize && bank->m_fileWriteTime == fileWriteTime) { ++result.m_numUnchanged; }
+        else if (std::ranges::find(changedFiles, file) == changedFiles.end()) { changedFiles.emplace_back(file); }
+    }
+
+    std::vector<CatalogBank> indexedBanks(changedFiles.size());
+    std::vector<uint8_t> indexStates(changedFiles.size(), 0ui8); // 0 = unreadable, 1 = only touched, 2 = parsed
+    Parallel::For(changedFiles.size(), [&](const size_t index, uint32_t)
+    {
+        bool parsed(false);
+        if (IndexBank(changedFiles[index], readOptions, FindBank(changedFiles[index]), indexedBanks[index], parsed)) { indexStates[index] = parsed ? 2ui8 : 1ui8; }
+    });
+
+    for (size_t i(0); i < changedFiles.size(); ++i)
+    {
+        if (indexStates[i] == 0ui8)
+        {
+            Logger::LogMessage("Unable to read '%s' for the catalog", changedFiles[i].string().c_str());
+            ++result.m_numFailed;
+            continue;
+        }
+
+        if (indexStates[i] == 1ui8) { ++result.m_numUnchanged; }
+        else if (indexedBanks[i].IsValid()) { ++result.m_numIndexed; }
+        else { ++result.m_numFailed; }
+
+        const auto key(GetBankKey(changedFiles[i]));
+        if (const auto it(m_bankIndices.find(key)); it != m_bankIndices.end()) { m_banks[it->second] = std::move(indexedBanks[i]); }
+        else
+        {
+            m_bankIndices.emplace(key, m_banks.size());
+            m_banks.emplace_back(std::move(indexedBanks[i]));
+        }
+    }
+
+    return result;
+}
+
+const CatalogBank* BankCatalog::FindBank(const std::filesystem::path& file) const
+{
+    const auto it(m_bankIndices.find(GetBankKey(file)));
+    return it != m_bankIndices.end() ? &m_banks[it->second] : nullptr;
+}
+
+std::vector<CatalogMatch<CatalogSequence>> BankCatalog::FindSequences(const std::string_view& name) const
+{
+    std::vector<CatalogMatch<CatalogSequence>> outMatches{};
+    for (const auto& bank : m_banks)
+    {
+        for (const auto& sequence : bank.m_sequences)
+        {
+            if (ContainsCI(sequence.m_sequenceName, name)) { outMatches.emplace_back(&bank, &sequence); }
+        }
+    }
+
+    return outMatches;
+}
+
+std::vector<CatalogMatch<CatalogPreset>> BankCatalog::FindPresets(const std::string_view& name) const
+{
+    std::vector<CatalogMatch<CatalogPreset>> outMatches{};
+    for (const auto& bank : m_banks)
+    {
+        for (const auto& preset : bank.m_presets)
+        {
+            if (ContainsCI(preset.m_presetName, name)) { outMatches.emplace_back(&bank, &preset); }
+        }
+    }
+
+    return outMatches;
+}
+
+std::vector<CatalogMatch<CatalogPreset>> BankCatalog::FindPresetsCovering(const uint8_t keyLow, const uint8_t keyHigh) const
+{
+    std::vector<CatalogMatch<CatalogPreset>> outMatches{};
+    for (const auto& bank : m_banks)
+    {
+        for (const auto& preset : bank.m_presets)
+        {
+            if (preset.m_keyLow <= keyLow && preset.m_keyHigh >= keyHigh) { outMatches.emplace_back(&bank, &preset); }
+        }
+    }
+
+    return outMatches;
+}
+
+bool BankCatalog::IndexBank(const std::filesystem::path& file, const BankReadOptions& readOptions, const CatalogBank* previousBank,
+    CatalogBank& outBank, bool& outParsed)
+{
+    BinaryReader reader;
+    if (!reader.readFile(file)) { return false; }
+
+    const auto& fileData(reader.GetData());
+    outBank.m_file = file;
+    outBank.m_fileHash = MathFunctions::hashFNV1a(fileData.data(), fileData.size());
+    outBank.m_fileSize = fileData.size();
+
+    std::error_code errorCode;
+    outBank.m_fileWriteTime = std::filesystem::last_write_time(file, errorCode).time_since_epoch().count();
+
+    // Touched but not changed, keep what was indexed with the new write time
+    if (previousBank != nullptr && previousBank->m_fileHash == outBank.m_fileHash)
+    {
+        outBank.m_bankName = previousBank->m_bankName;
+        outBank.m_presets = previousBank->m_presets;
+        outBank.m_samples = previousBank->m_samples;
+        outBank.m_sequences = previousBank->m_sequences;
+        outParsed = false;
+        return true;
+    }
+
+    outParsed = true;
+    if (CommandLine::HasExtensionCI(file, BankSnapshotStatics::FILE_EXTENSION))
+    {
+        BankSnapshotView view;
+        if (view.Open(fileData.data(), fileData.size())) { FillFromSnapshot(view, outBank); }
+        return true;
+    }
+
+    const auto bank(CommandLine::HasExtensionCI(file, ".e4b") ? E4BReader::ProcessFile(reader, file) : SF2Reader::ProcessFile(reader, file, readOptions));
+    if (bank.IsValid()) { FillFromSoundbank(bank, outBank); }
+    return true;
+}
+
+bool BankCatalog::ContainsCI(const std::string_view& str, const std::string_view& subStr)
+{
+    return std::search(str.begin(), str.end(), subStr.begin(), subStr.end(),
+        [](const char a, const char b) { return std::tolower(static_cast<uint8_t>(a)) == std::tolower(static_cast<uint8_t>(b)); }) != str.end();
+}
+
+std::string BankCatalog::SerializeBank(const CatalogBank& bank)
+{
+    std::string outStr(std::format("B\t{:016x}\t{}\t{}\t{}\t{}\n", bank.m_fileHash, bank.m_fileSize, bank.m_fileWriteTime, bank.m_bankName,
+        BatchManifest::PathToUTF8(bank.m_file)));
+
+    for (const auto& preset : bank.m_presets)
+    {
+        outStr += std::format("P\t{}\t{}\t{}\t{}\t{}\n", preset.m_index, static_cast<uint32_t>(preset.m_keyLow), static_cast<uint32_t>(preset.m_keyHigh),
+            preset.m_numVoices, preset.m_presetName);
+    }
+
+    for (const auto& sample : bank.m_samples)
+    {
+        outStr += std::format("S\t{}\t{}\t{}\t{}\t{}\t{}\n", sample.m_index, sample.m_sampleRate, sample.m_channels, sample.m_numFrames,
+            sample.m_isLooping ? 1 : 0, sample.m_sampleName);
+    }
+
+    for (const auto& sequence : bank.m_sequences) { outStr += std::format("Q\t{}\t{}\t{}\n", sequence.m_index, sequence.m_size, sequence.m_sequenceName); }
+
+    return outStr;
+}
+
+bool BankCatalog::DeserializeLine(const std::string& line, std::vector<CatalogBank>& banks)
+{
+    const std::string_view lineView(line);
+    if (lineView.length() < 2 || lineView[1] != '\t') { return false; }
+
+    const auto fields(lineView.substr(2));
+    if (lineView[0] == 'B')
+    {
+        std::array<std::string_view, 5> columns{};
+        CatalogBank bank{};
+        if (!SplitColumns(fields, columns) || !ParseValue(columns[0], bank.m_fileHash, 16) || !ParseValue(columns[1], bank.m_fileSize)
+            || !ParseValue(columns[2], bank.m_fileWriteTime) || columns[4].empty()) { return false; }
+
+        bank.m_bankName = columns[3];
+        bank.m_file = BatchManifest::PathFromUTF8(columns[4]);
+        banks.emplace_back(std::move(bank));
+        return true;
+    }
+
+    // Everything else belongs to the bank line before it
+    if (banks.empty()) { return false; }
+    auto& bank(banks.back());
+
+    if (lineView[0] == 'P')
+    {
+        std::array<std::string_view, 5> columns{};
+        CatalogPreset preset{};
+        if (!SplitColumns(fields, columns) || !ParseValue(columns[0], preset.m_index) || !ParseValue(columns[1], preset.m_keyLow)
+            || !ParseValue(columns[2], preset.m_keyHigh) || !ParseValue(columns[3], preset.m_numVoices)) { return false; }
+
+        preset.m_presetName = columns[4];
+        bank.m_presets.emplace_back(std::move(preset));
+        return true;
+    }
+
+    if (lineView[0] == 'S')
+    {
+        std::array<std::string_view, 6> columns{};
+        CatalogSample sample{};
+        uint32_t isLooping(0u);
+        if (!SplitColumns(fields, columns) || !ParseValue(columns[0], sample.m_index) || !ParseValue(columns[1], sample.m_sampleRate)
+            || !ParseValue(columns[2], sample.m_channels) || !ParseValue(columns[3], sample.m_numFrames) || !ParseValue(columns[4], isLooping)) { return false; }
+
+        sample.m_isLooping = isLooping != 0u;
+        sample.m_sampleName = columns[5];
+        bank.m_samples.emplace_back(std::move(sample));
+        return true;
+    }
+
+    if (lineView[0] == 'Q')
+    {
+        std::array<std::string_view, 3> columns{};
+        CatalogSequence sequence{};
+        if (!SplitColumns(fields, columns) || !ParseValue(columns[0], sequence.m_index) || !ParseValue(columns[1], sequence.m_size)) { return false; }
+
+        sequence.m_sequenceName = columns[2];
+        bank.m_sequences.emplace_back(std::move(sequence));
+        return true;
+    }
+
+    return false;
+}
+
+void BankCatalog::RebuildIndices()
+{
+    m_bankIndices.clear();
+
+    // Later entries for the same file win, the earlier ones are dropped
+    std::vector<CatalogBank> uniqueBanks{};
+    uniqueBanks.reserve(m_banks.size());
+    for (auto& bank : m_banks)
+    {
+        const auto [it, inserted](m_bankIndices.emplace(GetBankKey(bank.m_file), uniqueBanks.size()));
+        if (inserted) { uniqueBanks.emplace_back(std::move(bank)); }
+        else { uniqueBanks[it->second] = std::move(bank); }
+    }
+
+    m_banks = std::move(uniqueBanks);
+}
@@ -1,10 +1,14 @@
 #include "Header/BankConverter.h"
 #include "Header/BankWriteOptions.h"
+#include "Header/IO/BankSnapshot.h"
 #include "Header/IO/BinaryWriter.h"
+#include "Header/IO/BufferStream.h"
 #include "Header/Logger.h"
 #include "Header/Data/Soundbank.h"
 #include "Header/IO/E4BWriter.h"
 #include "Header/IO/SF2Writer.h"
+#include "Header/IO/SFZWriter.h"
+#include "Header/Profiler.h"
 
 bool BankConverter::CreateSF2(const Soundbank& bank, const BankWriteOptions& options)
 {
@@ -34,17 +38,78 @@ bool BankConverter::CreateE4B(const Soundbank& bank, const BankWriteOptions& opt
         }
         
         BinaryWriter writer(filePath);
-        
-        E4BWriter e4Writer;
-        e4Writer.BeginWriting(writer);
-
-        e4Writer.m_presets = bank.m_presets;
-        e4Writer.m_samples = bank.m_samples;
-
-        e4Writer.EndWriting(writer);
+        WriteE4BData(bank, writer);
         return true;
     }
     
     Logger::LogMessage("Bank was invalid!");
     return false;
+}
+
+bool BankConverter::CreateSFZ(const Soundbank& bank, const BankWriteOptions& options, AsyncIOBackend& ioBackend, std::filesystem::path& outFolder)
+{
+    if (bank.IsValid())
+    {
+        constexpr SFZWriter sfzWriter;
+        outFolder = options.m_saveFolder / sfzWriter.GetFolderName(bank);
+        return sfzWriter.WriteData(bank, options, ioBackend);
+    }
+
+    Logger::LogMessage("Bank was invalid!");
+    return false;
+}
+
+bool BankConverter::EncodeSF2(const Soundbank& bank, const BankWriteOptions& options, BankOutputFile& outFile)
+{
+    if (bank.IsValid())
+    {
+        constexpr SF2Writer sf2Writer;
+        outFile.m_path = options.m_saveFolder / sf2Writer.GetFileName(bank, options);
+        outFile.m_data.clear();
+
+        BufferStreamBuf streamBuf(outFile.m_data);
+        std::ostream stream(&streamBuf);
+        return sf2Writer.WriteData(bank, options, stream);
+    }
+
+    Logger::LogMessage("Bank was invalid!");
+    return false;
+}
+
+bool BankConverter::EncodeE4B(const Soundbank& bank, const BankWriteOptions& options, BankOutputFile& outFile)
+{
+    if (bank.IsValid())
+    {
+        outFile.m_path = options.m_saveFolder / (bank.m_bankName + ".E4B");
+
+        BinaryWriter writer;
+        WriteE4BData(bank, writer);
+        outFile.m_data = writer.TakeData();
+        return !outFile.m_data.empty();
+    }
+
+    Logger::LogMessage("Bank was invalid!");
+    return false;
+}
+
+bool BankConverter::EncodeSnapshot(const Soundbank& bank, const BankWriteOptions& options, BankOutputFile& outFile)
+{
+    if (bank.IsValid())
+    {
+        outFile.m_path = options.m_saveFolder / (bank.m_bankName + std::string(BankSnapshotStatics::FILE_EXTENSION));
+        outFile.m_data = BankSnapshot::Encode(bank);
+        return !outFile.m_data.empty();
+    }
+
+    Logger::LogMessage("Bank was invalid!");
+    return false;
+}
+
+void BankConverter::WriteE4BData(const Soundbank& bank, BinaryWriter& writer)
+{
+    const Profiler::StageScope e4bWriteScope(EProfileStage::E4B_WRITE);
+
+    E4BWriter e4Writer(bank);
+    e4Writer.BeginWriting(writer);
+    e4Writer.EndWriting(writer);
 }
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "Header/BankDetailsCache.h"
+#include "Header/BatchManifest.h"
+#include "Header/IO/E4BReader.h"
+#include <algorithm>
+#include <format>
+
+BankDetails::BankDetails(Soundbank&& bank) : m_bank(std::move(bank))
+{
+    m_sampleSizes.reserve(m_bank.m_samples.size());
+    for (auto& sample : m_bank.m_samples)
+    {
+        m_sampleSizes.emplace_back(sample.m_sampleData.size());
+        std::vector<int16_t>().swap(sample.m_sampleData);
+    }
+
+    m_presetLabels.reserve(m_bank.m_presets.size());
+    m_firstVoiceIndices.reserve(m_bank.m_presets.size());
+    for (const auto& preset : m_bank.m_presets)
+    {
+        m_presetLabels.emplace_back(std::format("P{:03} {}", preset.m_index, preset.m_presetName));
+        m_firstVoiceIndices.emplace_back(m_numVoices);
+        m_numVoices += preset.m_voices.size();
+    }
+}
+
+BankDetailsCache::~BankDetailsCache()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+
+    // A bank that is being parsed is finished first, the rest of the queue is dropped
+    m_loadCondition.notify_all();
+    if (m_loaderThread.joinable()) { m_loaderThread.join(); }
+}
+
+void BankDetailsCache::Load(const std::filesystem::path& file)
+{
+    std::error_code errorCode;
+    const auto fileWriteTime(std::filesystem::last_write_time(file, errorCode).time_since_epoch().count());
+    auto key(BatchManifest::PathToUTF8(file.lexically_normal()));
+
+    {
+        std::lock_guard lock(m_mutex);
+        if (auto* entry = FindEntry(key))
+        {
+            entry->m_lastUsed = ++m_useCounter;
+            if (entry->m_state == EBankDetailsState::LOADING) { return; }
+            if (entry->m_state == EBankDetailsState::READY && entry->m_fileWriteTime == fileWriteTime) { return; }
+
+            // Changed on disk or failed last time, read it again
+            entry->m_details.reset();
+            entry->m_fileWriteTime = fileWriteTime;
+            entry->m_state = EBankDetailsState::LOADING;
+        }
+        else
+        {
+            m_entries.emplace_back(std::move(key), nullptr, fileWriteTime, ++m_useCounter, EBankDetailsState::LOADING);
+            EvictOldest();
+        }
+
+        m_pendingLoads.emplace_back(file);
+        if (!m_loaderThread.joinable()) { m_loaderThread = std::thread([this] { LoaderThread(); }); }
+    }
+
+    m_loadCondition.notify_one();
+}
+
+EBankDetailsState BankDetailsCache::GetDetails(const std::filesystem::path& file, std::shared_ptr<const BankDetails>& outDetails) const
+{
+    const auto key(BatchManifest::PathToUTF8(file.lexically_normal()));
+
+    std::lock_guard lock(m_mutex);
+    const auto it(std::ranges::find(m_entries, key, &CacheEntry::m_key));
+    if (it == m_entries.end()) { return EBankDetailsState::NOT_LOADED; }
+
+    outDetails = it->m_details;
+    return it->m_state;
+}
+
+void BankDetailsCache::LoaderThread()
+{
+    while (true)
+    {
+        std::filesystem::path file;
+        {
+            std::unique_lock lock(m_mutex);
+            m_loadCondition.wait(lock, [this] { return m_isShuttingDown || !m_pendingLoads.empty(); });
+            if (m_isShuttingDown) { return; }
+
+            file = std::move(m_pendingLoads.front());
+            m_pendingLoads.pop_front();
+        }
+
+        auto bank(E4BReader::ProcessFile(file));
+        const bool isValid(bank.IsValid());
+        auto details(isValid ? std::make_shared<const BankDetails>(std::move(bank)) : nullptr);
+
+        // The entry may have been evicted while the bank was parsing, then the result is just dropped
+        std::lock_guard lock(m_mutex);
+        if (auto* entry = FindEntry(BatchManifest::PathToUTF8(file.lexically_normal())); entry != nullptr && entry->m_state == EBankDetailsState::LOADING)
+        {
+            entry->m_details = std::move(details);
+            entry->m_state = isValid ? EBankDetailsState::READY : EBankDetailsState::FAILED;
+        }
+    }
+}
+
+void BankDetailsCache::EvictOldest()
+{
+    while (m_entries.size() > BankDetailsCacheStatics::MAX_CACHED_BANKS)
+    {
+        // Loading entries are still wanted, if every entry is loading the cache just runs over until they finish
+        auto oldestIt(m_entries.end());
+        for (auto it(m_entries.begin()); it != m_entries.end(); ++it)
+        {
+            if (it->m_state != EBankDetailsState::LOADING && (oldestIt == m_entries.end() || it->m_lastUsed < oldestIt->m_lastUsed)) { oldestIt = it; }
+        }
+
+        if (oldestIt == m_entries.end()) { return; }
+        m_entries.erase(oldestIt);
+    }
+}
+
+BankDetailsCache::CacheEntry* BankDetailsCache::FindEntry(const std::string& key)
+{
+    const auto it(std::ranges::find(m_entries, key, &CacheEntry::m_key));
+    return it != m_entries.end() ? &*it : nullptr;
+}
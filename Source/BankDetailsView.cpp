@@ -0,0 +1,105 @@
+#include "Header/BankDetailsView.h"
+#include "Header/BankDetailsCache.h"
+
+void BankDetailsView::SetBank(const std::shared_ptr<const BankDetails>& details)
+{
+    m_details = details;
+    m_sectionsOpen = {};
+    m_presetsOpen.assign(details != nullptr ? details->m_bank.m_presets.size() : 0, 0ui8);
+    m_voicesOpen.assign(details != nullptr ? details->m_numVoices : 0, 0ui8);
+    m_samplesOpen.assign(details != nullptr ? details->m_bank.m_samples.size() : 0, 0ui8);
+    m_sequencesOpen.assign(details != nullptr ? details->m_bank.m_sequences.size() : 0, 0ui8);
+    m_rowsDirty = true;
+}
+
+const std::vector<DetailsRow>& BankDetailsView::GetRows()
+{
+    if (m_rowsDirty) { RebuildRows(); }
+    return m_rows;
+}
+
+bool BankDetailsView::IsOpen(const DetailsRow& row) const
+{
+    const auto* openState(GetOpenState(row));
+    return openState != nullptr && *openState != 0ui8;
+}
+
+void BankDetailsView::SetOpen(const DetailsRow& row, const bool isOpen)
+{
+    auto* openState(const_cast<uint8_t*>(GetOpenState(row)));
+    if (openState == nullptr || (*openState != 0ui8) == isOpen) { return; }
+
+    *openState = isOpen ? 1ui8 : 0ui8;
+    m_rowsDirty = true;
+}
+
+const uint8_t* BankDetailsView::GetOpenState(const DetailsRow& row) const
+{
+    switch (row.m_type)
+    {
+    case EDetailsRowType::SECTION: return &m_sectionsOpen[row.m_index];
+    case EDetailsRowType::PRESET: return &m_presetsOpen[row.m_index];
+    case EDetailsRowType::VOICE: return &m_voicesOpen[m_details->m_firstVoiceIndices[row.m_index] + row.m_subIndex];
+    case EDetailsRowType::SAMPLE: return &m_samplesOpen[row.m_index];
+    case EDetailsRowType::SEQUENCE: return &m_sequencesOpen[row.m_index];
+    default: return nullptr;
+    }
+}
+
+void BankDetailsView::RebuildRows()
+{
+    m_rows.clear();
+    m_rowsDirty = false;
+    if (m_details == nullptr) { return; }
+
+    const auto& bank(m_details->m_bank);
+    const auto addSection([this](const EDetailsSection section)
+    {
+        m_rows.emplace_back(EDetailsRowType::SECTION, 0ui8, 0ui16, static_cast<uint32_t>(section), 0u);
+        return m_sectionsOpen[static_cast<size_t>(section)] != 0ui8;
+    });
+
+    if (addSection(EDetailsSection::PRESETS))
+    {
+        for (uint32_t presetIndex(0u); presetIndex < bank.m_presets.size(); ++presetIndex)
+        {
+            m_rows.emplace_back(EDetailsRowType::PRESET, 1ui8, 0ui16, presetIndex, 0u);
+            if (m_presetsOpen[presetIndex] == 0ui8) { continue; }
+
+            const auto firstVoice(m_details->m_firstVoiceIndices[presetIndex]);
+            for (uint32_t voiceIndex(0u); voiceIndex < bank.m_presets[presetIndex].m_voices.size(); ++voiceIndex)
+            {
+                m_rows.emplace_back(EDetailsRowType::VOICE, 2ui8, 0ui16, presetIndex, voiceIndex);
+                if (m_voicesOpen[firstVoice + voiceIndex] == 0ui8) { continue; }
+
+                for (uint16_t line(0ui16); line < BankDetailsViewStatics::NUM_VOICE_INFO_LINES; ++line)
+                {
+                    m_rows.emplace_back(EDetailsRowType::VOICE_INFO, 3ui8, line, presetIndex, voiceIndex);
+                }
+            }
+        }
+    }
+
+    if (addSection(EDetailsSection::SAMPLES))
+    {
+        for (uint32_t sampleIndex(0u); sampleIndex < bank.m_samples.size(); ++sampleIndex)
+        {
+            m_rows.emplace_back(EDetailsRowType::SAMPLE, 1ui8, 0ui16, sampleIndex, 0u);
+            if (m_samplesOpen[sampleIndex] == 0ui8) { continue; }
+
+            for (uint16_t line(0ui16); line < BankDetailsViewStatics::NUM_SAMPLE_INFO_LINES; ++line)
+            {
+                m_rows.emplace_back(EDetailsRowType::SAMPLE_INFO, 2ui8, line, sampleIndex, 0u);
+            }
+        }
+    }
+
+    if (addSection(EDetailsSection::SEQUENCES))
+    {
+        for (uint32_t seqIndex(0u); seqIndex < bank.m_sequences.size(); ++seqIndex)
+        {
+            m_rows.emplace_back(EDetailsRowType::SEQUENCE, 1ui8, 0ui16, seqIndex, 0u);
+            if (m_sequencesOpen[seqIndex] != 0ui8) { m_rows.emplace_back(EDetailsRowType::SEQUENCE_EXTRACT, 2ui8, 0ui16, seqIndex, 0u); }
+        }
+    }
+}
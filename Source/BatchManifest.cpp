@@ -0,0 +1,141 @@
+#include "Header/BatchManifest.h"
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <fstream>
+
+bool BatchManifest::Load(const std::filesystem::path& manifestFile)
+{
+    m_entries.clear();
+    m_entryIndices.clear();
+
+    std::ifstream ifs(manifestFile, std::ios::binary);
+    if (!ifs.is_open()) { return false; }
+
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+        if (line.empty() || line.front() == '#') { continue; }
+
+        // A torn last line (crash mid-append) fails to parse and is dropped, that bank just gets converted again
+        BatchManifestEntry entry;
+        if (DeserializeEntry(line, entry)) { AddOrUpdateEntry(entry); }
+    }
+
+    return true;
+}
+
+bool BatchManifest::Save(const std::filesystem::path& manifestFile) const
+{
+    auto tempFile(manifestFile);
+    tempFile += ".tmp";
+
+    {
+        std::ofstream ofs(tempFile, std::ios::binary | std::ios::trunc);
+        if (!ofs.is_open()) { return false; }
+
+        ofs << BatchManifestStatics::MANIFEST_HEADER << '\n';
+        for (const auto& entry : m_entries) { ofs << SerializeEntry(entry); }
+
+        ofs.flush();
+        if (!ofs.good()) { return false; }
+    }
+
+    std::error_code errorCode;
+    std::filesystem::rename(tempFile, manifestFile, errorCode);
+    return !errorCode;
+}
+
+bool BatchManifest::AppendEntry(const std::filesystem::path& manifestFile, const BatchManifestEntry& entry) const
+{
+    std::ofstream ofs(manifestFile, std::ios::binary | std::ios::app);
+    if (!ofs.is_open()) { return false; }
+
+    // One write call per record so a crash leaves at most one torn line
+    const auto line(SerializeEntry(entry));
+    ofs.write(line.data(), static_cast<std::streamsize>(line.length()));
+    ofs.flush();
+    return ofs.good();
+}
+
+BatchManifestEntry* BatchManifest::FindEntry(const std::filesystem::path& inputFile)
+{
+    const auto it(m_entryIndices.find(GetEntryKey(inputFile)));
+    return it != m_entryIndices.end() ? &m_entries[it->second] : nullptr;
+}
+
+BatchManifestEntry& BatchManifest::AddOrUpdateEntry(const BatchManifestEntry& entry)
+{
+    if (auto* existingEntry = FindEntry(entry.m_inputFile))
+    {
+        *existingEntry = entry;
+        return *existingEntry;
+    }
+
+    m_entryIndices.emplace(GetEntryKey(entry.m_inputFile), m_entries.size());
+    return m_entries.emplace_back(entry);
+}
+
+std::string BatchManifest::GetEntryKey(const std::filesystem::path& inputFile)
+{
+    return PathToUTF8(inputFile.lexically_normal());
+}
+
+std::string BatchManifest::SerializeEntry(const BatchManifestEntry& entry)
+{
+    return std::format("{}\t{:016x}\t{}\t{}\t{:.3f}\t{}\t{}\n", BatchManifestStatics::STATUS_NAMES[static_cast<size_t>(entry.m_status)], entry.m_inputHash,
+        entry.m_inputSize, entry.m_inputWriteTime, entry.m_durationMs, PathToUTF8(entry.m_inputFile), PathToUTF8(entry.m_outputFile));
+}
+
+bool BatchManifest::DeserializeEntry(const std::string& line, BatchManifestEntry& outEntry)
+{
+    constexpr size_t NUM_COLUMNS(7);
+    std::array<std::string_view, NUM_COLUMNS> columns{};
+
+    const std::string_view lineView(line);
+    size_t columnStart(0);
+    for (size_t i(0); i < NUM_COLUMNS; ++i)
+    {
+        const size_t columnEnd(i + 1 < NUM_COLUMNS ? lineView.find('\t', columnStart) : lineView.length());
+        if (columnEnd == std::string_view::npos) { return false; }
+
+        columns[i] = lineView.substr(columnStart, columnEnd - columnStart);
+        columnStart = columnEnd + 1;
+    }
+
+    const auto statusIt(std::ranges::find(BatchManifestStatics::STATUS_NAMES, columns[0]));
+    if (statusIt == BatchManifestStatics::STATUS_NAMES.end()) { return false; }
+    outEntry.m_status = static_cast<EBatchStatus>(std::distance(BatchManifestStatics::STATUS_NAMES.begin(), statusIt));
+
+    const auto parseColumn([&](const size_t index, auto& outValue, const int base = 10)
+    {
+        const auto& column(columns[index]);
+        if constexpr (std::is_floating_point_v<std::remove_reference_t<decltype(outValue)>>)
+        {
+            return std::from_chars(column.data(), column.data() + column.size(), outValue).ec == std::errc();
+        }
+        else
+        {
+            return std::from_chars(column.data(), column.data() + column.size(), outValue, base).ec == std::errc();
+        }
+    });
+
+    if (!parseColumn(1, outEntry.m_inputHash, 16) || !parseColumn(2, outEntry.m_inputSize) || !parseColumn(3, outEntry.m_inputWriteTime)
+        || !parseColumn(4, outEntry.m_durationMs)) { return false; }
+
+    if (columns[5].empty()) { return false; }
+    outEntry.m_inputFile = PathFromUTF8(columns[5]);
+    outEntry.m_outputFile = PathFromUTF8(columns[6]);
+    return true;
+}
+
+std::string BatchManifest::PathToUTF8(const std::filesystem::path& path)
+{
+    const auto utf8Str(path.u8string());
+    return {utf8Str.begin(), utf8Str.end()};
+}
+
+std::filesystem::path BatchManifest::PathFromUTF8(const std::string_view& str)
+{
+    return {std::u8string(str.begin(), str.end())};
+}
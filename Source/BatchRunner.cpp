@@ -0,0 +1,149 @@
+#include "Header/BatchRunner.h"
+#include "Header/Data/Soundbank.h"
+#include "Header/IO/BankSnapshot.h"
+#include "Header/IO/SF2Writer.h"
+#include "Header/IO/SFZWriter.h"
+#include "Header/Logger.h"
+
+bool BatchRunner::Start(const std::filesystem::path& manifestFile, std::vector<ConversionJob>&& jobs, const BankReadOptions& readOptions,
+    const BankWriteOptions& writeOptions)
+{
+    if (IsRunning()) { return false; }
+
+    // Join anything left over from the previous batch before touching the manifest
+    m_pipeline.Wait();
+
+    std::vector<ConversionJob> pendingJobs{};
+    {
+        std::lock_guard lock(m_manifestMutex);
+        m_manifestFile = manifestFile;
+        m_failedInputs.clear();
+        m_summary = {};
+
+        // A missing manifest just means this is a fresh batch
+        static_cast<void>(m_manifest.Load(m_manifestFile));
+
+        for (auto& job : jobs)
+        {
+            const auto* entry(m_manifest.FindEntry(job.m_file));
+            if (entry != nullptr && IsUpToDate(*entry, job, writeOptions))
+            {
+                ++m_summary.m_numSkipped;
+                continue;
+            }
+
+            BatchManifestEntry pendingEntry(entry != nullptr ? *entry : BatchManifestEntry{});
+            pendingEntry.m_inputFile = job.m_file;
+            pendingEntry.m_status = EBatchStatus::PENDING;
+            m_manifest.AddOrUpdateEntry(pendingEntry);
+
+            pendingJobs.emplace_back(std::move(job));
+        }
+
+        if (!m_manifest.Save(m_manifestFile)) { Logger::LogMessage("Failed to write manifest '%s'", m_manifestFile.string().c_str()); }
+    }
+
+    Logger::LogMessage("Batch: %d to convert, %d already done", static_cast<int32_t>(pendingJobs.size()), static_cast<int32_t>(m_summary.m_numSkipped));
+    return m_pipeline.Start(std::move(pendingJobs), readOptions, writeOptions, [this](const ConversionResult& result) { OnBankComplete(result); });
+}
+
+BatchSummary BatchRunner::Wait()
+{
+    m_pipeline.Wait();
+
+    std::lock_guard lock(m_manifestMutex);
+    if (!m_manifestFile.empty() && !m_manifest.Save(m_manifestFile))
+    {
+        Logger::LogMessage("Failed to write manifest '%s'", m_manifestFile.string().c_str());
+    }
+
+    return m_summary;
+}
+
+BatchSummary BatchRunner::GetSummary() const
+{
+    std::lock_guard lock(m_manifestMutex);
+    return m_summary;
+}
+
+std::vector<std::filesystem::path> BatchRunner::GetFailedInputs() const
+{
+    std::lock_guard lock(m_manifestMutex);
+    return m_failedInputs;
+}
+
+std::filesystem::path BatchRunner::GetExpectedOutputFile(const ConversionJob& job, const BankWriteOptions& writeOptions)
+{
+    // Only the bank name matters for the output name, which comes from the input filename
+    const Soundbank namedBank(job.m_file.filename().replace_extension("").string());
+    if (job.m_targetFormat == EBankFormat::SF2)
+    {
+        constexpr SF2Writer sf2Writer;
+        return writeOptions.m_saveFolder / sf2Writer.GetFileName(namedBank, writeOptions);
+    }
+
+    if (job.m_targetFormat == EBankFormat::SFZ)
+    {
+        constexpr SFZWriter sfzWriter;
+        return writeOptions.m_saveFolder / sfzWriter.GetFolderName(namedBank);
+    }
+
+    if (job.m_targetFormat == EBankFormat::SNAPSHOT) { return writeOptions.m_saveFolder / (namedBank.m_bankName + std::string(BankSnapshotStatics::FILE_EXTENSION)); }
+
+    return writeOptions.m_saveFolder / (namedBank.m_bankName + ".E4B");
+}
+
+bool BatchRunner::IsUpToDate(const BatchManifestEntry& entry, ConversionJob& job, const BankWriteOptions& writeOptions) const
+{
+    if (entry.m_status != EBatchStatus::DONE) { return false; }
+    if (entry.m_outputFile != GetExpectedOutputFile(job, writeOptions) || !std::filesystem::exists(entry.m_outputFile)) { return false; }
+
+    std::error_code errorCode;
+    const auto inputSize(std::filesystem::file_size(job.m_file, errorCode));
+    if (errorCode || inputSize != entry.m_inputSize) { return false; }
+
+    const auto inputWriteTime(std::filesystem::last_write_time(job.m_file, errorCode));
+    if (errorCode) { return false; }
+
+    if (inputWriteTime.time_since_epoch().count() == entry.m_inputWriteTime) { return true; }
+
+    // Touched but maybe not changed, the worker hashes the input as it reads it anyway
+    job.m_unchangedInputHash = entry.m_inputHash;
+    return false;
+}
+
+void BatchRunner::OnBankComplete(const ConversionResult& result)
+{
+    std::lock_guard lock(m_manifestMutex);
+
+    BatchManifestEntry entry;
+    entry.m_inputFile = result.m_inputFile;
+    entry.m_outputFile = result.m_outputFile;
+    entry.m_inputHash = result.m_inputHash;
+    entry.m_inputSize = result.m_inputSize;
+    entry.m_inputWriteTime = result.m_inputWriteTime;
+    entry.m_durationMs = result.m_durationMs;
+    entry.m_status = result.m_succeeded ? EBatchStatus::DONE : EBatchStatus::FAILED;
+
+    // The earlier output is still current, only the write time is refreshed so the next run skips it without hashing
+    const auto* previousEntry(result.m_wasUnchanged ? m_manifest.FindEntry(result.m_inputFile) : nullptr);
+    if (previousEntry != nullptr)
+    {
+        entry.m_outputFile = previousEntry->m_outputFile;
+        entry.m_durationMs = previousEntry->m_durationMs;
+    }
+
+    m_manifest.AddOrUpdateEntry(entry);
+    if (!m_manifest.AppendEntry(m_manifestFile, entry))
+    {
+        Logger::LogMessage("Failed to update manifest '%s'", m_manifestFile.string().c_str());
+    }
+
+    if (result.m_wasUnchanged) { ++m_summary.m_numSkipped; }
+    else if (result.m_succeeded) { ++m_summary.m_numConverted; }
+    else
+    {
+        ++m_summary.m_numFailed;
+        m_failedInputs.emplace_back(result.m_inputFile);
+    }
+}
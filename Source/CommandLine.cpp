@@ -0,0 +1,423 @@
+#include "Header/CommandLine.h"
+#include "Header/BankCatalog.h"
+#include "Header/BatchRunner.h"
+#include "Header/IO/BankSnapshot.h"
+#include "Header/IO/MappedFile.h"
+#include "Header/Logger.h"
+#include "Header/PreviewBaseline.h"
+#include "Header/Resampler.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+
+int CommandLine::Run(const std::vector<std::string>& args)
+{
+    Logger::m_echoToStdout = true;
+
+    if (!args.empty())
+    {
+        if (args[0] == "batch") { return RunBatch(args); }
+        if (args[0] == "verify") { return RunVerify(args); }
+        if (args[0] == "snapshot") { return RunSnapshotInfo(args); }
+        if (args[0] == "catalog") { return RunCatalog(args); }
+    }
+
+    PrintUsage();
+    return 1;
+}
+
+void CommandLine::PrintUsage()
+{
+    std::puts("Usage:");
+    std::puts("  batch --to <sf2|e4b|sfz|osb> --out <folder> [--manifest <file>] [--memory-mb <n>] [--profile] [--sf3] [--trim] [--rate <44100|48000>] <files or folders...>");
+    std::puts("      Converts every bank, recording progress in the manifest (default: <out>/conversion_manifest.tsv).");
+    std::puts("      osb is a native snapshot of the parsed bank, converting from one again skips parsing the E4B / SF2.");
+    std::puts("      Rerunning with the same manifest skips finished banks and retries failed ones.");
+    std::puts("      --profile writes <bank>.profile.json and <bank>.trace.json next to each converted bank.");
+    std::puts("      --sf3 writes SF2 output as .sf3 with FLAC compressed samples, .sf3 input is always accepted.");
+    std::puts("      --trim strips leading and trailing silence from samples, without cutting into loops.");
+    std::puts("      --rate resamples every sample at another rate, loop points and tuning are adjusted to match.");
+    std::puts("  catalog --catalog <file> [--sequence <name>] [--preset <name>] [--keys <low>-<high>] [files or folders...]");
+    std::puts("      Indexes the presets, samples and sequences of every bank given, only new or changed banks are read.");
+    std::puts("      The queries search the whole catalog, names match anywhere (case-insensitive), keys are numbers or names (C4 = 60).");
+    std::puts("  snapshot <osb files or folders...>");
+    std::puts("      Lists the presets, voices and samples held in each snapshot.");
+    std::puts("  verify --baseline <file> [--update] <sf2/sf3 files or folders...>");
+    std::puts("      Renders test notes from every preset and compares the audio against the baseline.");
+    std::puts("      Banks missing from the baseline are added, --update replaces the stored fingerprints of changed banks.");
+}
+
+int CommandLine::RunBatch(const std::vector<std::string>& args)
+{
+    BankReadOptions readOptions{};
+    BankWriteOptions writeOptions{};
+    std::filesystem::path manifestFile;
+    std::vector<std::filesystem::path> inputs{};
+    std::string targetFormat;
+
+    for (size_t i(1); i < args.size(); ++i)
+    {
+        const auto& arg(args[i]);
+        const bool hasValue(i + 1 < args.size());
+        if (arg == "--to" && hasValue) { targetFormat = args[++i]; }
+        else if (arg == "--out" && hasValue) { writeOptions.m_saveFolder = PathFromArg(args[++i]); }
+        else if (arg == "--manifest" && hasValue) { manifestFile = PathFromArg(args[++i]); }
+        else if (arg == "--memory-mb" && hasValue)
+        {
+            const auto& value(args[++i]);
+            std::from_chars(value.data(), value.data() + value.size(), writeOptions.m_memoryBudgetMB);
+        }
+        else if (arg == "--profile") { writeOptions.m_exportProfiles = true; }
+        else if (arg == "--sf3") { writeOptions.m_compressSamples = true; }
+        else if (arg == "--trim") { writeOptions.m_trimSilence = true; }
+        else if (arg == "--rate" && hasValue)
+        {
+            const auto& value(args[++i]);
+            std::from_chars(value.data(), value.data() + value.size(), writeOptions.m_targetSampleRate);
+            if (std::ranges::find(ResamplerStatics::SUPPORTED_RATES, writeOptions.m_targetSampleRate) == ResamplerStatics::SUPPORTED_RATES.end())
+            {
+                std::printf("Unsupported sample rate '%s', use 44100 or 48000\n", value.c_str());
+                return 1;
+            }
+        }
+        else if (arg.starts_with("--"))
+        {
+            std::printf("Unknown option '%s'\n", arg.c_str());
+            PrintUsage();
+            return 1;
+        }
+        else { inputs.emplace_back(PathFromArg(arg)); }
+    }
+
+    std::ranges::transform(targetFormat, targetFormat.begin(), [](const char c) { return static_cast<char>(std::tolower(static_cast<uint8_t>(c))); });
+    if ((targetFormat != "sf2" && targetFormat != "e4b" && targetFormat != "sfz" && targetFormat != "osb") || writeOptions.m_saveFolder.empty() || inputs.empty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    std::error_code errorCode;
+    std::filesystem::create_directories(writeOptions.m_saveFolder, errorCode);
+    if (manifestFile.empty()) { manifestFile = writeOptions.m_saveFolder / BatchManifestStatics::DEFAULT_MANIFEST_NAME; }
+
+    // SFZ and snapshots can be made from any format, otherwise the input is whichever format we are not converting to
+    const EBankFormat target(targetFormat == "sf2" ? EBankFormat::SF2 : targetFormat == "e4b" ? EBankFormat::E4B
+        : targetFormat == "osb" ? EBankFormat::SNAPSHOT : EBankFormat::SFZ);
+    std::vector<std::string_view> extensions{};
+    if (target != EBankFormat::E4B) { extensions.emplace_back(".e4b"); }
+    if (target != EBankFormat::SF2) { extensions.emplace_back(".sf2"); }
+    if (target != EBankFormat::SNAPSHOT) { extensions.emplace_back(BankSnapshotStatics::FILE_EXTENSION); }
+    extensions.emplace_back(".sf3");
+
+    std::vector<ConversionJob> jobs{};
+    for (auto& file : GatherInputFiles(inputs, extensions))
+    {
+        const EBankFormat source(HasExtensionCI(file, ".e4b") ? EBankFormat::E4B
+            : HasExtensionCI(file, BankSnapshotStatics::FILE_EXTENSION) ? EBankFormat::SNAPSHOT : EBankFormat::SF2);
+        jobs.emplace_back(std::move(file), source, target);
+    }
+
+    BatchRunner batchRunner;
+    if (!batchRunner.Start(manifestFile, std::move(jobs), readOptions, writeOptions)) { return 1; }
+
+    const auto summary(batchRunner.Wait());
+    std::printf("Converted: %u, skipped: %u, failed: %u\n", summary.m_numConverted, summary.m_numSkipped, summary.m_numFailed);
+    return summary.m_numFailed == 0u ? 0 : 2;
+}
+
+int CommandLine::RunVerify(const std::vector<std::string>& args)
+{
+    std::filesystem::path baselineFile;
+    std::vector<std::filesystem::path> inputs{};
+    bool updateBaseline(false);
+
+    for (size_t i(1); i < args.size(); ++i)
+    {
+        const auto& arg(args[i]);
+        if (arg == "--baseline" && i + 1 < args.size()) { baselineFile = PathFromArg(args[++i]); }
+        else if (arg == "--update") { updateBaseline = true; }
+        else if (arg.starts_with("--"))
+        {
+            std::printf("Unknown option '%s'\n", arg.c_str());
+            PrintUsage();
+            return 1;
+        }
+        else { inputs.emplace_back(PathFromArg(arg)); }
+    }
+
+    if (baselineFile.empty() || inputs.empty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // A missing baseline is fine, the first run records it
+    PreviewBaseline baseline;
+    std::ignore = baseline.Load(baselineFile);
+
+    uint32_t numMatched(0u), numChanged(0u), numAdded(0u), numFailed(0u);
+    bool baselineChanged(false);
+    for (const auto& file : GatherInputFiles(inputs, {".sf2", ".sf3"}))
+    {
+        BankFingerprint fingerprint{};
+        if (!PreviewRenderer::FingerprintBank(file, fingerprint))
+        {
+            ++numFailed;
+            continue;
+        }
+
+        const auto* expected(baseline.FindBank(fingerprint.m_bankName));
+        if (expected == nullptr)
+        {
+            std::printf("%s: added to the baseline\n", fingerprint.m_bankName.c_str());
+            baseline.AddOrUpdateBank(std::move(fingerprint));
+            baselineChanged = true;
+            ++numAdded;
+            continue;
+        }
+
+        const auto differences(PreviewRenderer::CompareFingerprints(*expected, fingerprint));
+        if (differences.empty())
+        {
+            ++numMatched;
+            continue;
+        }
+
+        std::printf("%s: %zu difference(s)\n", fingerprint.m_bankName.c_str(), differences.size());
+        for (const auto& difference : differences) { std::printf("  %s\n", difference.c_str()); }
+        ++numChanged;
+
+        if (updateBaseline)
+        {
+            baseline.AddOrUpdateBank(std::move(fingerprint));
+            baselineChanged = true;
+        }
+    }
+
+    if (baselineChanged && !baseline.Save(baselineFile))
+    {
+        Logger::LogMessage("Unable to save the baseline '%s'", baselineFile.string().c_str());
+        return 2;
+    }
+
+    std::printf("Matched: %u, changed: %u, added: %u, failed: %u\n", numMatched, numChanged, numAdded, numFailed);
+
+    // Accepted changes (--update) still count, the run is reporting what differed
+    return numChanged == 0u && numFailed == 0u ? 0 : 2;
+}
+
+int CommandLine::RunSnapshotInfo(const std::vector<std::string>& args)
+{
+    std::vector<std::filesystem::path> inputs{};
+    for (size_t i(1); i < args.size(); ++i) { inputs.emplace_back(PathFromArg(args[i])); }
+
+    const auto files(GatherInputFiles(inputs, {BankSnapshotStatics::FILE_EXTENSION}));
+    if (files.empty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // Read straight from the mapped file, nothing is decoded
+    uint32_t numFailed(0u);
+    for (const auto& file : files)
+    {
+        MappedFile mappedFile;
+        BankSnapshotView view;
+        if (!mappedFile.Open(file) || !view.Open(mappedFile.GetData(), mappedFile.GetSize()))
+        {
+            std::printf("%s: not a valid bank snapshot (version %u)\n", file.string().c_str(), BankSnapshotStatics::VERSION);
+            ++numFailed;
+            continue;
+        }
+
+        const auto& header(view.GetHeader());
+        const auto bankName(view.GetString(header.m_bankName));
+        std::printf("%.*s: %u presets, %u voices, %u samples, %u sequences, %llu bytes\n", static_cast<int>(bankName.length()), bankName.data(), header.m_numPresets,
+            header.m_numVoices, header.m_numSamples, header.m_numSequences, static_cast<unsigned long long>(header.m_fileSize));
+
+        for (const auto& preset : view.GetPresets())
+        {
+            const auto presetName(view.GetString(preset.m_name));
+            std::printf("  Preset %u '%.*s': %u voices\n", preset.m_index, static_cast<int>(presetName.length()), presetName.data(), preset.m_numVoices);
+        }
+
+        for (const auto& sample : view.GetSamples())
+        {
+            const auto sampleName(view.GetString(sample.m_name));
+            std::printf("  Sample %u '%.*s': %u Hz, %u ch, %llu frames%s\n", sample.m_index, static_cast<int>(sampleName.length()), sampleName.data(), sample.m_sampleRate,
+                sample.m_channels, static_cast<unsigned long long>(sample.m_numValues / std::max(sample.m_channels, 1u)), sample.m_isLooping != 0ui8 ? ", looping" : "");
+        }
+    }
+
+    return numFailed == 0u ? 0 : 2;
+}
+
+int CommandLine::RunCatalog(const std::vector<std::string>& args)
+{
+    std::filesystem::path catalogFile;
+    std::vector<std::filesystem::path> inputs{};
+    std::string sequenceQuery, presetQuery;
+    bool queryKeys(false);
+    uint8_t keyLow(0ui8), keyHigh(127ui8);
+
+    for (size_t i(1); i < args.size(); ++i)
+    {
+        const auto& arg(args[i]);
+        const bool hasValue(i + 1 < args.size());
+        if (arg == "--catalog" && hasValue) { catalogFile = PathFromArg(args[++i]); }
+        else if (arg == "--sequence" && hasValue) { sequenceQuery = args[++i]; }
+        else if (arg == "--preset" && hasValue) { presetQuery = args[++i]; }
+        else if (arg == "--keys" && hasValue)
+        {
+            const std::string_view value(args[++i]);
+            const auto separator(value.find('-', 1)); // A leading '-' would be a negative octave
+            if (separator == std::string_view::npos || !ParseKey(value.substr(0, separator), keyLow) || !ParseKey(value.substr(separator + 1), keyHigh)
+                || keyLow > keyHigh)
+            {
+                std::printf("Invalid key range '%s', use <low>-<high> e.g. C1-C2 or 36-48\n", args[i].c_str());
+                return 1;
+            }
+
+            queryKeys = true;
+        }
+        else if (arg.starts_with("--"))
+        {
+            std::printf("Unknown option '%s'\n", arg.c_str());
+            PrintUsage();
+            return 1;
+        }
+        else { inputs.emplace_back(PathFromArg(arg)); }
+    }
+
+    if (catalogFile.empty() || (inputs.empty() && sequenceQuery.empty() && presetQuery.empty() && !queryKeys))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // A missing catalog is fine, the first update creates it
+    BankCatalog catalog;
+    std::ignore = catalog.Load(catalogFile);
+
+    uint32_t numFailed(0u);
+    if (!inputs.empty())
+    {
+        const auto result(catalog.Update(GatherInputFiles(inputs, {".e4b", ".sf2", ".sf3", BankSnapshotStatics::FILE_EXTENSION}), BankReadOptions{}));
+        if (!catalog.Save(catalogFile))
+        {
+            Logger::LogMessage("Unable to save the catalog '%s'", catalogFile.string().c_str());
+            return 2;
+        }
+
+        std::printf("Indexed: %u, unchanged: %u, removed: %u, failed: %u\n", result.m_numIndexed, result.m_numUnchanged, result.m_numRemoved, result.m_numFailed);
+        numFailed = result.m_numFailed;
+    }
+
+    if (!sequenceQuery.empty())
+    {
+        for (const auto& [bank, sequence] : catalog.FindSequences(sequenceQuery))
+        {
+            std::printf("%s: sequence %u '%s', %llu bytes (%s)\n", bank->m_bankName.c_str(), sequence->m_index, sequence->m_sequenceName.c_str(),
+                static_cast<unsigned long long>(sequence->m_size), bank->m_file.string().c_str());
+        }
+    }
+
+    const auto printPreset([](const CatalogMatch<CatalogPreset>& match)
+    {
+        const auto& [bank, preset](match);
+        std::printf("%s: preset %u '%s', %u voices, keys %u-%u (%s)\n", bank->m_bankName.c_str(), preset->m_index, preset->m_presetName.c_str(),
+            preset->m_numVoices, preset->m_keyLow, preset->m_keyHigh, bank->m_file.string().c_str());
+    });
+
+    if (!presetQuery.empty() && queryKeys)
+    {
+        for (const auto& match : catalog.FindPresets(presetQuery))
+        {
+            if (match.m_item->m_keyLow <= keyLow && match.m_item->m_keyHigh >= keyHigh) { printPreset(match); }
+        }
+    }
+    else if (!presetQuery.empty()) { std::ranges::for_each(catalog.FindPresets(presetQuery), printPreset); }
+    else if (queryKeys) { std::ranges::for_each(catalog.FindPresetsCovering(keyLow, keyHigh), printPreset); }
+
+    return numFailed == 0u ? 0 : 2;
+}
+
+std::vector<std::filesystem::path> CommandLine::GatherInputFiles(const std::vector<std::filesystem::path>& inputs,
+    const std::vector<std::string_view>& extensions)
+{
+    const auto hasExtension([&extensions](const std::filesystem::path& file)
+    {
+        return std::ranges::any_of(extensions, [&file](const std::string_view& extension) { return HasExtensionCI(file, extension); });
+    });
+
+    std::vector<std::filesystem::path> outFiles{};
+    for (const auto& input : inputs)
+    {
+        std::error_code errorCode;
+        if (std::filesystem::is_directory(input, errorCode))
+        {
+            for (const auto& dirEntry : std::filesystem::recursive_directory_iterator(input, errorCode))
+            {
+                if (dirEntry.is_regular_file() && hasExtension(dirEntry.path())) { outFiles.emplace_back(dirEntry.path()); }
+            }
+        }
+        else if (hasExtension(input)) { outFiles.emplace_back(input); }
+        else { Logger::LogMessage("Skipping '%s', it is not a bank that can be converted to the target format", input.string().c_str()); }
+    }
+
+    // Keeps the manifest order stable between runs
+    std::ranges::sort(outFiles);
+    return outFiles;
+}
+
+std::filesystem::path CommandLine::PathFromArg(const std::string& arg)
+{
+    return BatchManifest::PathFromUTF8(arg);
+}
+
+bool CommandLine::ParseKey(const std::string_view& str, uint8_t& outKey)
+{
+    uint32_t key(0u);
+    if (const auto [ptr, ec](std::from_chars(str.data(), str.data() + str.size(), key)); ec == std::errc() && ptr == str.data() + str.size())
+    {
+        if (key > 127u) { return false; }
+
+        outKey = static_cast<uint8_t>(key);
+        return true;
+    }
+
+    constexpr std::string_view NOTE_LETTERS("CDEFGAB");
+    constexpr std::array NOTE_OFFSETS{0, 2, 4, 5, 7, 9, 11};
+    if (str.empty()) { return false; }
+
+    const auto letterIndex(NOTE_LETTERS.find(static_cast<char>(std::toupper(static_cast<uint8_t>(str[0])))));
+    if (letterIndex == std::string_view::npos) { return false; }
+
+    auto octaveStr(str.substr(1));
+    int32_t semitone(NOTE_OFFSETS[letterIndex]);
+    if (octaveStr.starts_with('#'))
+    {
+        ++semitone;
+        octaveStr.remove_prefix(1);
+    }
+
+    int32_t octave(0);
+    if (const auto [ptr, ec](std::from_chars(octaveStr.data(), octaveStr.data() + octaveStr.size(), octave)); ec != std::errc() || ptr != octaveStr.data() + octaveStr.size())
+    {
+        return false;
+    }
+
+    const int32_t noteKey((octave + 1) * 12 + semitone);
+    if (noteKey < 0 || noteKey > 127) { return false; }
+
+    outKey = static_cast<uint8_t>(noteKey);
+    return true;
+}
+
+bool CommandLine::HasExtensionCI(const std::filesystem::path& file, const std::string_view& extension)
+{
+    const auto fileExt(file.extension().string());
+    return fileExt.length() == extension.length() && std::equal(fileExt.begin(), fileExt.end(), extension.begin(),
+        [](const char a, const char b) { return std::tolower(static_cast<uint8_t>(a)) == std::tolower(static_cast<uint8_t>(b)); });
+}
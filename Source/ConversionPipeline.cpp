@@ -0,0 +1,313 @@
+#include "Header/ConversionPipeline.h"
+#include "Header/Data/Soundbank.h"
+#include "Header/IO/BankSnapshot.h"
+#include "Header/IO/BinaryReader.h"
+#include "Header/IO/E4BReader.h"
+#include "Header/IO/SF2Reader.h"
+#include "Header/Logger.h"
+#include "Header/MathFunctions.h"
+#include "Header/Profiler.h"
+#include "Header/Resampler.h"
+#include "Header/SampleTrimmer.h"
+#include <algorithm>
+#include <deque>
+
+ConversionPipeline::ConversionPipeline(const uint32_t numTransformWorkers) : m_readQueue(ConversionPipelineStatics::QUEUE_CAPACITY),
+    m_writeQueue(ConversionPipelineStatics::QUEUE_CAPACITY), m_memoryBudget(0), m_ioBackend(AsyncIO::CreateBackend()), m_numTransformWorkers(std::max(numTransformWorkers, 1u)) {}
+
+ConversionPipeline::~ConversionPipeline()
+{
+    Cancel();
+    JoinAll();
+    BufferPool::GetSharedPool().SetMemoryBudget(nullptr);
+}
+
+bool ConversionPipeline::Start(std::vector<ConversionJob>&& jobs, const BankReadOptions& readOptions, const BankWriteOptions& writeOptions,
+    ConversionCompleteCallback&& onComplete)
+{
+    if (IsRunning()) { return false; }
+
+    // Threads from the last run have finished their work, but still need to be joined
+    JoinAll();
+
+    if (jobs.empty()) { return true; }
+
+    m_readOptions = readOptions;
+    m_writeOptions = writeOptions;
+    m_onComplete = std::move(onComplete);
+
+    m_readQueue.Reset();
+    m_writeQueue.Reset();
+
+    // Idle pooled buffers count against the budget, detached around the reset so their bytes are not lost
+    auto& bufferPool(BufferPool::GetSharedPool());
+    bufferPool.SetMemoryBudget(nullptr);
+    m_memoryBudget.Reset(static_cast<size_t>(writeOptions.m_memoryBudgetMB) * 1024 * 1024);
+    bufferPool.SetMemoryBudget(&m_memoryBudget);
+
+    m_numBanksInProgress = static_cast<uint32_t>(jobs.size());
+    m_numActiveTransformWorkers = m_numTransformWorkers;
+
+    m_writeThread = std::thread([this] { WriteStage(); });
+    for (uint32_t i(0u); i < m_numTransformWorkers; ++i)
+    {
+        m_transformThreads.emplace_back([this] { TransformStage(); });
+    }
+
+    m_readThread = std::thread([this, jobs = std::move(jobs)]() mutable { ReadStage(std::move(jobs)); });
+    return true;
+}
+
+void ConversionPipeline::Cancel()
+{
+    m_memoryBudget.Cancel();
+    m_readQueue.Close();
+    m_writeQueue.Close();
+}
+
+void ConversionPipeline::Wait()
+{
+    JoinAll();
+}
+
+size_t ConversionPipeline::GetEstimatedBankMemory(const ConversionJob& job)
+{
+    std::error_code errorCode;
+    const auto fileSize(std::filesystem::file_size(job.m_file, errorCode));
+    if (errorCode) { return 0; }
+
+    const size_t memoryFactor(job.m_sourceFormat == EBankFormat::SF2 ? ConversionPipelineStatics::SF2_MEMORY_FACTOR
+        : job.m_sourceFormat == EBankFormat::SNAPSHOT ? ConversionPipelineStatics::SNAPSHOT_MEMORY_FACTOR : ConversionPipelineStatics::E4B_MEMORY_FACTOR);
+    return static_cast<size_t>(fileSize) * memoryFactor;
+}
+
+void ConversionPipeline::ReadStage(std::vector<ConversionJob> jobs)
+{
+    std::deque<PendingRead> pendingReads{};
+    size_t jobIndex(0);
+    bool isCancelled(false);
+
+    while (!isCancelled && (jobIndex < jobs.size() || !pendingReads.empty()))
+    {
+        // Keep up to PREFETCH_DEPTH reads in flight. Only block on the budget when nothing is pending,
+        // otherwise we'd be waiting on memory that only the pending reads can give back.
+        if (jobIndex < jobs.size() && pendingReads.size() < ConversionPipelineStatics::PREFETCH_DEPTH)
+        {
+            auto& job(jobs[jobIndex]);
+            BankTicket ticket{job.m_file, std::chrono::steady_clock::now(), 0u, jobIndex, GetEstimatedBankMemory(job)};
+            if (m_writeOptions.m_exportProfiles) { ticket.m_profile = std::make_shared<BankProfile>(job.m_file.filename().replace_extension("").string()); }
+
+            // Left at 0 unless both are known, a successful last_write_time would clear a failed file_size
+            std::error_code sizeErrorCode, timeErrorCode;
+            const auto inputSize(std::filesystem::file_size(job.m_file, sizeErrorCode));
+            const auto inputWriteTime(std::filesystem::last_write_time(job.m_file, timeErrorCode).time_since_epoch().count());
+            if (!sizeErrorCode && !timeErrorCode)
+            {
+                ticket.m_inputSize = inputSize;
+                ticket.m_inputWriteTime = inputWriteTime;
+            }
+
+            const bool reserved(pendingReads.empty() ? m_memoryBudget.Acquire(ticket.m_reservedBytes) : m_memoryBudget.TryAcquire(ticket.m_reservedBytes));
+            if (reserved)
+            {
+                // Idle pooled buffers never hold up a reservation, whatever no longer fits next to it is freed
+                BufferPool::GetSharedPool().Reclaim(m_memoryBudget.GetSpareOverflow());
+
+                const auto requestId(m_ioBackend->SubmitRead(job.m_file));
+                pendingReads.emplace_back(std::move(job), requestId, std::move(ticket), std::chrono::steady_clock::now());
+                ++jobIndex;
+                continue;
+            }
+
+            // Acquire only fails when cancelled
+            if (pendingReads.empty()) { break; }
+        }
+
+        auto pendingRead(std::move(pendingReads.front()));
+        pendingReads.pop_front();
+
+        BinaryBuffer fileData{};
+        auto reader(std::make_unique<BinaryReader>());
+        const bool readSucceeded(m_ioBackend->WaitRead(pendingRead.m_requestId, fileData));
+        if (auto* profile = pendingRead.m_ticket.m_profile.get())
+        {
+            // Submit to completion, most of it overlaps with other banks being converted
+            profile->AddStage(EProfileStage::FILE_READ, pendingRead.m_submitTime, std::chrono::steady_clock::now());
+            profile->AddCounter(EProfileCounter::BYTES_READ, fileData.size());
+        }
+
+        if (!readSucceeded || !reader->readData(std::move(fileData), pendingRead.m_job.m_file))
+        {
+            Logger::LogMessage("Failed to read '%s'", pendingRead.m_job.m_file.string().c_str());
+            FinishBank(pendingRead.m_ticket, {}, false);
+            continue;
+        }
+
+        auto ticket(pendingRead.m_ticket);
+        if (!m_readQueue.Push(ReadItem{std::move(pendingRead.m_job), std::move(reader), std::move(pendingRead.m_ticket)}))
+        {
+            FinishBank(ticket, {}, false);
+            isCancelled = true;
+        }
+    }
+
+    // Reads that were submitted but never handed over
+    for (const auto& pendingRead : pendingReads)
+    {
+        BinaryBuffer fileData{};
+        static_cast<void>(m_ioBackend->WaitRead(pendingRead.m_requestId, fileData));
+        FinishBank(pendingRead.m_ticket, {}, false);
+    }
+
+    // Jobs that never started due to cancellation
+    m_numBanksInProgress -= static_cast<uint32_t>(jobs.size() - jobIndex);
+    m_readQueue.Close();
+}
+
+void ConversionPipeline::TransformStage()
+{
+    while (auto item = m_readQueue.Pop())
+    {
+        auto& job(item->m_job);
+        auto& ticket(item->m_ticket);
+        const Profiler::BankScope profileScope(ticket.m_profile.get());
+
+        const auto& inputData(item->m_reader->GetData());
+        ticket.m_inputHash = MathFunctions::hashFNV1a(inputData.data(), inputData.size());
+
+        // Only touched since it was last converted, the hash is already needed here so the check costs nothing extra
+        if (job.m_unchangedInputHash != 0u && job.m_unchangedInputHash == ticket.m_inputHash)
+        {
+            ticket.m_wasUnchanged = true;
+            FinishBank(ticket, {}, true);
+            continue;
+        }
+
+        auto bank(ReadBank(job, *item->m_reader));
+
+        // Input bytes are no longer needed once the bank is decoded, the buffer goes back to the shared pool
+        item->m_reader.reset();
+
+        // Trimmed first, so the silence is not resampled too
+        if (m_writeOptions.m_trimSilence && bank.IsValid())
+        {
+            const auto trimResult(SampleTrimmer::TrimBank(bank));
+            if (trimResult.m_numTrimmedSamples > 0u)
+            {
+                Logger::LogMessage("(Bank: '%s') Trimmed silence from %u samples, %llu bytes saved", bank.m_bankName.c_str(), trimResult.m_numTrimmedSamples,
+                    static_cast<unsigned long long>(trimResult.m_bytesSaved));
+            }
+        }
+
+        if (m_writeOptions.m_targetSampleRate != 0u && bank.IsValid()) { Resampler::ResampleBank(bank, m_writeOptions.m_targetSampleRate); }
+
+        // SFZ is a folder of many files, the writer streams them straight to the I/O backend so it skips the write stage
+        if (job.m_targetFormat == EBankFormat::SFZ)
+        {
+            std::filesystem::path outputFolder;
+            const bool succeeded(BankConverter::CreateSFZ(bank, m_writeOptions, *m_ioBackend, outputFolder));
+            if (succeeded) { Logger::LogMessage("Successfully converted to %s!", outputFolder.filename().string().c_str()); }
+
+            FinishBank(ticket, outputFolder, succeeded);
+            continue;
+        }
+
+        WriteItem writeItem{{}, ticket};
+        bool encoded(false);
+        if (bank.IsValid())
+        {
+            encoded = job.m_targetFormat == EBankFormat::SF2 ? BankConverter::EncodeSF2(bank, m_writeOptions, writeItem.m_output)
+                : job.m_targetFormat == EBankFormat::SNAPSHOT ? BankConverter::EncodeSnapshot(bank, m_writeOptions, writeItem.m_output)
+                : BankConverter::EncodeE4B(bank, m_writeOptions, writeItem.m_output);
+        }
+
+        if (!encoded || !m_writeQueue.Push(std::move(writeItem)))
+        {
+            FinishBank(ticket, {}, false);
+        }
+    }
+
+    // Last worker out lets the writer know nothing else is coming
+    if (--m_numActiveTransformWorkers == 0u) { m_writeQueue.Close(); }
+}
+
+Soundbank ConversionPipeline::ReadBank(const ConversionJob& job, BinaryReader& reader) const
+{
+    if (job.m_sourceFormat == EBankFormat::SNAPSHOT)
+    {
+        // The records are used straight from the read buffer
+        const auto& fileData(reader.GetData());
+        BankSnapshotView view;
+        if (view.Open(fileData.data(), fileData.size())) { return BankSnapshot::Decode(view); }
+
+        Logger::LogMessage("'%s' is not a valid bank snapshot (version %u)", job.m_file.filename().string().c_str(), BankSnapshotStatics::VERSION);
+        return Soundbank(std::string());
+    }
+
+    return job.m_sourceFormat == EBankFormat::E4B ? E4BReader::ProcessFile(reader, job.m_file) : SF2Reader::ProcessFile(reader, job.m_file, m_readOptions);
+}
+
+void ConversionPipeline::WriteStage()
+{
+    while (auto item = m_writeQueue.Pop())
+    {
+        // Hand the buffer to the I/O backend and move on, the bank is finished once the write completes
+        auto outputPath(item->m_output.m_path);
+        auto tempPath(outputPath);
+        tempPath += ConversionPipelineStatics::TEMP_FILE_SUFFIX;
+
+        const auto submitTime(std::chrono::steady_clock::now());
+        if (auto* profile = item->m_ticket.m_profile.get()) { profile->AddCounter(EProfileCounter::BYTES_WRITTEN, item->m_output.m_data.size()); }
+
+        m_ioBackend->SubmitWrite(tempPath, std::move(item->m_output.m_data),
+            [this, outputPath = std::move(outputPath), tempPath, submitTime, ticket = std::move(item->m_ticket)](bool succeeded)
+        {
+            if (auto* profile = ticket.m_profile.get()) { profile->AddStage(EProfileStage::FILE_WRITE, submitTime, std::chrono::steady_clock::now()); }
+
+            std::error_code errorCode;
+            if (succeeded)
+            {
+                std::filesystem::rename(tempPath, outputPath, errorCode);
+                succeeded = !errorCode;
+            }
+
+            if (succeeded) { Logger::LogMessage("Successfully converted to %s!", outputPath.filename().string().c_str()); }
+            else
+            {
+                std::filesystem::remove(tempPath, errorCode);
+                Logger::LogMessage("Failed to write '%s'", outputPath.string().c_str());
+            }
+
+            FinishBank(ticket, outputPath, succeeded);
+        });
+    }
+
+    m_ioBackend->WaitForWrites();
+}
+
+void ConversionPipeline::FinishBank(const BankTicket& ticket, const std::filesystem::path& outputFile, const bool succeeded)
+{
+    m_memoryBudget.Release(ticket.m_reservedBytes);
+
+    if (ticket.m_profile != nullptr && !Profiler::WriteBankProfile(*ticket.m_profile, m_writeOptions.m_saveFolder))
+    {
+        Logger::LogMessage("Failed to write profile for '%s'", ticket.m_profile->GetBankName().c_str());
+    }
+
+    if (m_onComplete)
+    {
+        const std::chrono::duration<double, std::milli> duration(std::chrono::steady_clock::now() - ticket.m_startTime);
+        m_onComplete(ConversionResult{ticket.m_inputFile, outputFile, ticket.m_inputHash, ticket.m_inputSize, ticket.m_inputWriteTime, duration.count(),
+            ticket.m_jobIndex, succeeded, ticket.m_wasUnchanged});
+    }
+
+    --m_numBanksInProgress;
+}
+
+void ConversionPipeline::JoinAll()
+{
+    if (m_readThread.joinable()) { m_readThread.join(); }
+    for (auto& thread : m_transformThreads) { thread.join(); }
+    m_transformThreads.clear();
+    if (m_writeThread.joinable()) { m_writeThread.join(); }
+}
@@ -57,5 +57,6 @@ void Soundbank::Clear()
     m_presets.clear();
     m_samples.clear();
     m_sequences.clear();
+    m_multisampleMaps.clear();
     m_defaultPreset = 255ui8;
 }
@@ -1,10 +1,21 @@
 ﻿#include "Header/E4B/Data/E3Sample.h"
 #include "Header/Data/Soundbank.h"
 #include "Header/E4B/Helpers/E4BHelpers.h"
-#include "Header/IO/BinaryReader.h"
-#include "Header/IO/BinaryWriter.h"
+#include "Header/E4B/Helpers/E4RecordLayout.h"
 #include "Header/IO/E4BReader.h"
 
+struct E3SampleParams::Layout final : E4RecordLayout<E4BVariables::EOS_NUM_SAMPLE_PARAMETERS * sizeof(uint32_t),
+    E4Field<&E3SampleParams::m_unknown, 0>, E4Field<&E3SampleParams::m_leftChannelStart, 4>, E4Field<&E3SampleParams::m_rightChannelStart, 8>,
+    E4Field<&E3SampleParams::m_lastSampleLeftChannel, 12>, E4Field<&E3SampleParams::m_lastSampleRightChannel, 16>, E4Field<&E3SampleParams::m_loopStart, 20>,
+    E4Field<&E3SampleParams::m_loopStart2, 24>, E4Field<&E3SampleParams::m_loopEnd, 28>, E4Field<&E3SampleParams::m_loopEnd2, 32>> {};
+
+// Little-endian words in file order, so E3Sample copies the params whole
+static_assert(sizeof(E3SampleParams) == E4BVariables::EOS_NUM_SAMPLE_PARAMETERS * sizeof(uint32_t));
+
+struct E3Sample::Layout final : E4RecordLayout<E3SampleVariables::SAMPLE_DATA_READ_SIZE,
+    E4Field<&E3Sample::m_sampleIndex, 0>, E4Field<&E3Sample::m_name, 2>, E4Field<&E3Sample::m_params, 18>,
+    E4Field<&E3Sample::m_sampleRate, 54>, E4Field<&E3Sample::m_format, 58>, E4Field<&E3Sample::m_extraParams, 62>> {};
+
 E3SampleParams::E3SampleParams(const uint32_t sampleSize, const uint32_t loopStart, const uint32_t loopEnd)
     : m_lastSampleLeftChannel((sampleSize * 2u) - 2u + E3SampleVariables::TOTAL_SAMPLE_DATA_READ_SIZE),
     m_lastSampleRightChannel((sampleSize * 2u) - 2u), m_loopStart(loopStart * 2u + static_cast<uint32_t>(E3SampleVariables::TOTAL_SAMPLE_DATA_READ_SIZE)),
@@ -13,49 +24,27 @@ E3SampleParams::E3SampleParams(const uint32_t sampleSize, const uint32_t loopSta
 
 void E3SampleParams::write(BinaryWriter& writer) const
 {
-    writer.writeType(&m_unknown);
-    writer.writeType(&m_leftChannelStart);
-    writer.writeType(&m_rightChannelStart);
-    writer.writeType(&m_lastSampleLeftChannel);
-    writer.writeType(&m_lastSampleRightChannel);
-    writer.writeType(&m_loopStart);
-    writer.writeType(&m_loopStart2);
-    writer.writeType(&m_loopEnd);
-    writer.writeType(&m_loopEnd2);
+    Layout::Write(*this, writer);
 }
 
 void E3SampleParams::readAtLocation(ReadLocationHandle& readHandle)
 {
-    readHandle.readType(&m_unknown);
-    readHandle.readType(&m_leftChannelStart);
-    readHandle.readType(&m_rightChannelStart);
-    readHandle.readType(&m_lastSampleLeftChannel);
-    readHandle.readType(&m_lastSampleRightChannel);
-    readHandle.readType(&m_loopStart);
-    readHandle.readType(&m_loopStart2);
-    readHandle.readType(&m_loopEnd);
-    readHandle.readType(&m_loopEnd2);
+    Layout::Read(*this, readHandle);
 }
 
 E3Sample::E3Sample(const E4TOCChunk& chunk, BinaryReader& reader)
 {
     const uint64_t offset(chunk.GetStartOffset() + sizeof(E4DataChunk));
     ReadLocationHandle readHandle(reader, offset);
-
-    readHandle.readType(&m_sampleIndex);
-    readHandle.readType(m_name.data(),sizeof(char) * E4BVariables::EOS_E4_MAX_NAME_LEN);
-    m_params.readAtLocation(readHandle);
-    readHandle.readType(&m_sampleRate);
-    readHandle.readType(&m_format);
-    readHandle.readType(m_extraParams.data(), sizeof(uint32_t) * E4BVariables::EOS_NUM_EXTRA_SAMPLE_PARAMETERS);
+    Layout::Read(*this, readHandle);
     
     const size_t wavSize(chunk.GetLength() + sizeof(uint16_t) - E3SampleVariables::SAMPLE_DATA_READ_SIZE);
     m_sampleData.resize(wavSize / sizeof(int16_t));
     readHandle.readType(m_sampleData.data(), sizeof(int16_t) * m_sampleData.size());
 }
 
-E3Sample::E3Sample(const BankSample& sample) : m_sampleIndex(_byteswap_ushort(sample.m_index + 1ui16)), m_name(E4BHelpers::ConvertToE4Name(sample.m_sampleName)),
-    m_params(static_cast<uint32_t>(sample.m_sampleData.size()), sample.m_loopStart, sample.m_loopEnd), m_sampleRate(sample.m_sampleRate), m_sampleData(sample.m_sampleData)
+E3Sample::E3Sample(const BankSample& sample) : m_sampleIndex(static_cast<uint16_t>(sample.m_index + 1ui16)), m_name(E4BHelpers::ConvertToE4Name(sample.m_sampleName)),
+    m_params(static_cast<uint32_t>(sample.m_sampleData.size()), sample.m_loopStart, sample.m_loopEnd), m_sampleRate(sample.m_sampleRate), m_bankSampleData(sample.m_sampleData)
 {
     if(sample.m_channels == 1u)
     {
@@ -77,13 +66,11 @@ E3Sample::E3Sample(const BankSample& sample) : m_sampleIndex(_byteswap_ushort(sa
 
 void E3Sample::write(BinaryWriter& writer) const
 {
-    writer.writeType(&m_sampleIndex);
-    writer.writeType(m_name.data(), sizeof(char) * E4BVariables::EOS_E4_MAX_NAME_LEN);
-    m_params.write(writer);
-    writer.writeType(&m_sampleRate);
-    writer.writeType(&m_format);
-    writer.writeType(m_extraParams.data(), sizeof(uint32_t) * E4BVariables::EOS_NUM_EXTRA_SAMPLE_PARAMETERS);
-    writer.writeType(m_sampleData.data(), sizeof(uint16_t) * m_sampleData.size());
+    Layout::Write(*this, writer);
+
+    // Only one of these is set, depending on whether the sample was read or made from a BankSample
+    if (!m_sampleData.empty()) { writer.writeType(m_sampleData.data(), sizeof(int16_t) * m_sampleData.size()); }
+    if (!m_bankSampleData.empty()) { writer.writeType(m_bankSampleData.data(), sizeof(int16_t) * m_bankSampleData.size()); }
 }
 
 uint32_t E3Sample::GetNumChannels() const
@@ -1,29 +1,18 @@
 ﻿#include "Header/E4B/Data/E4Cord.h"
-#include "Header/IO/BinaryReader.h"
-#include "Header/IO/BinaryWriter.h"
+#include "Header/E4B/Helpers/E4RecordLayout.h"
+
+struct E4Cord::Layout final : E4RecordLayout<E4_CORD_DATA_SIZE,
+    E4Field<&E4Cord::m_src, 0>, E4Field<&E4Cord::m_dst, 1>, E4Field<&E4Cord::m_amt, 2>, E4Field<&E4Cord::m_possibleRedundant1, 3>> {};
+
+// Bytes only and in file order, so E4Voice copies all of its cords in one go
+static_assert(sizeof(E4Cord) == E4_CORD_DATA_SIZE);
 
 void E4Cord::write(BinaryWriter& writer) const
 {
-    const auto src(static_cast<uint8_t>(m_src));
-    writer.writeType(&src);
-
-    const auto dst(static_cast<uint8_t>(m_dst));
-    writer.writeType(&dst);
-    
-    writer.writeType(&m_amt);
-    writer.writeType(&m_possibleRedundant1);
+    Layout::Write(*this, writer);
 }
 
 void E4Cord::readAtLocation(ReadLocationHandle& readHandle)
 {
-    uint8_t src;
-    readHandle.readType(&src);
-    m_src = static_cast<EEOSCordSource>(src);
-    
-    int8_t dst;
-    readHandle.readType(&dst);
-    m_dst = static_cast<EEOSCordDest>(dst);
-    
-    readHandle.readType(&m_amt);
-    readHandle.readType(&m_possibleRedundant1);
+    Layout::Read(*this, readHandle);
 }
\ No newline at end of file
@@ -1,7 +1,14 @@
 ﻿#include "Header/E4B/Data/E4Envelope.h"
+#include "Header/E4B/Helpers/E4RecordLayout.h"
 #include "Header/E4B/Helpers/E4VoiceHelpers.h"
-#include "Header/IO/BinaryReader.h"
-#include "Header/IO/BinaryWriter.h"
+
+struct E4Envelope::Layout final : E4RecordLayout<E4_ENV_DATA_SIZE,
+    E4Field<&E4Envelope::m_attack1Sec, 0>, E4Field<&E4Envelope::m_attack1Level, 1>, E4Field<&E4Envelope::m_attack2Sec, 2>, E4Field<&E4Envelope::m_attack2Level, 3>,
+    E4Field<&E4Envelope::m_decay1Sec, 4>, E4Field<&E4Envelope::m_decay1Level, 5>, E4Field<&E4Envelope::m_decay2Sec, 6>, E4Field<&E4Envelope::m_decay2Level, 7>,
+    E4Field<&E4Envelope::m_release1Sec, 8>, E4Field<&E4Envelope::m_release1Level, 9>, E4Field<&E4Envelope::m_release2Sec, 10>, E4Field<&E4Envelope::m_release2Level, 11>> {};
+
+// Bytes only and in file order, so E4Voice copies envelopes whole
+static_assert(sizeof(E4Envelope) == E4_ENV_DATA_SIZE);
 
 float E4Envelope::GetAttack1Level() const
 {
@@ -57,38 +64,12 @@ E4Envelope::E4Envelope(const double attackSec, const double decaySec, const doub
 
 void E4Envelope::write(BinaryWriter& writer) const
 {
-    writer.writeType(&m_attack1Sec);
-    writer.writeType(&m_attack1Level);
-    writer.writeType(&m_attack2Sec);
-    writer.writeType(&m_attack2Level);
-    
-    writer.writeType(&m_decay1Sec);
-    writer.writeType(&m_decay1Level);
-    writer.writeType(&m_decay2Sec);
-    writer.writeType(&m_decay2Level);
-    
-    writer.writeType(&m_release1Sec);
-    writer.writeType(&m_release1Level);
-    writer.writeType(&m_release2Sec);
-    writer.writeType(&m_release2Level);
+    Layout::Write(*this, writer);
 }
 
 void E4Envelope::readAtLocation(ReadLocationHandle& readHandle)
 {
-    readHandle.readType(&m_attack1Sec);
-    readHandle.readType(&m_attack1Level);
-    readHandle.readType(&m_attack2Sec);
-    readHandle.readType(&m_attack2Level);
-
-    readHandle.readType(&m_decay1Sec);
-    readHandle.readType(&m_decay1Level);
-    readHandle.readType(&m_decay2Sec);
-    readHandle.readType(&m_decay2Level);
-
-    readHandle.readType(&m_release1Sec);
-    readHandle.readType(&m_release1Level);
-    readHandle.readType(&m_release2Sec);
-    readHandle.readType(&m_release2Level);
+    Layout::Read(*this, readHandle);
 }
 
 double E4Envelope::GetAttack1Sec() const
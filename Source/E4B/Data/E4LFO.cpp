@@ -1,29 +1,25 @@
 ﻿#include "Header/E4B/Data/E4LFO.h"
+#include "Header/E4B/Helpers/E4RecordLayout.h"
 #include "Header/E4B/Helpers/E4VoiceHelpers.h"
-#include "Header/IO/BinaryReader.h"
-#include "Header/IO/BinaryWriter.h"
+
+struct E4LFO::Layout final : E4RecordLayout<E4_LFO_DATA_SIZE,
+    E4Field<&E4LFO::m_rate, 0>, E4Field<&E4LFO::m_shape, 1>, E4Field<&E4LFO::m_delay, 2>, E4Field<&E4LFO::m_variation, 3>,
+    E4Field<&E4LFO::m_keySync, 4>, E4Field<&E4LFO::m_possibleRedundant1, 5>> {};
+
+// Bytes only and in file order, so E4Voice copies LFOs whole
+static_assert(sizeof(E4LFO) == E4_LFO_DATA_SIZE);
 
 E4LFO::E4LFO(const double rate, const uint8_t shape, const double delay, const bool keySync) : m_rate(E4VoiceHelpers::GetByteFromLFORate(rate)),
     m_shape(shape), m_delay(E4VoiceHelpers::GetByteFromLFODelay(delay)), m_keySync(!keySync) {}
 
 void E4LFO::write(BinaryWriter& writer) const
 {
-    writer.writeType(&m_rate);
-    writer.writeType(&m_shape);
-    writer.writeType(&m_delay);
-    writer.writeType(&m_variation);
-    writer.writeType(&m_keySync);
-    writer.writeType(m_possibleRedundant1.data(), sizeof(int8_t) * m_possibleRedundant1.size());
+    Layout::Write(*this, writer);
 }
 
 void E4LFO::readAtLocation(ReadLocationHandle& readHandle)
 {
-    readHandle.readType(&m_rate);
-    readHandle.readType(&m_shape);
-    readHandle.readType(&m_delay);
-    readHandle.readType(&m_variation);
-    readHandle.readType(&m_keySync);
-    readHandle.readType(m_possibleRedundant1.data(), sizeof(int8_t) * m_possibleRedundant1.size());
+    Layout::Read(*this, readHandle);
 }
 
 double E4LFO::GetRate() const
@@ -0,0 +1,11 @@
+#include "Header/E4B/Data/E4MultisampleMap.h"
+#include "Header/E4B/Helpers/E4RecordLayout.h"
+#include "Header/IO/E4BReader.h"
+
+struct E4MultisampleMap::Layout final : E4RecordLayout<MULTISAMPLE_MAP_DATA_READ_SIZE, E4Field<&E4MultisampleMap::m_mapIndex, 0>, E4Field<&E4MultisampleMap::m_name, 2>> {};
+
+E4MultisampleMap::E4MultisampleMap(const E4TOCChunk& chunk, BinaryReader& reader)
+{
+    ReadLocationHandle readHandle(reader, chunk.GetStartOffset() + sizeof(E4DataChunk));
+    Layout::Read(*this, readHandle);
+}
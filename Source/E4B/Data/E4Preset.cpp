@@ -1,9 +1,25 @@
 ﻿#include "Header/E4B/Data/E4Preset.h"
 #include "Header/Data/Soundbank.h"
 #include "Header/E4B/Helpers/E4BHelpers.h"
-#include "Header/IO/BinaryReader.h"
-#include "Header/IO/BinaryWriter.h"
+#include "Header/E4B/Helpers/E4RecordLayout.h"
 #include "Header/IO/E4BReader.h"
+#include <algorithm>
+
+struct E4Preset::Layout final : E4RecordLayout<PRESET_DATA_READ_SIZE,
+    E4Field<&E4Preset::m_index, 0>, E4Field<&E4Preset::m_name, 2>, E4Field<&E4Preset::m_dataSize, 18>,
+    E4Field<&E4Preset::m_numVoices, 20>, E4Field<&E4Preset::m_possibleRedundant1, 22>, E4Field<&E4Preset::m_transpose, 26>,
+    E4Field<&E4Preset::m_volume, 27>, E4Field<&E4Preset::m_possibleRedundant2, 28>, E4Field<&E4Preset::m_possibleRedundant3, 52>,
+    E4Field<&E4Preset::m_midiControllers, 56>, E4Field<&E4Preset::m_possibleRedundant4, 60>> {};
+
+namespace
+{
+    // A voice sounds only one of its zones for a key and velocity, so only zones that never overlap can share a voice
+    [[nodiscard]] bool AreZonesDisjoint(const BankVoice& a, const BankVoice& b)
+    {
+        return a.m_keyZone.m_high < b.m_keyZone.m_low || b.m_keyZone.m_high < a.m_keyZone.m_low
+            || a.m_velocityZone.m_high < b.m_velocityZone.m_low || b.m_velocityZone.m_high < a.m_velocityZone.m_low;
+    }
+}
 
 E4Preset::E4Preset(const E4TOCChunk& chunk, BinaryReader& reader)
 {
@@ -24,42 +40,85 @@ E4Preset::E4Preset(const E4TOCChunk& chunk, BinaryReader& reader)
     }
 }
 
-E4Preset::E4Preset(const BankPreset& preset) : m_index(_byteswap_ushort(preset.m_index)),
-    m_name(E4BHelpers::ConvertToE4Name(preset.m_presetName)), m_dataSize(_byteswap_ushort(TOTAL_PRESET_DATA_SIZE)),
-    m_numVoices(_byteswap_ushort(static_cast<uint16_t>(preset.m_voices.size()))),
-    m_voices(E4BHelpers::GetE4VoicesFromBankVoices(preset.m_voices)) {}
+E4Preset::E4Preset(const BankPreset& preset) : m_index(preset.m_index),
+    m_name(E4BHelpers::ConvertToE4Name(preset.m_presetName)), m_dataSize(static_cast<uint16_t>(TOTAL_PRESET_DATA_SIZE)),
+    m_bankVoices(preset.m_voices)
+{
+    // Bank voices that only differ in their ranges, sample and original key go back in as zones of one voice,
+    // which undoes the reader splitting each zone into its own bank voice. Layered bank voices (overlapping ranges) stay separate voices.
+    // Only the plan is kept, the voices are converted in write.
+    std::vector<std::array<char, VOICE_DATA_SIZE>> groupVoiceData{};
+    std::vector<size_t> groupNumZones{};
+    m_voiceGroups.reserve(m_bankVoices.size());
+    for (size_t voiceIndex(0); voiceIndex < m_bankVoices.size(); ++voiceIndex)
+    {
+        const auto& bankVoice(m_bankVoices[voiceIndex]);
+        const auto voiceData(E4Voice(bankVoice).GetSharedVoiceData());
+        const auto canJoinGroup([&](const size_t group)
+        {
+            if (groupVoiceData[group] != voiceData || groupNumZones[group] >= EOS_MAX_ZONES_PER_VOICE) { return false; }
+            for (size_t i(0); i < voiceIndex; ++i)
+            {
+                if (m_voiceGroups[i] == group && !AreZonesDisjoint(m_bankVoices[i], bankVoice)) { return false; }
+            }
+
+            return true;
+        });
+
+        size_t group(0);
+        while (group < groupVoiceData.size() && !canJoinGroup(group)) { ++group; }
+
+        if (group == groupVoiceData.size())
+        {
+            groupVoiceData.emplace_back(voiceData);
+            groupNumZones.emplace_back(0);
+        }
+
+        ++groupNumZones[group];
+        m_voiceGroups.emplace_back(static_cast<uint16_t>(group));
+    }
+
+    m_numVoices = static_cast<uint16_t>(groupVoiceData.size());
+}
 
 void E4Preset::write(BinaryWriter& writer) const
 {
-    writer.writeType(&m_index);
-    writer.writeType(m_name.data(), sizeof(char) * E4BVariables::EOS_E4_MAX_NAME_LEN);
-    writer.writeType(&m_dataSize);
-    writer.writeType(&m_numVoices);
-    writer.writeType(m_possibleRedundant1.data(), sizeof(int8_t) * m_possibleRedundant1.size());
-    writer.writeType(&m_transpose);
-    writer.writeType(&m_volume);
-    writer.writeType(m_possibleRedundant2.data(), sizeof(int8_t) * m_possibleRedundant2.size());
-    writer.writeType(m_possibleRedundant3.data(), sizeof(int8_t) * m_possibleRedundant3.size());
-    writer.writeType(m_midiControllers.data(), sizeof(uint8_t) * m_midiControllers.size());
-    writer.writeType(m_possibleRedundant4.data(), sizeof(uint8_t) * m_possibleRedundant4.size());
+    Layout::Write(*this, writer);
     
     for(const auto& voice : m_voices)
     {
         voice.write(writer);
     }
+
+    // Groups are numbered in the order they first appear, so each one starts at its first bank voice
+    for (uint16_t group(0ui16); group < GetNumVoices() && !m_bankVoices.empty(); ++group)
+    {
+        const auto firstVoice(static_cast<size_t>(std::ranges::find(m_voiceGroups, group) - m_voiceGroups.begin()));
+        E4Voice voice(m_bankVoices[firstVoice]);
+        for (size_t i(firstVoice + 1); i < m_bankVoices.size(); ++i)
+        {
+            if (m_voiceGroups[i] == group) { voice.AddZone(m_bankVoices[i]); }
+        }
+
+        voice.write(writer);
+    }
+}
+
+uint32_t E4Preset::GetTotalDataSize() const
+{
+    // Bank voices are not converted yet, each group is one voice record and each bank voice one zone record
+    uint32_t totalSize(TOTAL_PRESET_DATA_SIZE);
+    if (!m_bankVoices.empty()) { totalSize += static_cast<uint32_t>(GetNumVoices() * VOICE_DATA_SIZE + m_bankVoices.size() * ZONE_DATA_SIZE); }
+
+    for (const auto& voice : m_voices)
+    {
+        totalSize += voice.GetVoiceDataSize();
+    }
+
+    return totalSize;
 }
 
 void E4Preset::readAtLocation(ReadLocationHandle& readHandle)
 {
-    readHandle.readType(&m_index);
-    readHandle.readType(m_name.data(), sizeof(char) * E4BVariables::EOS_E4_MAX_NAME_LEN);
-    readHandle.readType(&m_dataSize);
-    readHandle.readType(&m_numVoices);
-    readHandle.readType(m_possibleRedundant1.data(), sizeof(int8_t) * m_possibleRedundant1.size());
-    readHandle.readType(&m_transpose);
-    readHandle.readType(&m_volume);
-    readHandle.readType(m_possibleRedundant2.data(), sizeof(int8_t) * m_possibleRedundant2.size());
-    readHandle.readType(m_possibleRedundant3.data(), sizeof(int8_t) * m_possibleRedundant3.size());
-    readHandle.readType(m_midiControllers.data(), sizeof(uint8_t) * m_midiControllers.size());
-    readHandle.readType(m_possibleRedundant4.data(), sizeof(uint8_t) * m_possibleRedundant4.size());
+    Layout::Read(*this, readHandle);
 }
\ No newline at end of file
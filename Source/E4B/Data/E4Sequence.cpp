@@ -1,9 +1,10 @@
 ﻿#include "Header/E4B/Data/E4Sequence.h"
 #include "Header/E4B/Helpers/E4BVariables.h"
-#include "Header/IO/BinaryReader.h"
-#include "Header/IO/BinaryWriter.h"
+#include "Header/E4B/Helpers/E4RecordLayout.h"
 #include "Header/IO/E4BReader.h"
 
+struct E4Sequence::Layout final : E4RecordLayout<SEQUENCE_DATA_READ_SIZE, E4Field<&E4Sequence::m_seqIndex, 0>, E4Field<&E4Sequence::m_name, 2>> {};
+
 E4Sequence::E4Sequence(const E4TOCChunk& chunk, BinaryReader& reader)
 {
     ReadLocationHandle readHandle(reader, chunk.GetStartOffset() + sizeof(E4DataChunk));
@@ -16,12 +17,10 @@ E4Sequence::E4Sequence(const E4TOCChunk& chunk, BinaryReader& reader)
 
 void E4Sequence::write(BinaryWriter& writer) const
 {
-    writer.writeType(&m_seqIndex);
-    writer.writeType(m_name.data(), sizeof(char) * E4BVariables::EOS_E4_MAX_NAME_LEN);
+    Layout::Write(*this, writer);
 }
 
 void E4Sequence::readAtLocation(ReadLocationHandle& readHandle)
 {
-    readHandle.readType(&m_seqIndex);
-    readHandle.readType(m_name.data(), sizeof(char) * E4BVariables::EOS_E4_MAX_NAME_LEN);
+    Layout::Read(*this, readHandle);
 }
\ No newline at end of file
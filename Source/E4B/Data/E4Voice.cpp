@@ -1,10 +1,27 @@
 ﻿#include "Header/E4B/Data/E4Voice.h"
 #include "Header/Data/Soundbank.h"
 #include "Header/E4B/Helpers/E4BHelpers.h"
+#include "Header/E4B/Helpers/E4RecordLayout.h"
 #include "Header/E4B/Helpers/E4VoiceHelpers.h"
-#include "Header/IO/BinaryReader.h"
-#include "Header/IO/BinaryWriter.h"
 #include "Header/IO/E4BReader.h"
+#include <algorithm>
+
+struct E4Voice::Layout final : E4RecordLayout<VOICE_DATA_SIZE,
+    E4Field<&E4Voice::m_totalVoiceSize, 0>, E4Field<&E4Voice::m_zoneCount, 2>, E4Field<&E4Voice::m_group, 3>, E4Field<&E4Voice::m_amplifierData, 4>,
+    E4Field<&E4Voice::m_keyData, 12>, E4Field<&E4Voice::m_velData, 16>, E4Field<&E4Voice::m_rtData, 20>,
+    E4Field<&E4Voice::m_possibleRedundant1, 24>, E4Field<&E4Voice::m_keyAssignGroup, 25>, E4Field<&E4Voice::m_keyDelay, 26>,
+    E4Field<&E4Voice::m_possibleRedundant2, 28>, E4Field<&E4Voice::m_sampleOffset, 31>,
+    E4Field<&E4Voice::m_transpose, 32>, E4Field<&E4Voice::m_coarseTune, 33>, E4Field<&E4Voice::m_fineTune, 34>, E4Field<&E4Voice::m_glideRate, 35>,
+    E4Field<&E4Voice::m_fixedPitch, 36>, E4Field<&E4Voice::m_keyMode, 37>, E4Field<&E4Voice::m_possibleRedundant3, 38>, E4Field<&E4Voice::m_chorusWidth, 39>,
+    E4Field<&E4Voice::m_chorusAmount, 40>, E4Field<&E4Voice::m_possibleRedundant4, 41>, E4Field<&E4Voice::m_keyLatch, 48>, E4Field<&E4Voice::m_possibleRedundant5, 49>,
+    E4Field<&E4Voice::m_glideCurve, 51>, E4Field<&E4Voice::m_volume, 52>, E4Field<&E4Voice::m_pan, 53>, E4Field<&E4Voice::m_possibleRedundant6, 54>,
+    E4Field<&E4Voice::m_ampEnvDynRange, 55>, E4Field<&E4Voice::m_filterType, 56>, E4Field<&E4Voice::m_possibleRedundant7, 57>,
+    E4Field<&E4Voice::m_filterFrequency, 58>, E4Field<&E4Voice::m_filterQ, 59>, E4Field<&E4Voice::m_possibleRedundant8, 60>,
+    E4Field<&E4Voice::m_ampEnv, 108>, E4Field<&E4Voice::m_possibleRedundant9, 120>, E4Field<&E4Voice::m_filterEnv, 122>, E4Field<&E4Voice::m_possibleRedundant10, 134>,
+    E4Field<&E4Voice::m_auxEnv, 136>, E4Field<&E4Voice::m_possibleRedundant11, 148>, E4Field<&E4Voice::m_lfo1, 150>, E4Field<&E4Voice::m_lfo2, 158>,
+    E4Field<&E4Voice::m_possibleRedundant12, 166>, E4Field<&E4Voice::m_cords, 188>> {};
+
+static_assert(VOICE_DATA_SIZE + ZONE_DATA_SIZE == VOICE_1_ZONE_DATA_SIZE);
 
 E4Voice::E4Voice(const E4TOCChunk& chunk, const uint16_t presetDataSize, const uint16_t voiceOffset, BinaryReader& reader)
 {
@@ -21,9 +38,9 @@ E4Voice::E4Voice(const E4TOCChunk& chunk, const uint16_t presetDataSize, const u
     }
 }
 
-E4Voice::E4Voice(const BankVoice& voice) : m_totalVoiceSize(_byteswap_ushort(VOICE_1_ZONE_DATA_SIZE)),
+E4Voice::E4Voice(const BankVoice& voice) : m_totalVoiceSize(static_cast<uint16_t>(VOICE_1_ZONE_DATA_SIZE)),
     m_keyData(E4BHelpers::GetE4ZoneNoteFromBankNoteRange(voice.m_keyZone)), m_velData(E4BHelpers::GetE4ZoneNoteFromBankNoteRange(voice.m_velocityZone)),
-    m_keyDelay(_byteswap_ushort(static_cast<uint16_t>(voice.m_ampEnv.m_delaySec * 1000.))), m_transpose(voice.m_transpose), m_coarseTune(voice.m_coarseTune),
+    m_keyDelay(static_cast<uint16_t>(voice.m_ampEnv.m_delaySec * 1000.)), m_transpose(voice.m_transpose), m_coarseTune(voice.m_coarseTune),
     m_fineTune(E4VoiceHelpers::ConvertFineTuneToByte(voice.m_fineTune)), m_chorusWidth(E4VoiceHelpers::ConvertChorusWidthToByte(voice.m_chorusWidth)),
     m_chorusAmount(E4VoiceHelpers::ConvertPercentToByteF(voice.m_chorusAmount)), m_volume(voice.m_volume), m_pan(voice.m_pan),
     m_filterFrequency(E4VoiceHelpers::ConvertFilterFrequencyToByte(voice.m_filterFrequency)), m_filterQ(E4VoiceHelpers::ConvertPercentToByteF(voice.m_filterQ)),
@@ -57,120 +74,53 @@ E4Voice::E4Voice(const BankVoice& voice) : m_totalVoiceSize(_byteswap_ushort(VOI
 
 void E4Voice::write(BinaryWriter& writer) const
 {
-    writer.writeType(&m_totalVoiceSize);
-    writer.writeType(&m_zoneCount);
-    writer.writeType(&m_group);
-    writer.writeType(m_amplifierData.data(), sizeof(int8_t) * m_amplifierData.size());
-    m_keyData.write(writer);
-    m_velData.write(writer);
-    m_rtData.write(writer);
-    writer.writeType(&m_possibleRedundant1);
-    writer.writeType(&m_keyAssignGroup);
-    writer.writeType(&m_keyDelay);
-    writer.writeType(m_possibleRedundant2.data(), sizeof(int8_t) * m_possibleRedundant2.size());
-    writer.writeType(&m_sampleOffset);
-    writer.writeType(&m_transpose);
-    writer.writeType(&m_coarseTune);
-    writer.writeType(&m_fineTune);
-    writer.writeType(&m_glideRate);
-    writer.writeType(&m_fixedPitch);
-    writer.writeType(&m_keyMode);
-    writer.writeType(&m_possibleRedundant3);
-    writer.writeType(&m_chorusWidth);
-    writer.writeType(&m_chorusAmount);
-    writer.writeType(m_possibleRedundant4.data(), sizeof(int8_t) * m_possibleRedundant4.size());
-    writer.writeType(&m_keyLatch);
-    writer.writeType(m_possibleRedundant5.data(), sizeof(int8_t) * m_possibleRedundant5.size());
-    writer.writeType(&m_glideCurve);
-    writer.writeType(&m_volume);
-    writer.writeType(&m_pan);
-    writer.writeType(&m_possibleRedundant6);
-    writer.writeType(&m_ampEnvDynRange);
-
-    const uint8_t filterType(static_cast<uint8_t>(m_filterType));
-    writer.writeType(&filterType);
-    
-    writer.writeType(&m_possibleRedundant7);
-    writer.writeType(&m_filterFrequency);
-    writer.writeType(&m_filterQ);
-    writer.writeType(m_possibleRedundant8.data(), sizeof(int8_t) * m_possibleRedundant8.size());
-    m_ampEnv.write(writer);
-    writer.writeType(m_possibleRedundant9.data(), sizeof(int8_t) * m_possibleRedundant9.size());
-    m_filterEnv.write(writer);
-    writer.writeType(m_possibleRedundant10.data(), sizeof(int8_t) * m_possibleRedundant10.size());
-    m_auxEnv.write(writer);
-    writer.writeType(m_possibleRedundant11.data(), sizeof(int8_t) * m_possibleRedundant11.size());
-    m_lfo1.write(writer);
-    m_lfo2.write(writer);
-    writer.writeType(m_possibleRedundant12.data(), sizeof(int8_t) * m_possibleRedundant12.size());
+    Layout::Write(*this, writer);
 
-    for(const auto& cord : m_cords)
+    assert(!m_zones.empty() && m_zones.size() == static_cast<size_t>(m_zoneCount));
+    for (const auto& zone : m_zones)
     {
-        cord.write(writer);
+        zone.write(writer);
     }
+}
+
+std::array<char, VOICE_DATA_SIZE> E4Voice::GetSharedVoiceData() const
+{
+    std::array<char, VOICE_DATA_SIZE> data{};
+    Layout::Encode(*this, data.data());
+
+    const auto clearField([&data]<typename Field>(Field) { std::fill_n(std::next(data.begin(), Field::OFFSET), Field::SIZE, '\0'); });
+    clearField(E4Field<&E4Voice::m_totalVoiceSize, 0>{});
+    clearField(E4Field<&E4Voice::m_zoneCount, 2>{});
+    clearField(E4Field<&E4Voice::m_keyData, 12>{});
+    clearField(E4Field<&E4Voice::m_velData, 16>{});
+    return data;
+}
+
+void E4Voice::AddZone(const BankVoice& voice)
+{
+    assert(!m_zones.empty() && m_zones.size() < EOS_MAX_ZONES_PER_VOICE);
 
-    // Only write 1 zone:
-    assert(!m_zones.empty());
-    if(!m_zones.empty())
+    // A single zone leaves its ranges to the voice, so the first zone takes them over once there are more
+    if (m_zones.size() == 1)
     {
-        m_zones[0].write(writer);
+        const auto& firstZone(m_zones[0]);
+        m_zones[0] = E4Zone(firstZone.GetSampleIndex(), firstZone.GetOriginalKey(), m_keyData, m_velData);
     }
+
+    const auto keyData(E4BHelpers::GetE4ZoneNoteFromBankNoteRange(voice.m_keyZone));
+    const auto velData(E4BHelpers::GetE4ZoneNoteFromBankNoteRange(voice.m_velocityZone));
+    m_zones.emplace_back(static_cast<uint16_t>(voice.m_sampleIndex + 1ui16), voice.m_originalKey, keyData, velData);
+
+    m_keyData = E4ZoneNoteData(std::min(m_keyData.GetLow(), keyData.GetLow()), std::max(m_keyData.GetHigh(), keyData.GetHigh()));
+    m_velData = E4ZoneNoteData(std::min(m_velData.GetLow(), velData.GetLow()), std::max(m_velData.GetHigh(), velData.GetHigh()));
+
+    m_zoneCount = static_cast<int8_t>(m_zones.size());
+    m_totalVoiceSize = static_cast<uint16_t>(m_totalVoiceSize + ZONE_DATA_SIZE);
 }
 
 void E4Voice::readAtLocation(ReadLocationHandle& readHandle)
 {
-    readHandle.readType(&m_totalVoiceSize);
-    readHandle.readType(&m_zoneCount);
-    readHandle.readType(&m_group);
-    readHandle.readType(m_amplifierData.data(), sizeof(int8_t) * m_amplifierData.size());
-    m_keyData.readAtLocation(readHandle);
-    m_velData.readAtLocation(readHandle);
-    m_rtData.readAtLocation(readHandle);
-    readHandle.readType(&m_possibleRedundant1);
-    readHandle.readType(&m_keyAssignGroup);
-    readHandle.readType(&m_keyDelay);
-    readHandle.readType(m_possibleRedundant2.data(), sizeof(int8_t) * m_possibleRedundant2.size());
-    readHandle.readType(&m_sampleOffset);
-    readHandle.readType(&m_transpose);
-    readHandle.readType(&m_coarseTune);
-    readHandle.readType(&m_fineTune);
-    readHandle.readType(&m_glideRate);
-    readHandle.readType(&m_fixedPitch);
-    readHandle.readType(&m_keyMode);
-    readHandle.readType(&m_possibleRedundant3);
-    readHandle.readType(&m_chorusWidth);
-    readHandle.readType(&m_chorusAmount);
-    readHandle.readType(m_possibleRedundant4.data(), sizeof(int8_t) * m_possibleRedundant4.size());
-    readHandle.readType(&m_keyLatch);
-    readHandle.readType(m_possibleRedundant5.data(), sizeof(int8_t) * m_possibleRedundant5.size());
-    readHandle.readType(&m_glideCurve);
-    readHandle.readType(&m_volume);
-    readHandle.readType(&m_pan);
-    readHandle.readType(&m_possibleRedundant6);
-    readHandle.readType(&m_ampEnvDynRange);
-
-    uint8_t filterType;
-    readHandle.readType(&filterType);
-    m_filterType = static_cast<EEOSFilterType>(filterType);
-    
-    readHandle.readType(&m_possibleRedundant7);
-    readHandle.readType(&m_filterFrequency);
-    readHandle.readType(&m_filterQ);
-    readHandle.readType(m_possibleRedundant8.data(), sizeof(int8_t) * m_possibleRedundant8.size());
-    m_ampEnv.readAtLocation(readHandle);
-    readHandle.readType(m_possibleRedundant9.data(), sizeof(int8_t) * m_possibleRedundant9.size());
-    m_filterEnv.readAtLocation(readHandle);
-    readHandle.readType(m_possibleRedundant10.data(), sizeof(int8_t) * m_possibleRedundant10.size());
-    m_auxEnv.readAtLocation(readHandle);
-    readHandle.readType(m_possibleRedundant11.data(), sizeof(int8_t) * m_possibleRedundant11.size());
-    m_lfo1.readAtLocation(readHandle);
-    m_lfo2.readAtLocation(readHandle);
-    readHandle.readType(m_possibleRedundant12.data(), sizeof(int8_t) * m_possibleRedundant12.size());
-
-    for(auto& cord : m_cords)
-    {
-        cord.readAtLocation(readHandle);
-    }
+    Layout::Read(*this, readHandle);
 }
 
 float E4Voice::GetChorusWidth() const
@@ -200,7 +150,7 @@ float E4Voice::GetFilterQ() const
 
 double E4Voice::GetKeyDelay() const
 {
-    return static_cast<double>(_byteswap_ushort(m_keyDelay)) / 1000.;
+    return static_cast<double>(m_keyDelay) / 1000.;
 }
 
 EEOSFilterType E4Voice::GetFilterType() const
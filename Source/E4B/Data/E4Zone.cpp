@@ -1,48 +1,36 @@
 ﻿#include "Header/E4B/Data/E4Zone.h"
+#include "Header/E4B/Helpers/E4RecordLayout.h"
 #include "Header/E4B/Helpers/E4VoiceHelpers.h"
-#include "Header/IO/BinaryReader.h"
-#include "Header/IO/BinaryWriter.h"
+
+struct E4ZoneNoteData::Layout final : E4RecordLayout<ZONE_NOTE_DATA_SIZE,
+    E4Field<&E4ZoneNoteData::m_low, 0>, E4Field<&E4ZoneNoteData::m_lowFade, 1>, E4Field<&E4ZoneNoteData::m_highFade, 2>, E4Field<&E4ZoneNoteData::m_high, 3>> {};
+
+// Bytes only and in file order, so zones and voices copy their ranges whole
+static_assert(sizeof(E4ZoneNoteData) == ZONE_NOTE_DATA_SIZE);
+
+struct E4Zone::Layout final : E4RecordLayout<ZONE_DATA_SIZE,
+    E4Field<&E4Zone::m_keyData, 0>, E4Field<&E4Zone::m_velData, 4>, E4Field<&E4Zone::m_sampleIndex, 8>,
+    E4Field<&E4Zone::m_possibleRedundant1, 10>, E4Field<&E4Zone::m_fineTune, 11>, E4Field<&E4Zone::m_originalKey, 12>,
+    E4Field<&E4Zone::m_volume, 13>, E4Field<&E4Zone::m_pan, 14>, E4Field<&E4Zone::m_possibleRedundant2, 15>> {};
 
 void E4ZoneNoteData::write(BinaryWriter& writer) const
 {
-    writer.writeType(&m_low);
-    writer.writeType(&m_lowFade);
-    writer.writeType(&m_highFade);
-    writer.writeType(&m_high);
+    Layout::Write(*this, writer);
 }
 
 void E4ZoneNoteData::readAtLocation(ReadLocationHandle& readHandle)
 {
-    readHandle.readType(&m_low);
-    readHandle.readType(&m_lowFade);
-    readHandle.readType(&m_highFade);
-    readHandle.readType(&m_high);
+    Layout::Read(*this, readHandle);
 }
 
 void E4Zone::write(BinaryWriter& writer) const
 {
-    m_keyData.write(writer);
-    m_velData.write(writer);
-    writer.writeType(&m_sampleIndex);
-    writer.writeType(&m_possibleRedundant1);
-    writer.writeType(&m_fineTune);
-    writer.writeType(&m_originalKey);
-    writer.writeType(&m_volume);
-    writer.writeType(&m_pan);
-    writer.writeType(m_possibleRedundant2.data(), m_possibleRedundant2.size());
+    Layout::Write(*this, writer);
 }
 
 void E4Zone::readAtLocation(ReadLocationHandle& readHandle)
 {
-    m_keyData.readAtLocation(readHandle);
-    m_velData.readAtLocation(readHandle);
-    readHandle.readType(&m_sampleIndex);
-    readHandle.readType(&m_possibleRedundant1);
-    readHandle.readType(&m_fineTune);
-    readHandle.readType(&m_originalKey);
-    readHandle.readType(&m_volume);
-    readHandle.readType(&m_pan);
-    readHandle.readType(m_possibleRedundant2.data(), m_possibleRedundant2.size());
+    Layout::Read(*this, readHandle);
 }
 
 double E4Zone::GetFineTune() const
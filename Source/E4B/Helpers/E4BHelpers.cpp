@@ -79,13 +79,6 @@ E4Cord E4BHelpers::GetE4CordFromBankRTControl(const BankRealtimeControl& control
         E4VoiceHelpers::ConvertPercentToByteF(control.m_amount));
 }
 
-std::vector<E4Voice> E4BHelpers::GetE4VoicesFromBankVoices(const std::vector<BankVoice>& voices)
-{
-    std::vector<E4Voice> outVoices{};
-    for(const auto& voice : voices) { outVoices.emplace_back(voice); }
-    return outVoices;
-}
-
 std::array<char, E4BVariables::EOS_E4_MAX_NAME_LEN> E4BHelpers::ConvertToE4Name(const std::string_view& name)
 {
     std::array<char, E4BVariables::EOS_E4_MAX_NAME_LEN> outName{};
@@ -0,0 +1,58 @@
+#include "Header/E4B/Helpers/E4Diagnostics.h"
+#include "Header/Logger.h"
+#include <algorithm>
+#include <format>
+
+void E4Diagnostics::Add(const EE4DiagnosticType type, const uint8_t src, const uint8_t dst, const std::string_view presetName, const uint64_t voiceIndex)
+{
+    const auto existingIssue(std::ranges::find_if(m_issues, [&](const E4DiagnosticIssue& issue)
+    {
+        return issue.m_type == type && issue.m_src == src && issue.m_dst == dst;
+    }));
+
+    if (existingIssue != m_issues.end())
+    {
+        ++existingIssue->m_count;
+        return;
+    }
+
+    // E4 names are fixed length, anything after a null is padding
+    m_issues.emplace_back(type, src, dst, 1u, std::string(presetName.substr(0, presetName.find('\0'))), voiceIndex);
+}
+
+void E4Diagnostics::AddUnknownChunk(const std::string_view chunkName)
+{
+    const auto existingChunk(std::ranges::find(m_unknownChunks, chunkName, &E4UnknownChunk::m_name));
+    if (existingChunk != m_unknownChunks.end())
+    {
+        ++existingChunk->m_count;
+        return;
+    }
+
+    m_unknownChunks.emplace_back(std::string(chunkName), 1u);
+}
+
+void E4Diagnostics::LogSummary(const std::string_view bankName) const
+{
+    if (m_issues.empty() && m_unknownChunks.empty()) { return; }
+
+    uint64_t totalCount(0u);
+    for (const auto& issue : m_issues) { totalCount += issue.m_count; }
+
+    std::string summary(std::format("'{}': {} conversion issue(s), {} distinct", bankName, totalCount, m_issues.size()));
+    for (const auto& chunk : m_unknownChunks) { summary += std::format("\n    Skipped unknown '{}' chunk x{}", chunk.m_name, chunk.m_count); }
+
+    for (size_t i(0); i < std::min(m_issues.size(), E4DiagnosticsStatics::MAX_SUMMARY_ISSUES); ++i)
+    {
+        const auto& issue(m_issues[i]);
+        summary += std::format("\n    {} (src: {}, dst: {}) x{}, first in preset '{}' voice {}", E4DiagnosticsStatics::TYPE_NAMES[static_cast<size_t>(issue.m_type)],
+            issue.m_src, issue.m_dst, issue.m_count, issue.m_firstPresetName, issue.m_firstVoiceIndex);
+    }
+
+    if (m_issues.size() > E4DiagnosticsStatics::MAX_SUMMARY_ISSUES)
+    {
+        summary += std::format("\n    ...and {} more", m_issues.size() - E4DiagnosticsStatics::MAX_SUMMARY_ISSUES);
+    }
+
+    Logger::LogMessage("%s", summary.c_str());
+}
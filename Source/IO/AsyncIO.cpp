@@ -0,0 +1,46 @@
+#include "Header/IO/AsyncIO.h"
+#include "Header/IO/ThreadedIOBackend.h"
+#include "Header/IO/UringIOBackend.h"
+#include "Header/Logger.h"
+#include <fstream>
+
+std::unique_ptr<AsyncIOBackend> AsyncIO::CreateBackend(const EAsyncIOBackendType type)
+{
+#if HAS_IO_URING
+    if (type != EAsyncIOBackendType::THREADED)
+    {
+        auto uringBackend(std::make_unique<UringIOBackend>(DEFAULT_QUEUE_DEPTH));
+        if (uringBackend->IsValid()) { return uringBackend; }
+
+        Logger::LogMessage("io_uring is unavailable, falling back to threaded I/O");
+    }
+#else
+    if (type == EAsyncIOBackendType::IO_URING)
+    {
+        Logger::LogMessage("io_uring is not supported on this platform, falling back to threaded I/O");
+    }
+#endif
+
+    return std::make_unique<ThreadedIOBackend>(DEFAULT_NUM_IO_THREADS);
+}
+
+bool AsyncIO::ReadWholeFile(const std::filesystem::path& file, BinaryBuffer& outData)
+{
+    std::ifstream ifs(file.c_str(), std::ios::binary);
+    if (ifs.peek() == std::ifstream::traits_type::eof()) { return false; }
+
+    ifs.seekg(0, std::ifstream::end);
+    const auto fileSize(static_cast<size_t>(ifs.tellg()));
+    ifs.seekg(0, std::ifstream::beg);
+
+    outData = BufferPool::GetSharedPool().Acquire(fileSize);
+    ifs.read(outData.data(), static_cast<std::streamsize>(outData.size()));
+    return ifs.good();
+}
+
+bool AsyncIO::WriteWholeFile(const std::filesystem::path& file, const BinaryBuffer& data)
+{
+    std::ofstream ofs(file.c_str(), std::ios::binary | std::ios::trunc);
+    ofs.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return ofs.good();
+}
@@ -0,0 +1,310 @@
+#include "Header/IO/BankSnapshot.h"
+#include "Header/IO/AsyncIO.h"
+#include "Header/IO/MappedFile.h"
+#include "Header/Logger.h"
+#include "Header/Profiler.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr uint64_t AlignUp(const uint64_t value, const uint64_t alignment)
+    {
+        return (value + alignment - 1u) / alignment * alignment;
+    }
+
+    SnapshotEnvelope ToSnapshotEnvelope(const ADSR_Envelope& envelope)
+    {
+        return {envelope.m_attackSec, envelope.m_decaySec, envelope.m_delaySec, envelope.m_holdSec, envelope.m_releaseSec, envelope.m_sustainDB};
+    }
+
+    ADSR_Envelope FromSnapshotEnvelope(const SnapshotEnvelope& envelope)
+    {
+        return ADSR_Envelope(envelope.m_attackSec, envelope.m_decaySec, envelope.m_holdSec, envelope.m_sustainDB, envelope.m_releaseSec, envelope.m_delaySec);
+    }
+
+    SnapshotVoice ToSnapshotVoice(const BankVoice& voice)
+    {
+        SnapshotVoice outVoice{};
+        for (size_t i(0); i < MAX_REALTIME_CONTROLS; ++i)
+        {
+            const auto& rtControl(voice.m_realtimeControls[i]);
+            outVoice.m_realtimeControls[i] = {static_cast<uint8_t>(rtControl.m_src), static_cast<uint8_t>(rtControl.m_dst), 0ui16, rtControl.m_amount};
+        }
+
+        outVoice.m_ampEnv = ToSnapshotEnvelope(voice.m_ampEnv);
+        outVoice.m_filterEnv = ToSnapshotEnvelope(voice.m_filterEnv);
+        outVoice.m_lfoRate = voice.m_lfo1.m_rate;
+        outVoice.m_lfoDelay = voice.m_lfo1.m_delay;
+        outVoice.m_fineTune = voice.m_fineTune;
+        outVoice.m_filterQ = voice.m_filterQ;
+        outVoice.m_chorusAmount = voice.m_chorusAmount;
+        outVoice.m_chorusWidth = voice.m_chorusWidth;
+        outVoice.m_filterFrequency = voice.m_filterFrequency;
+        outVoice.m_sampleIndex = voice.m_sampleIndex;
+        outVoice.m_lfoShape = voice.m_lfo1.m_shape;
+        outVoice.m_lfoKeySync = voice.m_lfo1.m_keySync ? 1ui8 : 0ui8;
+        outVoice.m_keyLow = voice.m_keyZone.m_low;
+        outVoice.m_keyHigh = voice.m_keyZone.m_high;
+        outVoice.m_velocityLow = voice.m_velocityZone.m_low;
+        outVoice.m_velocityHigh = voice.m_velocityZone.m_high;
+        outVoice.m_originalKey = voice.m_originalKey;
+        outVoice.m_transpose = voice.m_transpose;
+        outVoice.m_coarseTune = voice.m_coarseTune;
+        outVoice.m_volume = voice.m_volume;
+        outVoice.m_pan = voice.m_pan;
+        return outVoice;
+    }
+
+    BankVoice FromSnapshotVoice(const SnapshotVoice& voice)
+    {
+        BankVoice outVoice{};
+        for (size_t i(0); i < MAX_REALTIME_CONTROLS; ++i)
+        {
+            const auto& rtControl(voice.m_realtimeControls[i]);
+            outVoice.m_realtimeControls[i] = BankRealtimeControl(static_cast<ERealtimeControlSrc>(rtControl.m_src),
+                static_cast<ERealtimeControlDst>(rtControl.m_dst), rtControl.m_amount);
+        }
+
+        outVoice.m_lfo1 = BankLFO(voice.m_lfoRate, voice.m_lfoShape, voice.m_lfoDelay, voice.m_lfoKeySync != 0ui8);
+        outVoice.m_ampEnv = FromSnapshotEnvelope(voice.m_ampEnv);
+        outVoice.m_filterEnv = FromSnapshotEnvelope(voice.m_filterEnv);
+        outVoice.m_keyZone = BankNoteRange(voice.m_keyLow, voice.m_keyHigh);
+        outVoice.m_velocityZone = BankNoteRange(voice.m_velocityLow, voice.m_velocityHigh);
+        outVoice.m_fineTune = voice.m_fineTune;
+        outVoice.m_filterQ = voice.m_filterQ;
+        outVoice.m_chorusAmount = voice.m_chorusAmount;
+        outVoice.m_chorusWidth = voice.m_chorusWidth;
+        outVoice.m_filterFrequency = voice.m_filterFrequency;
+        outVoice.m_transpose = voice.m_transpose;
+        outVoice.m_coarseTune = voice.m_coarseTune;
+        outVoice.m_volume = voice.m_volume;
+        outVoice.m_pan = voice.m_pan;
+        outVoice.m_originalKey = voice.m_originalKey;
+        outVoice.m_sampleIndex = voice.m_sampleIndex;
+        return outVoice;
+    }
+
+    template<typename T>
+    bool IsTableInRange(const uint64_t offset, const uint32_t count, const size_t size)
+    {
+        return offset % alignof(T) == 0u && offset <= size && static_cast<uint64_t>(count) * sizeof(T) <= size - offset;
+    }
+
+    bool IsRangeInFile(const uint64_t offset, const uint64_t length, const size_t size)
+    {
+        return offset <= size && length <= size - offset;
+    }
+}
+
+bool BankSnapshotView::Open(const char* data, const size_t size)
+{
+    m_data = nullptr;
+    m_size = 0;
+
+    // Records are read in place, so the buffer has to be aligned like them (maps and heap buffers always are)
+    if (data == nullptr || size < sizeof(SnapshotHeader) || reinterpret_cast<uintptr_t>(data) % alignof(SnapshotHeader) != 0u) { return false; }
+
+    const auto& header(*reinterpret_cast<const SnapshotHeader*>(data));
+    if (header.m_magic != BankSnapshotStatics::MAGIC || header.m_version != BankSnapshotStatics::VERSION || header.m_headerSize != sizeof(SnapshotHeader)
+        || header.m_fileSize != size) { return false; }
+
+    if (!IsTableInRange<SnapshotPreset>(header.m_presetsOffset, header.m_numPresets, size) || !IsTableInRange<SnapshotVoice>(header.m_voicesOffset, header.m_numVoices, size)
+        || !IsTableInRange<SnapshotSample>(header.m_samplesOffset, header.m_numSamples, size)
+        || !IsTableInRange<SnapshotSequence>(header.m_sequencesOffset, header.m_numSequences, size)
+        || !IsRangeInFile(header.m_stringsOffset, header.m_stringsSize, size)) { return false; }
+
+    m_data = data;
+    m_size = size;
+
+    const auto isStringValid([&header](const SnapshotString& str)
+    {
+        return str.m_offset <= header.m_stringsSize && str.m_length <= header.m_stringsSize - str.m_offset;
+    });
+
+    bool isValid(isStringValid(header.m_bankName));
+    for (const auto& preset : GetPresets())
+    {
+        isValid &= isStringValid(preset.m_name) && static_cast<uint64_t>(preset.m_firstVoice) + preset.m_numVoices <= header.m_numVoices;
+    }
+
+    for (const auto& voice : GetVoices())
+    {
+        isValid &= std::ranges::all_of(voice.m_realtimeControls, [](const SnapshotRealtimeControl& rtControl)
+        {
+            return rtControl.m_src <= static_cast<uint8_t>(ERealtimeControlSrc::LFO1_POLARITY_CENTER)
+                && rtControl.m_dst <= static_cast<uint8_t>(ERealtimeControlDst::FILTER_ENV_ATTACK);
+        });
+    }
+
+    for (const auto& sample : GetSamples())
+    {
+        isValid &= isStringValid(sample.m_name) && sample.m_dataOffset % alignof(int16_t) == 0u && sample.m_numValues <= size / sizeof(int16_t)
+            && IsRangeInFile(sample.m_dataOffset, sample.m_numValues * sizeof(int16_t), size);
+    }
+
+    for (const auto& sequence : GetSequences())
+    {
+        isValid &= isStringValid(sequence.m_name) && IsRangeInFile(sequence.m_dataOffset, sequence.m_size, size);
+    }
+
+    if (!isValid)
+    {
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    return isValid;
+}
+
+BinaryBuffer BankSnapshot::Encode(const Soundbank& bank)
+{
+    using namespace BankSnapshotStatics;
+    const Profiler::StageScope encodeScope(EProfileStage::SNAPSHOT_ENCODE);
+
+    std::string strings;
+    const auto addString([&strings](const std::string_view& str)
+    {
+        const SnapshotString outString{static_cast<uint32_t>(strings.length()), static_cast<uint32_t>(str.length())};
+        strings += str;
+        return outString;
+    });
+
+    SnapshotHeader header{MAGIC, VERSION, static_cast<uint32_t>(sizeof(SnapshotHeader))};
+    header.m_bankName = addString(bank.m_bankName);
+    header.m_defaultPreset = bank.m_defaultPreset;
+    header.m_numPresets = static_cast<uint32_t>(bank.m_presets.size());
+    header.m_numSamples = static_cast<uint32_t>(bank.m_samples.size());
+    header.m_numSequences = static_cast<uint32_t>(bank.m_sequences.size());
+
+    std::vector<SnapshotPreset> presets{};
+    std::vector<SnapshotVoice> voices{};
+    presets.reserve(bank.m_presets.size());
+    for (const auto& preset : bank.m_presets)
+    {
+        presets.emplace_back(addString(preset.m_presetName), static_cast<uint32_t>(voices.size()), static_cast<uint32_t>(preset.m_voices.size()), preset.m_index);
+        for (const auto& voice : preset.m_voices) { voices.emplace_back(ToSnapshotVoice(voice)); }
+    }
+
+    header.m_numVoices = static_cast<uint32_t>(voices.size());
+    header.m_presetsOffset = AlignUp(sizeof(SnapshotHeader), SECTION_ALIGNMENT);
+    header.m_voicesOffset = AlignUp(header.m_presetsOffset + presets.size() * sizeof(SnapshotPreset), SECTION_ALIGNMENT);
+    header.m_samplesOffset = AlignUp(header.m_voicesOffset + voices.size() * sizeof(SnapshotVoice), SECTION_ALIGNMENT);
+    header.m_sequencesOffset = AlignUp(header.m_samplesOffset + bank.m_samples.size() * sizeof(SnapshotSample), SECTION_ALIGNMENT);
+
+    // Names go into the pool before its size is known, the data offsets come after it
+    std::vector<SnapshotSample> samples{};
+    samples.reserve(bank.m_samples.size());
+    for (const auto& sample : bank.m_samples)
+    {
+        samples.emplace_back(addString(sample.m_sampleName), 0u, sample.m_sampleData.size(), sample.m_sampleRate, sample.m_loopStart, sample.m_loopEnd,
+            sample.m_channels, sample.m_index, sample.m_isLooping ? 1ui8 : 0ui8, sample.m_isLoopReleasing ? 1ui8 : 0ui8);
+    }
+
+    std::vector<SnapshotSequence> sequences{};
+    sequences.reserve(bank.m_sequences.size());
+    for (const auto& sequence : bank.m_sequences)
+    {
+        sequences.emplace_back(addString(sequence.m_sequenceName), 0u, sequence.m_midiData.size(), sequence.m_index);
+    }
+
+    header.m_stringsOffset = AlignUp(header.m_sequencesOffset + sequences.size() * sizeof(SnapshotSequence), SECTION_ALIGNMENT);
+    header.m_stringsSize = strings.length();
+    header.m_dataOffset = AlignUp(header.m_stringsOffset + strings.length(), SECTION_ALIGNMENT);
+
+    uint64_t dataEnd(header.m_dataOffset);
+    for (auto& sample : samples)
+    {
+        sample.m_dataOffset = AlignUp(dataEnd, SAMPLE_ALIGNMENT);
+        dataEnd = sample.m_dataOffset + sample.m_numValues * sizeof(int16_t);
+    }
+
+    for (auto& sequence : sequences)
+    {
+        sequence.m_dataOffset = dataEnd;
+        dataEnd += sequence.m_size;
+    }
+
+    header.m_fileSize = dataEnd;
+
+    // Pooled buffers are not zero-filled, the padding is cleared so the same bank always gives the same bytes
+    auto outData(BufferPool::GetSharedPool().Acquire(static_cast<size_t>(header.m_fileSize)));
+    std::memset(outData.data(), 0, outData.size());
+
+    const auto writeTable([&outData](const uint64_t offset, const auto& table)
+    {
+        if (!table.empty()) { std::memcpy(&outData[offset], table.data(), table.size() * sizeof(table[0])); }
+    });
+
+    std::memcpy(outData.data(), &header, sizeof(SnapshotHeader));
+    writeTable(header.m_presetsOffset, presets);
+    writeTable(header.m_voicesOffset, voices);
+    writeTable(header.m_samplesOffset, samples);
+    writeTable(header.m_sequencesOffset, sequences);
+    writeTable(header.m_stringsOffset, strings);
+
+    for (size_t i(0); i < samples.size(); ++i) { writeTable(samples[i].m_dataOffset, bank.m_samples[i].m_sampleData); }
+    for (size_t i(0); i < sequences.size(); ++i) { writeTable(sequences[i].m_dataOffset, bank.m_sequences[i].m_midiData); }
+
+    return outData;
+}
+
+bool BankSnapshot::Save(const Soundbank& bank, const std::filesystem::path& file)
+{
+    return AsyncIO::WriteWholeFile(file, Encode(bank));
+}
+
+Soundbank BankSnapshot::Decode(const BankSnapshotView& view)
+{
+    const Profiler::StageScope decodeScope(EProfileStage::SNAPSHOT_DECODE);
+
+    const auto& header(view.GetHeader());
+    Soundbank outBank{std::string(view.GetString(header.m_bankName))};
+    outBank.m_defaultPreset = header.m_defaultPreset;
+
+    const auto voices(view.GetVoices());
+    outBank.m_presets.reserve(header.m_numPresets);
+    for (const auto& preset : view.GetPresets())
+    {
+        std::vector<BankVoice> presetVoices{};
+        presetVoices.reserve(preset.m_numVoices);
+        for (const auto& voice : voices.subspan(preset.m_firstVoice, preset.m_numVoices)) { presetVoices.emplace_back(FromSnapshotVoice(voice)); }
+
+        outBank.m_presets.emplace_back(preset.m_index, std::string(view.GetString(preset.m_name)), std::move(presetVoices));
+    }
+
+    outBank.m_samples.reserve(header.m_numSamples);
+    for (const auto& sample : view.GetSamples())
+    {
+        const auto sampleData(view.GetSampleData(sample));
+        outBank.m_samples.emplace_back(sample.m_index, std::string(view.GetString(sample.m_name)), std::vector(sampleData.begin(), sampleData.end()),
+            sample.m_sampleRate, sample.m_channels, sample.m_isLooping != 0ui8, sample.m_isLoopReleasing != 0ui8, sample.m_loopStart, sample.m_loopEnd);
+    }
+
+    outBank.m_sequences.reserve(header.m_numSequences);
+    for (const auto& sequence : view.GetSequences())
+    {
+        const auto midiData(view.GetSequenceData(sequence));
+        outBank.m_sequences.emplace_back(sequence.m_index, std::string(view.GetString(sequence.m_name)), std::vector(midiData.begin(), midiData.end()));
+    }
+
+    return outBank;
+}
+
+Soundbank BankSnapshot::Load(const std::filesystem::path& file)
+{
+    MappedFile mappedFile;
+    BankSnapshotView view;
+    if (!mappedFile.Open(file) || !view.Open(mappedFile.GetData(), mappedFile.GetSize()))
+    {
+        Logger::LogMessage("'%s' is not a valid bank snapshot (version %u)", file.filename().string().c_str(), BankSnapshotStatics::VERSION);
+        return Soundbank(std::string());
+    }
+
+    return Decode(view);
+}
+
+bool BankSnapshot::IsSnapshot(const char* data, const size_t size)
+{
+    return size >= BankSnapshotStatics::MAGIC.size() && std::equal(BankSnapshotStatics::MAGIC.begin(), BankSnapshotStatics::MAGIC.end(), data);
+}
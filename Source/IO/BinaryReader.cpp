@@ -4,14 +4,37 @@
 bool BinaryReader::readFile(const std::filesystem::path& file)
 {
 	m_filePath = file;
+	m_readData = nullptr;
+	m_readLocation = 0;
 
 	std::ifstream ifs(file.c_str(), std::ios::binary);
 	if (ifs.peek() == std::ifstream::traits_type::eof()) { return false; }
 
 	ifs.seekg(0, std::ifstream::end);
-	m_readDataVector.resize(ifs.tellg());
+	const auto fileSize(static_cast<size_t>(ifs.tellg()));
+
+	// Reuse a pooled buffer, the whole file is read over it so there is no need to zero-fill
+	auto& bufferPool(BufferPool::GetSharedPool());
+	bufferPool.Release(std::move(m_readDataVector));
+	m_readDataVector = bufferPool.Acquire(fileSize);
 	ifs.seekg(0, std::ifstream::beg);
 	ifs.read(m_readDataVector.data(), static_cast<std::streamsize>(m_readDataVector.size()));
 	m_readData = m_readDataVector.data();
 	return true;
+}
+
+bool BinaryReader::readData(BinaryBuffer&& data, const std::filesystem::path& file)
+{
+	m_filePath = file;
+	m_readLocation = 0;
+
+	BufferPool::GetSharedPool().Release(std::move(m_readDataVector));
+	m_readDataVector = std::move(data);
+	m_readData = m_readDataVector.empty() ? nullptr : m_readDataVector.data();
+	return m_readData != nullptr;
+}
+
+BinaryReader::~BinaryReader()
+{
+	BufferPool::GetSharedPool().Release(std::move(m_readDataVector));
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "Header/IO/BinaryWriter.h"
+#include "Header/Profiler.h"
+#include <algorithm>
 #include <fstream>
 
 bool BinaryWriter::finishWriting()
@@ -22,7 +24,53 @@ bool BinaryWriter::finishWriting()
 	return false;
 }
 
+BinaryBuffer BinaryWriter::TakeData()
+{
+	m_writeDataVector.resize(m_bytesWritten);
+	m_writeData = nullptr;
+	m_bytesWritten = 0;
+	return std::move(m_writeDataVector);
+}
+
+void BinaryWriter::Reserve(const size_t totalSize)
+{
+	if (m_writeDataVector.size() >= totalSize) { return; }
+
+	if (m_writeDataVector.capacity() < totalSize)
+	{
+		Profiler::AddCounter(EProfileCounter::BUFFER_ALLOCATIONS, 1u);
+		Profiler::AddCounter(EProfileCounter::BUFFER_ALLOCATED_BYTES, totalSize);
+	}
+
+	m_writeDataVector.resize(totalSize);
+	m_writeData = m_writeDataVector.data();
+	m_writeData += m_bytesWritten;
+}
+
+BinaryWriter::~BinaryWriter()
+{
+	BufferPool::GetSharedPool().Release(std::move(m_writeDataVector));
+}
+
 bool BinaryWriter::CanFitWrite(const size_t dataSize) const
 {
 	return m_writeDataVector.size() - m_bytesWritten >= dataSize;
+}
+
+void BinaryWriter::EnsureCanFitWrite(const size_t dataSize)
+{
+	if (!CanFitWrite(dataSize))
+	{
+		// Grow geometrically, resizing a pooled buffer does not zero-fill
+		const size_t newSize(std::max(m_bytesWritten + dataSize, m_writeDataVector.size() * 2));
+		if (m_writeDataVector.capacity() < newSize)
+		{
+			Profiler::AddCounter(EProfileCounter::BUFFER_ALLOCATIONS, 1u);
+			Profiler::AddCounter(EProfileCounter::BUFFER_ALLOCATED_BYTES, newSize);
+		}
+
+		m_writeDataVector.resize(newSize);
+		m_writeData = m_writeDataVector.data();
+		m_writeData += m_bytesWritten;
+	}
 }
\ No newline at end of file
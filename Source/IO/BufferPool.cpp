@@ -0,0 +1,169 @@
+#include "Header/IO/BufferPool.h"
+#include "Header/MemoryBudget.h"
+#include "Header/Profiler.h"
+#include <algorithm>
+
+BinaryBuffer BufferPool::Acquire(const size_t size)
+{
+    BinaryBuffer outBuffer{};
+    {
+        std::lock_guard lock(m_mutex);
+        m_highWaterMark = std::max(m_highWaterMark, size);
+        TickTrim();
+
+        if(!m_buffers.empty())
+        {
+            // Prefer the smallest buffer that fits, otherwise grow the largest one we have
+            auto bestFit(m_buffers.end());
+            for(auto it(m_buffers.begin()); it != m_buffers.end(); ++it)
+            {
+                if(it->capacity() >= size && (bestFit == m_buffers.end() || it->capacity() < bestFit->capacity()))
+                {
+                    bestFit = it;
+                }
+            }
+
+            if(bestFit == m_buffers.end())
+            {
+                bestFit = std::ranges::max_element(m_buffers, {}, &BinaryBuffer::capacity);
+            }
+
+            // From here the buffer is part of whatever the caller reserved
+            UntrackBytes(bestFit->capacity());
+            outBuffer = std::move(*bestFit);
+            m_buffers.erase(bestFit);
+        }
+    }
+
+    if(outBuffer.capacity() < size)
+    {
+        Profiler::AddCounter(EProfileCounter::BUFFER_ALLOCATIONS, 1u);
+        Profiler::AddCounter(EProfileCounter::BUFFER_ALLOCATED_BYTES, size);
+    }
+
+    outBuffer.resize(size);
+    return outBuffer;
+}
+
+void BufferPool::Release(BinaryBuffer&& buffer)
+{
+    if(buffer.capacity() == 0) { return; }
+
+    std::lock_guard lock(m_mutex);
+
+    // Writers grow past what they acquired, so count the size that was actually used
+    m_highWaterMark = std::max(m_highWaterMark, buffer.size());
+    buffer.clear();
+
+    // A batch that only releases (e.g. readers fed by the I/O threads) still trims
+    TickTrim();
+
+    const size_t capacity(buffer.capacity());
+    if(capacity > BufferPoolStatics::MAX_POOLED_BYTES) { return; }
+
+    // Make room by dropping smaller buffers, the incoming buffer is dropped instead if only larger ones are left
+    std::ranges::sort(m_buffers, {}, &BinaryBuffer::capacity);
+    while(!m_buffers.empty() && (m_buffers.size() >= BufferPoolStatics::MAX_POOLED_BUFFERS || m_pooledBytes + capacity > BufferPoolStatics::MAX_POOLED_BYTES))
+    {
+        if(m_buffers.front().capacity() >= capacity) { return; }
+
+        UntrackBytes(m_buffers.front().capacity());
+        m_buffers.erase(m_buffers.begin());
+    }
+
+    if(m_memoryBudget != nullptr && !m_memoryBudget->TryAcquireSpare(capacity)) { return; }
+
+    m_pooledBytes += capacity;
+    m_buffers.emplace_back(std::move(buffer));
+}
+
+void BufferPool::Trim()
+{
+    std::lock_guard lock(m_mutex);
+    TrimBuffers();
+}
+
+void BufferPool::SetMemoryBudget(MemoryBudget* memoryBudget)
+{
+    std::lock_guard lock(m_mutex);
+    if(memoryBudget == m_memoryBudget) { return; }
+
+    if(m_memoryBudget != nullptr) { m_memoryBudget->ReleaseSpare(m_pooledBytes); }
+    m_memoryBudget = memoryBudget;
+
+    // Whatever the new budget has no room for is freed
+    if(m_memoryBudget != nullptr)
+    {
+        std::erase_if(m_buffers, [this](const BinaryBuffer& buffer)
+        {
+            if(m_memoryBudget->TryAcquireSpare(buffer.capacity())) { return false; }
+
+            m_pooledBytes -= buffer.capacity();
+            return true;
+        });
+    }
+}
+
+void BufferPool::Reclaim(const size_t numBytes)
+{
+    if(numBytes == 0) { return; }
+
+    std::lock_guard lock(m_mutex);
+    std::ranges::sort(m_buffers, {}, &BinaryBuffer::capacity);
+
+    size_t reclaimedBytes(0);
+    while(reclaimedBytes < numBytes && !m_buffers.empty())
+    {
+        reclaimedBytes += m_buffers.back().capacity();
+        UntrackBytes(m_buffers.back().capacity());
+        m_buffers.pop_back();
+    }
+}
+
+size_t BufferPool::GetNumPooledBuffers() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_buffers.size();
+}
+
+size_t BufferPool::GetPooledBytes() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_pooledBytes;
+}
+
+void BufferPool::TrimBuffers()
+{
+    const size_t trimSize(std::max(m_highWaterMark, m_prevHighWaterMark));
+    std::erase_if(m_buffers, [this, trimSize](const BinaryBuffer& buffer)
+    {
+        if(buffer.capacity() <= trimSize) { return false; }
+
+        UntrackBytes(buffer.capacity());
+        return true;
+    });
+
+    m_prevHighWaterMark = m_highWaterMark;
+    m_highWaterMark = 0;
+    m_callsSinceTrim = 0u;
+}
+
+void BufferPool::TickTrim()
+{
+    if(++m_callsSinceTrim >= BufferPoolStatics::TRIM_INTERVAL)
+    {
+        TrimBuffers();
+    }
+}
+
+void BufferPool::UntrackBytes(const size_t numBytes)
+{
+    m_pooledBytes -= numBytes;
+    if(m_memoryBudget != nullptr) { m_memoryBudget->ReleaseSpare(numBytes); }
+}
+
+BufferPool& BufferPool::GetSharedPool()
+{
+    static BufferPool pool;
+    return pool;
+}
@@ -1,91 +1,211 @@
 ﻿#include "Header/IO/E4BReader.h"
 #include "Header/IO/BinaryReader.h"
-#include "Header/Logger.h"
-#include "Header/MathFunctions.h"
 #include "Header/Data/Soundbank.h"
 #include "Header/E4B/Data/E4Preset.h"
 #include "Header/E4B/Data/E3Sample.h"
+#include "Header/E4B/Data/E4MultisampleMap.h"
 #include "Header/E4B/Data/E4Sequence.h"
 #include "Header/E4B/Data/EMSt.h"
+#include "Header/E4B/Helpers/E4Diagnostics.h"
+#include "Header/E4B/Helpers/E4RecordLayout.h"
 #include "Header/E4B/Helpers/E4VoiceHelpers.h"
 #include "Header/IO/BinaryWriter.h"
+#include "Header/Profiler.h"
+#include <algorithm>
+#include <bitset>
+#include <fstream>
+
+struct E4TOCChunk::Layout final : E4RecordLayout<E4BVariables::EOS_CHUNK_SIZE + sizeof(uint32_t),
+    E4Field<&E4TOCChunk::m_chunkName, 0>, E4Field<&E4TOCChunk::m_chunkLength, 4>, E4Field<&E4TOCChunk::m_chunkStartOffset, 8>> {};
+
+struct E4DataChunk::Layout final : E4RecordLayout<E4BVariables::EOS_CHUNK_SIZE, E4Field<&E4DataChunk::m_chunkName, 0>, E4Field<&E4DataChunk::m_chunkLength, 4>> {};
+
+// Chunk offsets are worked out with sizeof, so the in-memory size has to match the file
+static_assert(sizeof(E4TOCChunk) == E4BVariables::EOS_CHUNK_SIZE + sizeof(uint32_t) && sizeof(E4DataChunk) == E4BVariables::EOS_CHUNK_SIZE);
 
 E4TOCChunk::E4TOCChunk(std::array<char, E4BVariables::EOS_CHUNK_NAME_LEN>&& name, const uint32_t length, const uint32_t startOffset)
-    : m_chunkName(std::move(name)), m_chunkLength(MathFunctions::byteswapUINT32(length)), m_chunkStartOffset(MathFunctions::byteswapUINT32(startOffset)) {}
+    : m_chunkName(std::move(name)), m_chunkLength(length), m_chunkStartOffset(startOffset) {}
 
 void E4TOCChunk::write(BinaryWriter& writer) const
 {
-    writer.writeType(m_chunkName.data(), sizeof(char) * m_chunkName.size());
-    writer.writeType(&m_chunkLength);
-    writer.writeType(&m_chunkStartOffset);
+    Layout::Write(*this, writer);
 }
 
 void E4TOCChunk::read(BinaryReader& reader)
 {
-    reader.readType(m_chunkName.data(), sizeof(char) * E4BVariables::EOS_CHUNK_NAME_LEN);
-    reader.readType(&m_chunkLength);
-    reader.readType(&m_chunkStartOffset);
-}
-
-uint32_t E4TOCChunk::GetLength() const
-{
-    return MathFunctions::byteswapUINT32(m_chunkLength);
-}
-
-uint32_t E4TOCChunk::GetStartOffset() const
-{
-    return MathFunctions::byteswapUINT32(m_chunkStartOffset);
+    Layout::Read(*this, reader);
 }
 
 E4DataChunk::E4DataChunk(std::array<char, E4BVariables::EOS_CHUNK_NAME_LEN>&& name, const uint32_t length)
-    : m_chunkName(std::move(name)), m_chunkLength(MathFunctions::byteswapUINT32(length)) {}
+    : m_chunkName(std::move(name)), m_chunkLength(length) {}
 
 void E4DataChunk::write(BinaryWriter& writer) const
 {
-    writer.writeType(m_chunkName.data(), sizeof(char) * m_chunkName.size());
-    writer.writeType(&m_chunkLength);
+    Layout::Write(*this, writer);
 }
 
 void E4DataChunk::read(BinaryReader& reader)
 {
-    reader.readType(m_chunkName.data(), sizeof(char) * E4BVariables::EOS_CHUNK_NAME_LEN);
-    reader.readType(&m_chunkLength);
+    Layout::Read(*this, reader);
 }
 
 void E4DataChunk::readAtLocation(ReadLocationHandle& readHandle)
 {
-    readHandle.readType(m_chunkName.data(), sizeof(char) * E4BVariables::EOS_CHUNK_NAME_LEN);
-    readHandle.readType(&m_chunkLength);
+    Layout::Read(*this, readHandle);
 }
 
-uint32_t E4DataChunk::GetLength() const
+namespace
 {
-    return MathFunctions::byteswapUINT32(m_chunkLength);
+    struct E4ChunkHandler final
+    {
+        uint32_t m_fourCC = 0u;
+        void (*m_read)(const E4TOCChunk& chunk, BinaryReader& reader, Soundbank& outBank, E4Diagnostics& diagnostics) = nullptr;
+    };
+
+    void ReadPresetChunk(const E4TOCChunk& chunk, BinaryReader& reader, Soundbank& outBank, E4Diagnostics& diagnostics)
+    {
+        const Profiler::StageScope voiceDecodeScope(EProfileStage::E4B_VOICE_DECODE);
+        E4Preset preset(chunk, reader);
+
+        std::vector<BankVoice> voices;
+        for(size_t voiceIndex(0); voiceIndex < preset.GetVoices().size(); ++voiceIndex)
+        {
+            const auto& voice(preset.GetVoices()[voiceIndex]);
+            E4BReader::VerifyRealtimeCordsAccounted(preset, voice, voiceIndex, diagnostics);
+            for(const auto& zone : voice.GetZones())
+            {
+                voices.emplace_back(E4BReader::GetBankVoiceFromE4Zone(voice, zone));
+            }
+        }
+        
+        outBank.m_presets.emplace_back(preset.GetIndex(), std::string(preset.GetName()), std::move(voices));
+    }
+
+    void ReadSampleChunk(const E4TOCChunk& chunk, BinaryReader& reader, Soundbank& outBank, E4Diagnostics&)
+    {
+        E3Sample sample(chunk, reader);
+
+        auto& sampleData(sample.GetData());
+        Profiler::AddCounter(EProfileCounter::SAMPLES_PROCESSED, sampleData.size());
+        outBank.m_samples.emplace_back(sample.GetIndex(), std::string(sample.GetName()), std::move(sampleData),
+            sample.GetSampleRate(), sample.GetNumChannels(), sample.IsLooping(), sample.IsLoopReleasing(), sample.GetLoopStart(),
+            sample.GetLoopEnd());
+    }
+
+    void ReadMultisampleMapChunk(const E4TOCChunk& chunk, BinaryReader& reader, Soundbank& outBank, E4Diagnostics&)
+    {
+        const E4MultisampleMap map(chunk, reader);
+        outBank.m_multisampleMaps.emplace_back(map.GetIndex(), std::string(map.GetName()));
+    }
+
+    void ReadSequenceChunk(const E4TOCChunk& chunk, BinaryReader& reader, Soundbank& outBank, E4Diagnostics&)
+    {
+        E4Sequence sequence(chunk, reader);
+        outBank.m_sequences.emplace_back(sequence.GetIndex(), std::string(sequence.GetName()), std::move(sequence.GetData()));
+    }
+
+    // TOC entries are matched on their tag as one integer, anything not listed here is reported as unknown.
+    // Only the index and name of an E4Ma (multisample map) are read, the layout of the map itself is not known.
+    constexpr std::array E4_CHUNK_HANDLERS{
+        E4ChunkHandler{E4BVariables::EOS_E4_PRESET_FOURCC, &ReadPresetChunk}, E4ChunkHandler{E4BVariables::EOS_E3_SAMPLE_FOURCC, &ReadSampleChunk},
+        E4ChunkHandler{E4BVariables::EOS_E4Ma_FOURCC, &ReadMultisampleMapChunk}, E4ChunkHandler{E4BVariables::EOS_E4_SEQ_FOURCC, &ReadSequenceChunk}};
+
+    constexpr size_t NUM_CORD_VALUES = 256;
+
+    [[nodiscard]] constexpr size_t GetCordPairIndex(const EEOSCordSource src, const EEOSCordDest dst)
+    {
+        return static_cast<size_t>(src) * NUM_CORD_VALUES + static_cast<size_t>(dst);
+    }
+
+    // Cord sources and destinations the conversion knows, anything else converts to off and is reported
+    constexpr std::array<std::pair<EEOSCordSource, ERealtimeControlSrc>, 15> CORD_SOURCE_CONVERSIONS{{
+        {EEOSCordSource::SRC_OFF, ERealtimeControlSrc::SRC_OFF}, {EEOSCordSource::MIDI_A, ERealtimeControlSrc::MIDI_A},
+        {EEOSCordSource::MIDI_B, ERealtimeControlSrc::MIDI_B}, {EEOSCordSource::PEDAL, ERealtimeControlSrc::PEDAL},
+        {EEOSCordSource::PRESSURE, ERealtimeControlSrc::PRESSURE}, {EEOSCordSource::MOD_WHEEL, ERealtimeControlSrc::MOD_WHEEL},
+        {EEOSCordSource::FOOTSWITCH_1, ERealtimeControlSrc::FOOTSWITCH_1}, {EEOSCordSource::PITCH_WHEEL, ERealtimeControlSrc::PITCH_WHEEL},
+        {EEOSCordSource::KEY_POLARITY_POS, ERealtimeControlSrc::KEY_POLARITY_POS}, {EEOSCordSource::KEY_POLARITY_CENTER, ERealtimeControlSrc::KEY_POLARITY_CENTER},
+        {EEOSCordSource::VEL_POLARITY_POS, ERealtimeControlSrc::VEL_POLARITY_POS}, {EEOSCordSource::VEL_POLARITY_LESS, ERealtimeControlSrc::VEL_POLARITY_LESS},
+        {EEOSCordSource::VEL_POLARITY_CENTER, ERealtimeControlSrc::VEL_POLARITY_CENTER}, {EEOSCordSource::LFO1_POLARITY_CENTER, ERealtimeControlSrc::LFO1_POLARITY_CENTER},
+        {EEOSCordSource::FILTER_ENV_POLARITY_POS, ERealtimeControlSrc::FILTER_ENV_POLARITY_POS}}};
+
+    constexpr std::array<std::pair<EEOSCordDest, ERealtimeControlDst>, 10> CORD_DEST_CONVERSIONS{{
+        {EEOSCordDest::DST_OFF, ERealtimeControlDst::DST_OFF}, {EEOSCordDest::PITCH, ERealtimeControlDst::PITCH},
+        {EEOSCordDest::AMP_PAN, ERealtimeControlDst::AMP_PAN}, {EEOSCordDest::AMP_VOLUME, ERealtimeControlDst::AMP_VOLUME},
+        {EEOSCordDest::AMP_ENV_ATTACK, ERealtimeControlDst::AMP_ENV_ATTACK}, {EEOSCordDest::FILTER_ENV_ATTACK, ERealtimeControlDst::FILTER_ENV_ATTACK},
+        {EEOSCordDest::FILTER_FREQ, ERealtimeControlDst::FILTER_FREQ}, {EEOSCordDest::FILTER_RES, ERealtimeControlDst::FILTER_RES},
+        {EEOSCordDest::CORD_3_AMT, ERealtimeControlDst::VIBRATO}, {EEOSCordDest::KEY_SUSTAIN, ERealtimeControlDst::KEY_SUSTAIN}}};
+
+    template<typename T, size_t N>
+    [[nodiscard]] constexpr std::bitset<NUM_CORD_VALUES> GetKnownCordValues(const std::array<T, N>& conversions)
+    {
+        std::bitset<NUM_CORD_VALUES> values{};
+        for (const auto& [e4Value, bankValue] : conversions) { values.set(static_cast<size_t>(e4Value)); }
+        return values;
+    }
+
+    constexpr std::bitset<NUM_CORD_VALUES> KNOWN_CORD_SOURCES(GetKnownCordValues(CORD_SOURCE_CONVERSIONS));
+    constexpr std::bitset<NUM_CORD_VALUES> KNOWN_CORD_DESTS(GetKnownCordValues(CORD_DEST_CONVERSIONS));
+
+    // Cords that are converted to realtime controls, or are fine to drop, indexed by GetCordPairIndex
+    constexpr std::bitset<NUM_CORD_VALUES * NUM_CORD_VALUES> ACCOUNTED_CORDS([]
+    {
+        constexpr std::array<std::pair<EEOSCordSource, EEOSCordDest>, 21> accountedCords{{
+            {EEOSCordSource::LFO1_POLARITY_CENTER, EEOSCordDest::AMP_VOLUME}, {EEOSCordSource::LFO1_POLARITY_CENTER, EEOSCordDest::PITCH},
+            {EEOSCordSource::LFO1_POLARITY_CENTER, EEOSCordDest::FILTER_FREQ}, {EEOSCordSource::LFO1_POLARITY_CENTER, EEOSCordDest::AMP_PAN},
+            {EEOSCordSource::FILTER_ENV_POLARITY_POS, EEOSCordDest::FILTER_FREQ}, {EEOSCordSource::PITCH_WHEEL, EEOSCordDest::PITCH},
+            {EEOSCordSource::MIDI_A, EEOSCordDest::AMP_VOLUME}, {EEOSCordSource::VEL_POLARITY_POS, EEOSCordDest::FILTER_RES},
+            {EEOSCordSource::VEL_POLARITY_LESS, EEOSCordDest::AMP_VOLUME}, {EEOSCordSource::VEL_POLARITY_LESS, EEOSCordDest::FILTER_ENV_ATTACK},
+            {EEOSCordSource::VEL_POLARITY_LESS, EEOSCordDest::FILTER_FREQ}, {EEOSCordSource::VEL_POLARITY_CENTER, EEOSCordDest::AMP_PAN},
+            {EEOSCordSource::KEY_POLARITY_CENTER, EEOSCordDest::FILTER_FREQ}, {EEOSCordSource::MOD_WHEEL, EEOSCordDest::FILTER_FREQ},
+            {EEOSCordSource::MOD_WHEEL, EEOSCordDest::CORD_3_AMT}, {EEOSCordSource::PRESSURE, EEOSCordDest::AMP_ENV_ATTACK},
+            {EEOSCordSource::PEDAL, EEOSCordDest::AMP_VOLUME},
+
+            // Skipping these:
+            {EEOSCordSource::SRC_OFF, EEOSCordDest::CORD_3_AMT}, // This means controlling vibrato is OFF.
+            {EEOSCordSource::SRC_OFF, EEOSCordDest::PITCH}, // This means the pitch wheel is OFF.
+            {EEOSCordSource::FOOTSWITCH_1, EEOSCordDest::KEY_SUSTAIN}, // Emax II specific
+            {EEOSCordSource::SRC_OFF, EEOSCordDest::DST_OFF}}};
+
+        std::bitset<NUM_CORD_VALUES * NUM_CORD_VALUES> cords{};
+        for (const auto& [src, dst] : accountedCords) { cords.set(GetCordPairIndex(src, dst)); }
+
+        return cords;
+    }());
 }
 
 Soundbank E4BReader::ProcessFile(const std::filesystem::path& file)
+{
+    BinaryReader reader;
+    if(reader.readFile(file)) { return ProcessFile(reader, file); }
+
+    return Soundbank(file.filename().replace_extension("").string());
+}
+
+Soundbank E4BReader::ProcessFile(BinaryReader& reader, const std::filesystem::path& file)
 {
     Soundbank outResult(file.filename().replace_extension("").string());
+    E4Diagnostics diagnostics;
     
-    BinaryReader reader;
-    if(reader.readFile(file))
+    if(!reader.GetData().empty())
     {
+        const Profiler::StageScope tocParseScope(EProfileStage::E4B_TOC_PARSE);
+
         E4DataChunk FORMChunk;
         FORMChunk.read(reader);
 
-        if (std::strncmp(FORMChunk.GetName().data(), E4BVariables::EOS_FORM_TAG.data(), E4BVariables::EOS_FORM_TAG.length()) != 0) { return outResult; }
+        if (FORMChunk.GetFourCC() != E4BVariables::EOS_FORM_FOURCC) { return outResult; }
 
         if(FORMChunk.GetLength() > 0u)
         {
             std::array<char, E4BVariables::EOS_CHUNK_NAME_LEN> E4B0Chunk{};
             reader.readType(E4B0Chunk.data(), sizeof(char) * E4BVariables::EOS_CHUNK_NAME_LEN);
 
-            if (std::strncmp(E4B0Chunk.data(), E4BVariables::EOS_E4_FORMAT_TAG.data(), E4BVariables::EOS_E4_FORMAT_TAG.length()) != 0) { return outResult; }
+            if (E4BVariables::MakeFourCC({E4B0Chunk.data(), E4B0Chunk.size()}) != E4BVariables::EOS_E4_FORMAT_FOURCC) { return outResult; }
 
             E4DataChunk TOC1Chunk;
             TOC1Chunk.read(reader);
 
-            if (std::strncmp(TOC1Chunk.GetName().data(), E4BVariables::EOS_TOC_TAG.data(), E4BVariables::EOS_TOC_TAG.length()) != 0) { return outResult; }
+            if (TOC1Chunk.GetFourCC() != E4BVariables::EOS_TOC_FOURCC) { return outResult; }
 
             if(TOC1Chunk.GetLength() > 0u)
             {
@@ -97,75 +217,18 @@ Soundbank E4BReader::ProcessFile(const std::filesystem::path& file)
                     E4TOCChunk currentChunk;
                     currentChunk.read(reader);
 
-                    if (std::strncmp(currentChunk.GetName().data(), E4BVariables::EOS_E4_PRESET_TAG.data(), E4BVariables::EOS_E4_PRESET_TAG.length()) == 0)
+                    const auto handlerIt(std::ranges::find(E4_CHUNK_HANDLERS, currentChunk.GetFourCC(), &E4ChunkHandler::m_fourCC));
+                    if (handlerIt == E4_CHUNK_HANDLERS.end())
                     {
-                        E4Preset preset(currentChunk, reader);
-
-                        std::vector<BankVoice> voices;
-                        for(const auto& voice : preset.GetVoices())
-                        {
-                            VerifyRealtimeCordsAccounted(preset, voice, voices.size() - 1);
-                            for(const auto& zone : voice.GetZones())
-                            {
-                                voices.emplace_back(GetBankVoiceFromE4Zone(voice, zone));   
-                            }
-                        }
-                        
-                        outResult.m_presets.emplace_back(preset.GetIndex(), std::string(preset.GetName()), std::move(voices));
-
-                        // Finished reading, skip rest of TOC chunk.
-                        reader.skipBytes(E4BVariables::EOS_CHUNK_TOTAL_LEN - sizeof(E4TOCChunk));
-
-                        tocChunkLengths += currentChunk.GetLength() + sizeof(uint16_t);
-                    }
-                    else
-                    {
-                        if (std::strncmp(currentChunk.GetName().data(), E4BVariables::EOS_E3_SAMPLE_TAG.data(), E4BVariables::EOS_E3_SAMPLE_TAG.length()) == 0)
-                        {
-                            E3Sample sample(currentChunk, reader);
-
-                            auto& sampleData(sample.GetData());
-                            outResult.m_samples.emplace_back(sample.GetIndex(), std::string(sample.GetName()), std::move(sampleData),
-                                sample.GetSampleRate(), sample.GetNumChannels(), sample.IsLooping(), sample.IsLoopReleasing(), sample.GetLoopStart(),
-                                sample.GetLoopEnd());
-                            
-                            // Finished reading, skip rest of TOC chunk.
-                            reader.skipBytes(E4BVariables::EOS_CHUNK_TOTAL_LEN - sizeof(E4TOCChunk));
-
-                            tocChunkLengths += currentChunk.GetLength() + sizeof(uint16_t);
-                        }
-                        else
-                        {
-                            if (std::strncmp(currentChunk.GetName().data(), E4BVariables::EOS_E4Ma_TAG.data(), E4BVariables::EOS_E4Ma_TAG.length()) == 0)
-                            {
-                                // Skip E4Ma
-                                reader.skipBytes(E4BVariables::EOS_CHUNK_TOTAL_LEN - sizeof(E4TOCChunk));
-
-                                tocChunkLengths += currentChunk.GetLength() + sizeof(uint16_t);
-                            }
-                            else
-                            {
-                                if (std::strncmp(currentChunk.GetName().data(), E4BVariables::EOS_E4_SEQ_TAG.data(), E4BVariables::EOS_E4_SEQ_TAG.length()) == 0)
-                                {
-                                    E4Sequence sequence(currentChunk, reader);
-
-                                    auto& midiData(sequence.GetData());
-                                    outResult.m_sequences.emplace_back(sequence.GetIndex(), std::string(sequence.GetName()), std::move(midiData));
-                                    
-                                    // Finished reading, skip rest of TOC chunk.
-                                    reader.skipBytes(E4BVariables::EOS_CHUNK_TOTAL_LEN - sizeof(E4TOCChunk));
-                                    
-                                    tocChunkLengths += currentChunk.GetLength() + sizeof(uint16_t);
-                                }
-                                else
-                                {
-                                    // Not supposed to reach here.
-                                    assert(false);
-                                    return outResult;
-                                }
-                            }
-                        }
+                        // Later EOS versions add chunks, the data is found through the TOC so an unknown chunk is just passed over
+                        diagnostics.AddUnknownChunk(currentChunk.GetName());
                     }
+                    else { handlerIt->m_read(currentChunk, reader, outResult, diagnostics); }
+
+                    // Finished reading, skip rest of TOC chunk.
+                    reader.skipBytes(E4BVariables::EOS_CHUNK_TOTAL_LEN - sizeof(E4TOCChunk));
+
+                    tocChunkLengths += currentChunk.GetLength() + sizeof(uint16_t);
                 }
 
                 assert(tocChunkLengths > 0u);
@@ -181,7 +244,7 @@ Soundbank E4BReader::ProcessFile(const std::filesystem::path& file)
 						E4DataChunk EMStChunk;
 						EMStChunk.readAtLocation(readHandle);
 
-						if (std::strncmp(EMStChunk.GetName().data(), E4BVariables::EOS_EMSt_TAG.data(), E4BVariables::EOS_EMSt_TAG.length()) == 0)
+						if (EMStChunk.GetFourCC() == E4BVariables::EOS_EMSt_FOURCC)
 						{
 							E4EMSt emst;
 							emst.readAtLocation(readHandle);
@@ -199,11 +262,79 @@ Soundbank E4BReader::ProcessFile(const std::filesystem::path& file)
         }
     }
 
+    diagnostics.LogSummary(outResult.m_bankName);
     return outResult;
 }
 
+bool E4BReader::ReadSequences(const std::filesystem::path& file, std::vector<BankSequence>& outSequences)
+{
+    std::ifstream ifs(file, std::ios::binary);
+    if (!ifs.is_open()) { return false; }
+
+    auto& bufferPool(BufferPool::GetSharedPool());
+    const auto readChunk([&](const uint64_t offset, const size_t size, BinaryReader& outReader)
+    {
+        auto data(bufferPool.Acquire(size));
+        ifs.seekg(static_cast<std::streamoff>(offset), std::ifstream::beg);
+        ifs.read(data.data(), static_cast<std::streamsize>(size));
+        if (!ifs.good())
+        {
+            bufferPool.Release(std::move(data));
+            return false;
+        }
+
+        return outReader.readData(std::move(data), file);
+    });
+
+    // FORM, E4B0 and the TOC1 header
+    BinaryReader headerReader;
+    if (!readChunk(0u, sizeof(E4DataChunk) * 2 + E4BVariables::EOS_CHUNK_NAME_LEN, headerReader)) { return false; }
+
+    E4DataChunk FORMChunk;
+    FORMChunk.read(headerReader);
+    if (FORMChunk.GetFourCC() != E4BVariables::EOS_FORM_FOURCC) { return false; }
+
+    std::array<char, E4BVariables::EOS_CHUNK_NAME_LEN> E4B0Chunk{};
+    headerReader.readType(E4B0Chunk.data(), sizeof(char) * E4BVariables::EOS_CHUNK_NAME_LEN);
+    if (E4BVariables::MakeFourCC({E4B0Chunk.data(), E4B0Chunk.size()}) != E4BVariables::EOS_E4_FORMAT_FOURCC) { return false; }
+
+    E4DataChunk TOC1Chunk;
+    TOC1Chunk.read(headerReader);
+    if (TOC1Chunk.GetFourCC() != E4BVariables::EOS_TOC_FOURCC) { return false; }
+
+    const uint64_t numTOCChunks(TOC1Chunk.GetLength() / E4BVariables::EOS_CHUNK_TOTAL_LEN);
+    if (numTOCChunks == 0u) { return true; }
+
+    BinaryReader tocReader;
+    if (!readChunk(headerReader.GetData().size(), numTOCChunks * E4BVariables::EOS_CHUNK_TOTAL_LEN, tocReader)) { return false; }
+
+    for (uint64_t i(0u); i < numTOCChunks; ++i)
+    {
+        E4TOCChunk currentChunk;
+        currentChunk.read(tocReader);
+        tocReader.skipBytes(E4BVariables::EOS_CHUNK_TOTAL_LEN - sizeof(E4TOCChunk));
+
+        if (currentChunk.GetFourCC() != E4BVariables::EOS_E4_SEQ_FOURCC) { continue; }
+        if (currentChunk.GetLength() + sizeof(uint16_t) < SEQUENCE_DATA_READ_SIZE) { return false; }
+
+        // The chunk is read on its own, so it is parsed as if it started the file
+        BinaryReader sequenceReader;
+        if (!readChunk(currentChunk.GetStartOffset(), sizeof(E4DataChunk) + currentChunk.GetLength() + sizeof(uint16_t), sequenceReader)) { return false; }
+
+        std::array<char, E4BVariables::EOS_CHUNK_NAME_LEN> chunkName{};
+        std::ranges::copy(currentChunk.GetName(), chunkName.begin());
+
+        E4Sequence sequence(E4TOCChunk(std::move(chunkName), currentChunk.GetLength(), 0u), sequenceReader);
+        outSequences.emplace_back(sequence.GetIndex(), std::string(sequence.GetName()), std::move(sequence.GetData()));
+    }
+
+    return true;
+}
+
 BankVoice E4BReader::GetBankVoiceFromE4Zone(const E4Voice& e4Voice, const E4Zone& e4Zone)
 {
+    const Profiler::StageScope zoneToVoiceScope(EProfileStage::E4B_ZONE_TO_VOICE);
+
     BankVoice outVoice;
     outVoice.m_volume = e4Voice.GetVolume();
     outVoice.m_pan = e4Voice.GetPan();
@@ -262,57 +393,16 @@ BankRealtimeControl E4BReader::GetBankRTControlsFromE4Cord(const E4Cord& cord)
 
 ERealtimeControlSrc E4BReader::GetBankRTControlSrcFromE4CordSrc(const EEOSCordSource src)
 {
-    switch(src)
-    {
-        default:
-        {
-            // Shouldn't ever hit this..
-            //assert(false);
-            Logger::LogMessage("Cord source was unaccounted for!");
-            return ERealtimeControlSrc::SRC_OFF;
-        }
-
-        case EEOSCordSource::SRC_OFF: { return ERealtimeControlSrc::SRC_OFF; }
-        case EEOSCordSource::MIDI_A: { return ERealtimeControlSrc::MIDI_A; }
-        case EEOSCordSource::MIDI_B: { return ERealtimeControlSrc::MIDI_B; }
-        case EEOSCordSource::PEDAL: { return ERealtimeControlSrc::PEDAL; }
-        case EEOSCordSource::PRESSURE: { return ERealtimeControlSrc::PRESSURE; }
-        case EEOSCordSource::MOD_WHEEL: { return ERealtimeControlSrc::MOD_WHEEL; }
-        case EEOSCordSource::FOOTSWITCH_1: { return ERealtimeControlSrc::FOOTSWITCH_1; }
-        case EEOSCordSource::PITCH_WHEEL: { return ERealtimeControlSrc::PITCH_WHEEL; }
-        case EEOSCordSource::KEY_POLARITY_POS: { return ERealtimeControlSrc::KEY_POLARITY_POS; }
-        case EEOSCordSource::KEY_POLARITY_CENTER: { return ERealtimeControlSrc::KEY_POLARITY_CENTER; }
-        case EEOSCordSource::VEL_POLARITY_POS: { return ERealtimeControlSrc::VEL_POLARITY_POS; }
-        case EEOSCordSource::VEL_POLARITY_LESS: { return ERealtimeControlSrc::VEL_POLARITY_LESS; }
-        case EEOSCordSource::VEL_POLARITY_CENTER: { return ERealtimeControlSrc::VEL_POLARITY_CENTER; }
-        case EEOSCordSource::LFO1_POLARITY_CENTER: { return ERealtimeControlSrc::LFO1_POLARITY_CENTER; }
-        case EEOSCordSource::FILTER_ENV_POLARITY_POS: { return ERealtimeControlSrc::FILTER_ENV_POLARITY_POS; }
-    }
+    // Unknown sources are reported once per bank through VerifyRealtimeCordsAccounted
+    const auto conversion(std::ranges::find(CORD_SOURCE_CONVERSIONS, src, &std::pair<EEOSCordSource, ERealtimeControlSrc>::first));
+    return conversion != CORD_SOURCE_CONVERSIONS.end() ? conversion->second : ERealtimeControlSrc::SRC_OFF;
 }
 
 ERealtimeControlDst E4BReader::GetBankRTControlDstFromE4CordDst(const EEOSCordDest dst)
 {
-    switch(dst)
-    {
-        default:
-        {
-            // Shouldn't ever hit this..
-            //assert(false);
-            Logger::LogMessage("Cord destination was unaccounted for!");
-            return ERealtimeControlDst::DST_OFF;
-        }
-
-        case EEOSCordDest::DST_OFF: { return ERealtimeControlDst::DST_OFF; }
-        case EEOSCordDest::PITCH: { return ERealtimeControlDst::PITCH; }
-        case EEOSCordDest::AMP_PAN: { return ERealtimeControlDst::AMP_PAN; }
-        case EEOSCordDest::AMP_VOLUME: { return ERealtimeControlDst::AMP_VOLUME; }
-        case EEOSCordDest::AMP_ENV_ATTACK: { return ERealtimeControlDst::AMP_ENV_ATTACK; }
-        case EEOSCordDest::FILTER_ENV_ATTACK: { return ERealtimeControlDst::FILTER_ENV_ATTACK; }
-        case EEOSCordDest::FILTER_FREQ: { return ERealtimeControlDst::FILTER_FREQ; }
-        case EEOSCordDest::FILTER_RES: { return ERealtimeControlDst::FILTER_RES; }
-        case EEOSCordDest::CORD_3_AMT: { return ERealtimeControlDst::VIBRATO; }
-        case EEOSCordDest::KEY_SUSTAIN: { return ERealtimeControlDst::KEY_SUSTAIN; }
-    }
+    // Unknown destinations are reported once per bank through VerifyRealtimeCordsAccounted
+    const auto conversion(std::ranges::find(CORD_DEST_CONVERSIONS, dst, &std::pair<EEOSCordDest, ERealtimeControlDst>::first));
+    return conversion != CORD_DEST_CONVERSIONS.end() ? conversion->second : ERealtimeControlDst::DST_OFF;
 }
 
 std::array<BankRealtimeControl, MAX_REALTIME_CONTROLS> E4BReader::GetBankRTControlsFromE4Voice(const E4Voice& voice)
@@ -329,35 +419,17 @@ std::array<BankRealtimeControl, MAX_REALTIME_CONTROLS> E4BReader::GetBankRTContr
     return outRTControls;
 }
 
-void E4BReader::VerifyRealtimeCordsAccounted(const E4Preset& e4Preset, const E4Voice& e4Voice, const uint64_t voiceIndex)
+void E4BReader::VerifyRealtimeCordsAccounted(const E4Preset& e4Preset, const E4Voice& e4Voice, const uint64_t voiceIndex, E4Diagnostics& diagnostics)
 {
     for (const auto& cord : e4Voice.GetCords())
     {
-        if (cord.GetSource() == EEOSCordSource::LFO1_POLARITY_CENTER && cord.GetDest() == EEOSCordDest::AMP_VOLUME) { continue; }
-        if (cord.GetSource() == EEOSCordSource::LFO1_POLARITY_CENTER && cord.GetDest() == EEOSCordDest::PITCH) { continue; }
-        if (cord.GetSource() == EEOSCordSource::LFO1_POLARITY_CENTER && cord.GetDest() == EEOSCordDest::FILTER_FREQ) { continue; }
-        if (cord.GetSource() == EEOSCordSource::LFO1_POLARITY_CENTER && cord.GetDest() == EEOSCordDest::AMP_PAN) { continue; }
-        if (cord.GetSource() == EEOSCordSource::FILTER_ENV_POLARITY_POS && cord.GetDest() == EEOSCordDest::FILTER_FREQ) { continue; }
-        if (cord.GetSource() == EEOSCordSource::PITCH_WHEEL && cord.GetDest() == EEOSCordDest::PITCH) { continue; }
-        if (cord.GetSource() == EEOSCordSource::MIDI_A && cord.GetDest() == EEOSCordDest::AMP_VOLUME) { continue; }
-        if (cord.GetSource() == EEOSCordSource::VEL_POLARITY_POS && cord.GetDest() == EEOSCordDest::FILTER_RES) { continue; }
-        if (cord.GetSource() == EEOSCordSource::VEL_POLARITY_LESS && cord.GetDest() == EEOSCordDest::AMP_VOLUME) { continue; }
-        if (cord.GetSource() == EEOSCordSource::VEL_POLARITY_LESS && cord.GetDest() == EEOSCordDest::FILTER_ENV_ATTACK) { continue; }
-        if (cord.GetSource() == EEOSCordSource::VEL_POLARITY_LESS && cord.GetDest() == EEOSCordDest::FILTER_FREQ) { continue; }
-        if (cord.GetSource() == EEOSCordSource::VEL_POLARITY_CENTER && cord.GetDest() == EEOSCordDest::AMP_PAN) { continue; }
-        if (cord.GetSource() == EEOSCordSource::KEY_POLARITY_CENTER && cord.GetDest() == EEOSCordDest::FILTER_FREQ) { continue; }
-        if (cord.GetSource() == EEOSCordSource::MOD_WHEEL && cord.GetDest() == EEOSCordDest::FILTER_FREQ) { continue; }
-        if (cord.GetSource() == EEOSCordSource::MOD_WHEEL && cord.GetDest() == EEOSCordDest::CORD_3_AMT) { continue; }
-        if (cord.GetSource() == EEOSCordSource::PRESSURE && cord.GetDest() == EEOSCordDest::AMP_ENV_ATTACK) { continue; }
-        if (cord.GetSource() == EEOSCordSource::PEDAL && cord.GetDest() == EEOSCordDest::AMP_VOLUME) { continue; }
-
-        // Skipping these:
-        if (cord.GetSource() == EEOSCordSource::SRC_OFF && cord.GetDest() == EEOSCordDest::CORD_3_AMT) { continue; } // This means controlling vibrato is OFF.
-        if (cord.GetSource() == EEOSCordSource::SRC_OFF && cord.GetDest() == EEOSCordDest::PITCH) { continue; } // This means the pitch wheel is OFF.
-        if (cord.GetSource() == EEOSCordSource::FOOTSWITCH_1 && cord.GetDest() == EEOSCordDest::KEY_SUSTAIN) { continue; } // Emax II specific
-        if (cord.GetSource() == EEOSCordSource::SRC_OFF && cord.GetDest() == EEOSCordDest::DST_OFF) { continue; }
-
-        Logger::LogMessage("(preset: %s, voice: %d) Cord was not accounted: src: %d, dst: %d", e4Preset.GetName().data(),
-            voiceIndex, cord.GetSource(), cord.GetDest());
+        const auto src(static_cast<uint8_t>(cord.GetSource()));
+        const auto dst(static_cast<uint8_t>(cord.GetDest()));
+        if (!KNOWN_CORD_SOURCES.test(src)) { diagnostics.Add(EE4DiagnosticType::UNKNOWN_CORD_SOURCE, src, dst, e4Preset.GetName(), voiceIndex); }
+        else if (!KNOWN_CORD_DESTS.test(dst)) { diagnostics.Add(EE4DiagnosticType::UNKNOWN_CORD_DEST, src, dst, e4Preset.GetName(), voiceIndex); }
+        else if (!ACCOUNTED_CORDS.test(GetCordPairIndex(cord.GetSource(), cord.GetDest())))
+        {
+            diagnostics.Add(EE4DiagnosticType::UNACCOUNTED_CORD, src, dst, e4Preset.GetName(), voiceIndex);
+        }
     }
 }
@@ -1,16 +1,36 @@
 ﻿#include "Header/IO/E4BWriter.h"
 #include "Header/IO/BinaryWriter.h"
 #include "Header/Logger.h"
-#include "Header/MathFunctions.h"
 #include "Header/E4B/Data/E4Preset.h"
 #include "Header/E4B/Data/E3Sample.h"
 #include "Header/E4B/Helpers/E4BHelpers.h"
 #include "Header/IO/E4BReader.h"
 #include "Header/E4B/Data/EMSt.h"
 
+namespace
+{
+    [[nodiscard]] uint32_t GetPresetDataLength(const E4Preset& preset)
+    {
+        return preset.GetTotalDataSize() + sizeof(uint16_t);
+    }
+
+    [[nodiscard]] uint32_t GetSampleDataLength(const BankSample& sample)
+    {
+        return static_cast<uint32_t>(E3SampleVariables::SAMPLE_DATA_READ_SIZE + sizeof(uint16_t) * sample.m_sampleData.size());
+    }
+}
+
 void E4BWriter::BeginWriting(BinaryWriter& writer)
 {
     m_beganWriting = true;
+
+    // Only the grouping plans, the voices are converted as each preset is written
+    m_presets.clear();
+    m_presets.reserve(m_bank.m_presets.size());
+    for (const auto& preset : m_bank.m_presets) { m_presets.emplace_back(preset); }
+
+    // The whole file is sized up front, growing the buffer as we go would briefly hold the sample data twice
+    writer.Reserve(GetTotalFileSize());
     
     // Write the beginning FORM tag
     writer.writeType(E4BVariables::EOS_FORM_TAG.data(), sizeof(char) * E4BVariables::EOS_FORM_TAG.length());
@@ -40,17 +60,23 @@ void E4BWriter::EndWriting(BinaryWriter& writer)
     WriteTOC(writer);
     
     // Write the total FORM size now that we've input everything into the file.
-    const uint32_t byteswapTotalFormSize(MathFunctions::byteswapUINT32(m_totalFORMSize));
+    const uint32_t byteswapTotalFormSize(ByteSwap(m_totalFORMSize));
     writer.writeTypeAtLocation(&byteswapTotalFormSize, E4BVariables::EOS_FORM_TAG.length());
 
     // Write the total indexing size now that we've input everything into the file.
-    const uint32_t byteswapTotalIndexingSize(MathFunctions::byteswapUINT32(m_totalIndexingSize));
+    const uint32_t byteswapTotalIndexingSize(ByteSwap(m_totalIndexingSize));
     writer.writeTypeAtLocation(&byteswapTotalIndexingSize, E4BVariables::EOS_FORM_TAG.length() + sizeof(uint32_t) +
         E4BVariables::EOS_E4_FORMAT_TAG.length() + E4BVariables::EOS_TOC_TAG.length());
     
-    if(writer.finishWriting()) { Logger::LogMessage("Successfully wrote E4B file!"); }
-    else { Logger::LogMessage("Failed to write E4B file!"); }
+    // In memory the caller writes the file and reports on it
+    const bool finished(writer.finishWriting());
+    if (writer.IsWritingToFile())
+    {
+        if(finished) { Logger::LogMessage("Successfully wrote E4B file!"); }
+        else { Logger::LogMessage("Failed to write E4B file!"); }
+    }
 
+    m_presets.clear();
     m_beganWriting = false;
 }
 
@@ -70,18 +96,37 @@ std::string E4BWriter::ConvertNameToEmuName(const std::string_view& name) const
     return str;
 }
 
+size_t E4BWriter::GetTotalFileSize() const
+{
+    size_t totalSize(E4BVariables::EOS_FORM_TAG.length() + sizeof(uint32_t) + E4BVariables::EOS_E4_FORMAT_TAG.length() +
+        E4BVariables::EOS_TOC_TAG.length() + sizeof(uint32_t));
+
+    for (const auto& preset : m_presets)
+    {
+        totalSize += E4BVariables::EOS_CHUNK_TOTAL_LEN + E4BVariables::EOS_CHUNK_SIZE + GetPresetDataLength(preset);
+    }
+
+    for (const auto& sample : m_bank.m_samples)
+    {
+        totalSize += E4BVariables::EOS_CHUNK_TOTAL_LEN + E4BVariables::EOS_CHUNK_SIZE + GetSampleDataLength(sample);
+    }
+
+    return totalSize + E4BVariables::EOS_CHUNK_SIZE + TOTAL_EMST_DATA_SIZE;
+}
+
 void E4BWriter::WriteTOC(BinaryWriter& writer)
 {
     std::vector<size_t> presetTOCChunkLocations{};
-    for(const auto& preset : m_presets)
+    for(size_t i(0); i < m_bank.m_presets.size(); ++i)
     {
+        const auto& preset(m_bank.m_presets[i]);
         presetTOCChunkLocations.emplace_back(writer.GetWritePos() + 8);
         
-        const uint32_t presetDataLength(TOTAL_PRESET_DATA_SIZE + (static_cast<uint32_t>(preset.m_voices.size()) * VOICE_1_ZONE_DATA_SIZE));
+        const uint32_t presetDataLength(GetPresetDataLength(m_presets[i]) - sizeof(uint16_t));
         E4TOCChunk E4P1Chunk(E4BHelpers::ConvertToE4ChunkName(E4BVariables::EOS_E4_PRESET_TAG), presetDataLength, 0u);
         E4P1Chunk.write(writer);
 
-        const uint16_t presetIndex(_byteswap_ushort(preset.m_index));
+        const uint16_t presetIndex(ByteSwap(preset.m_index));
         writer.writeType(&presetIndex);
 
         const auto presetName(E4BHelpers::ConvertToE4Name(preset.m_presetName));
@@ -94,17 +139,16 @@ void E4BWriter::WriteTOC(BinaryWriter& writer)
     }
 
     std::vector<size_t> sampleTOCChunkLocations{};
-    for(const auto& sample : m_samples)
+    for(const auto& sample : m_bank.m_samples)
     {
         sampleTOCChunkLocations.emplace_back(writer.GetWritePos() + 8);
         
-        const uint32_t sampleDataLength(static_cast<uint32_t>(E3SampleVariables::SAMPLE_DATA_READ_SIZE +
-            sizeof(uint16_t) * sample.m_sampleData.size()) - sizeof(uint16_t));
+        const uint32_t sampleDataLength(GetSampleDataLength(sample) - sizeof(uint16_t));
         
         E4TOCChunk E3S1Chunk(E4BHelpers::ConvertToE4ChunkName(E4BVariables::EOS_E3_SAMPLE_TAG), sampleDataLength, 0u);
         E3S1Chunk.write(writer);
 
-        const uint16_t sampleIndex(_byteswap_ushort(sample.m_index + 1ui16));
+        const uint16_t sampleIndex(ByteSwap(static_cast<uint16_t>(sample.m_index + 1ui16)));
         writer.writeType(&sampleIndex);
 
         const auto sampleName(E4BHelpers::ConvertToE4Name(sample.m_sampleName));
@@ -117,18 +161,17 @@ void E4BWriter::WriteTOC(BinaryWriter& writer)
     }
     
     size_t index(0);
-    for(const auto& preset : m_presets)
+    for(const auto& e4Preset : m_presets)
     {
-        const uint32_t writePos(MathFunctions::byteswapUINT32(static_cast<uint32_t>(writer.GetWritePos())));
+        const uint32_t writePos(ByteSwap(static_cast<uint32_t>(writer.GetWritePos())));
         writer.writeTypeAtLocation(&writePos, presetTOCChunkLocations[index]);
         
-        const uint32_t presetDataLength((TOTAL_PRESET_DATA_SIZE + (static_cast<uint32_t>(preset.m_voices.size()) * VOICE_1_ZONE_DATA_SIZE)) + sizeof(uint16_t));
+        const uint32_t presetDataLength(GetPresetDataLength(e4Preset));
         E4DataChunk E4P1Chunk(E4BHelpers::ConvertToE4ChunkName(E4BVariables::EOS_E4_PRESET_TAG), presetDataLength);
         E4P1Chunk.write(writer);
         
         m_totalFORMSize += static_cast<uint32_t>(E4BVariables::EOS_CHUNK_SIZE);
         
-        E4Preset e4Preset(preset);
         e4Preset.write(writer);
 
         m_totalFORMSize += presetDataLength;
@@ -137,12 +180,12 @@ void E4BWriter::WriteTOC(BinaryWriter& writer)
 
     index = 0;
     
-    for(const auto& sample : m_samples)
+    for(const auto& sample : m_bank.m_samples)
     {
-        const uint32_t writePos(MathFunctions::byteswapUINT32(static_cast<uint32_t>(writer.GetWritePos())));
+        const uint32_t writePos(ByteSwap(static_cast<uint32_t>(writer.GetWritePos())));
         writer.writeTypeAtLocation(&writePos, sampleTOCChunkLocations[index]);
 
-        const uint32_t sampleDataLength(static_cast<uint32_t>(E3SampleVariables::SAMPLE_DATA_READ_SIZE + sizeof(uint16_t) * sample.m_sampleData.size()));
+        const uint32_t sampleDataLength(GetSampleDataLength(sample));
         E4DataChunk E3S1Chunk(E4BHelpers::ConvertToE4ChunkName(E4BVariables::EOS_E3_SAMPLE_TAG), sampleDataLength);
         E3S1Chunk.write(writer);
         
@@ -0,0 +1,665 @@
+#include "Header/IO/FLACCodec.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    constexpr std::array<uint8_t, 4> FLAC_MAGIC{'f', 'L', 'a', 'C'};
+    constexpr uint32_t FRAME_SYNC_CODE = 0x3FFEu; // 14 bits
+    constexpr uint32_t STREAMINFO_SIZE = 34u;
+    constexpr uint32_t BITS_PER_SAMPLE = 16u;
+
+    uint8_t UpdateCRC8(uint8_t crc, const uint8_t* data, const size_t size)
+    {
+        for (size_t i(0); i < size; ++i)
+        {
+            crc ^= data[i];
+            for (uint32_t bit(0u); bit < 8u; ++bit) { crc = static_cast<uint8_t>((crc & 0x80u) != 0u ? (crc << 1) ^ 0x07u : crc << 1); }
+        }
+
+        return crc;
+    }
+
+    uint16_t UpdateCRC16(uint16_t crc, const uint8_t* data, const size_t size)
+    {
+        for (size_t i(0); i < size; ++i)
+        {
+            crc ^= static_cast<uint16_t>(data[i] << 8);
+            for (uint32_t bit(0u); bit < 8u; ++bit) { crc = static_cast<uint16_t>((crc & 0x8000u) != 0u ? (crc << 1) ^ 0x8005u : crc << 1); }
+        }
+
+        return crc;
+    }
+
+    struct BitWriter final
+    {
+        explicit BitWriter(std::vector<uint8_t>& output) : m_output(output) {}
+
+        void Write(const uint64_t value, const uint32_t numBits)
+        {
+            for (uint32_t i(numBits); i > 0u; --i)
+            {
+                m_currentByte = static_cast<uint8_t>((m_currentByte << 1) | ((value >> (i - 1u)) & 1u));
+                if (++m_numBitsInByte == 8u) { FlushByte(); }
+            }
+        }
+
+        void WriteSigned(const int64_t value, const uint32_t numBits) { Write(static_cast<uint64_t>(value) & ((1ull << numBits) - 1ull), numBits); }
+
+        void WriteUnary(uint32_t numZeros)
+        {
+            for (; numZeros >= 32u; numZeros -= 32u) { Write(0u, 32u); }
+            Write(1u, numZeros + 1u);
+        }
+
+        void AlignToByte()
+        {
+            if (m_numBitsInByte > 0u) { Write(0u, 8u - m_numBitsInByte); }
+        }
+
+    private:
+        void FlushByte()
+        {
+            m_output.emplace_back(m_currentByte);
+            m_currentByte = 0u;
+            m_numBitsInByte = 0u;
+        }
+
+        std::vector<uint8_t>& m_output;
+        uint8_t m_currentByte = 0u;
+        uint32_t m_numBitsInByte = 0u;
+    };
+
+    struct BitReader final
+    {
+        explicit BitReader(const uint8_t* data, const size_t size) : m_data(data), m_size(size) {}
+
+        [[nodiscard]] bool Read(uint32_t numBits, uint64_t& outValue)
+        {
+            outValue = 0u;
+            if (numBits > (m_size - m_bytePos) * 8u - m_bitPos) { return false; }
+
+            while (numBits > 0u)
+            {
+                const uint32_t bitsLeftInByte(8u - m_bitPos);
+                const uint32_t take(std::min(numBits, bitsLeftInByte));
+                const uint32_t shift(bitsLeftInByte - take);
+                outValue = (outValue << take) | ((m_data[m_bytePos] >> shift) & ((1u << take) - 1u));
+
+                m_bitPos += take;
+                numBits -= take;
+                if (m_bitPos == 8u)
+                {
+                    m_bitPos = 0u;
+                    ++m_bytePos;
+                }
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] bool ReadSigned(const uint32_t numBits, int64_t& outValue)
+        {
+            uint64_t value(0u);
+            if (numBits == 0u || !Read(numBits, value)) { outValue = 0; return numBits == 0u; }
+
+            // Sign-extend
+            const uint64_t signBit(1ull << (numBits - 1u));
+            outValue = static_cast<int64_t>((value ^ signBit) - signBit);
+            return true;
+        }
+
+        [[nodiscard]] bool ReadUnary(uint32_t& outNumZeros)
+        {
+            outNumZeros = 0u;
+            uint64_t bit(0u);
+            while (Read(1u, bit))
+            {
+                if (bit != 0u) { return true; }
+                ++outNumZeros;
+            }
+
+            return false;
+        }
+
+        void AlignToByte()
+        {
+            if (m_bitPos != 0u)
+            {
+                m_bitPos = 0u;
+                ++m_bytePos;
+            }
+        }
+
+        [[nodiscard]] size_t GetBytePos() const { return m_bytePos; }
+        [[nodiscard]] bool IsAtEnd() const { return m_bytePos >= m_size; }
+
+    private:
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+        size_t m_bytePos = 0;
+        uint32_t m_bitPos = 0u;
+    };
+
+    uint32_t ZigZag(const int32_t value) { return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31); }
+
+    // Residual of the fixed polynomial predictor of the given order
+    void ComputeFixedResidual(const int32_t* samples, const uint32_t blockSize, const uint32_t order, int32_t* outResidual)
+    {
+        for (uint32_t i(order); i < blockSize; ++i)
+        {
+            switch (order)
+            {
+                case 0u: { outResidual[i] = samples[i]; break; }
+                case 1u: { outResidual[i] = samples[i] - samples[i - 1]; break; }
+                case 2u: { outResidual[i] = samples[i] - 2 * samples[i - 1] + samples[i - 2]; break; }
+                case 3u: { outResidual[i] = samples[i] - 3 * samples[i - 1] + 3 * samples[i - 2] - samples[i - 3]; break; }
+                default: { outResidual[i] = samples[i] - 4 * samples[i - 1] + 6 * samples[i - 2] - 4 * samples[i - 3] + samples[i - 4]; break; }
+            }
+        }
+    }
+
+    uint64_t GetRiceBits(const uint32_t* foldedResidual, const size_t count, const uint32_t riceParam)
+    {
+        uint64_t outBits(static_cast<uint64_t>(count) * (riceParam + 1u));
+        for (size_t i(0); i < count; ++i) { outBits += foldedResidual[i] >> riceParam; }
+        return outBits;
+    }
+
+    uint32_t GetBestRiceParam(const uint32_t* foldedResidual, const size_t count, uint64_t& outBits)
+    {
+        uint64_t sum(0u);
+        for (size_t i(0); i < count; ++i) { sum += foldedResidual[i]; }
+
+        // Start from the estimate based on the mean and check its neighbours
+        uint32_t estimate(0u);
+        while (estimate < FLACCodecStatics::MAX_RICE_PARAM && (static_cast<uint64_t>(count) << (estimate + 1u)) < sum) { ++estimate; }
+
+        uint32_t bestParam(estimate);
+        outBits = GetRiceBits(foldedResidual, count, estimate);
+        for (const uint32_t candidate : {estimate > 0u ? estimate - 1u : estimate, std::min(estimate + 1u, FLACCodecStatics::MAX_RICE_PARAM)})
+        {
+            const uint64_t bits(GetRiceBits(foldedResidual, count, candidate));
+            if (bits < outBits)
+            {
+                outBits = bits;
+                bestParam = candidate;
+            }
+        }
+
+        return bestParam;
+    }
+
+    struct ResidualPlan final
+    {
+        std::array<uint32_t, 1u << FLACCodecStatics::MAX_PARTITION_ORDER> m_riceParams{};
+        uint32_t m_partitionOrder = 0u;
+        uint64_t m_numBits = std::numeric_limits<uint64_t>::max();
+    };
+
+    ResidualPlan PlanResidual(const uint32_t* foldedResidual, const uint32_t blockSize, const uint32_t predictorOrder)
+    {
+        ResidualPlan outPlan{};
+        for (uint32_t partitionOrder(0u); partitionOrder <= FLACCodecStatics::MAX_PARTITION_ORDER; ++partitionOrder)
+        {
+            const uint32_t numPartitions(1u << partitionOrder);
+            if (blockSize % numPartitions != 0u || (blockSize >> partitionOrder) <= predictorOrder) { break; }
+
+            ResidualPlan plan{};
+            plan.m_partitionOrder = partitionOrder;
+            plan.m_numBits = 2u + 4u; // Coding method and partition order
+
+            const uint32_t partitionSize(blockSize >> partitionOrder);
+            for (uint32_t partition(0u); partition < numPartitions; ++partition)
+            {
+                // The first partition holds the warm-up samples, which are not part of the residual
+                const uint32_t start(partition == 0u ? predictorOrder : partition * partitionSize);
+                const uint32_t end((partition + 1u) * partitionSize);
+
+                uint64_t bits(0u);
+                plan.m_riceParams[partition] = GetBestRiceParam(&foldedResidual[start], end - start, bits);
+                plan.m_numBits += 4u + bits;
+            }
+
+            if (plan.m_numBits < outPlan.m_numBits) { outPlan = plan; }
+        }
+
+        return outPlan;
+    }
+
+    void EncodeSubframe(BitWriter& writer, const int32_t* samples, const uint32_t blockSize, std::vector<int32_t>& residual,
+        std::vector<uint32_t>& foldedResidual)
+    {
+        // Constant subframe for silence and DC
+        if (std::all_of(samples, samples + blockSize, [first = samples[0]](const int32_t sample) { return sample == first; }))
+        {
+            writer.Write(0u, 1u);
+            writer.Write(0b000000u, 6u);
+            writer.Write(0u, 1u);
+            writer.WriteSigned(samples[0], BITS_PER_SAMPLE);
+            return;
+        }
+
+        uint32_t bestOrder(0u);
+        ResidualPlan bestPlan{};
+        std::vector<uint32_t> bestFolded{};
+        for (uint32_t order(0u); order <= std::min(FLACCodecStatics::MAX_FIXED_ORDER, blockSize - 1u); ++order)
+        {
+            ComputeFixedResidual(samples, blockSize, order, residual.data());
+            for (uint32_t i(order); i < blockSize; ++i) { foldedResidual[i] = ZigZag(residual[i]); }
+
+            const auto plan(PlanResidual(foldedResidual.data(), blockSize, order));
+            const uint64_t numBits(plan.m_numBits + static_cast<uint64_t>(order) * BITS_PER_SAMPLE);
+            if (numBits < bestPlan.m_numBits + static_cast<uint64_t>(bestOrder) * BITS_PER_SAMPLE || bestFolded.empty())
+            {
+                bestOrder = order;
+                bestPlan = plan;
+                bestFolded.assign(foldedResidual.begin(), foldedResidual.begin() + blockSize);
+            }
+        }
+
+        // Noise-like blocks can come out larger than the raw samples
+        const uint64_t verbatimBits(static_cast<uint64_t>(blockSize) * BITS_PER_SAMPLE);
+        if (bestPlan.m_numBits + static_cast<uint64_t>(bestOrder) * BITS_PER_SAMPLE >= verbatimBits)
+        {
+            writer.Write(0u, 1u);
+            writer.Write(0b000001u, 6u);
+            writer.Write(0u, 1u);
+            for (uint32_t i(0u); i < blockSize; ++i) { writer.WriteSigned(samples[i], BITS_PER_SAMPLE); }
+            return;
+        }
+
+        writer.Write(0u, 1u);
+        writer.Write(0b001000u | bestOrder, 6u);
+        writer.Write(0u, 1u);
+        for (uint32_t i(0u); i < bestOrder; ++i) { writer.WriteSigned(samples[i], BITS_PER_SAMPLE); }
+
+        writer.Write(0b00u, 2u); // Rice, 4-bit parameters
+        writer.Write(bestPlan.m_partitionOrder, 4u);
+
+        const uint32_t partitionSize(blockSize >> bestPlan.m_partitionOrder);
+        for (uint32_t partition(0u); partition < (1u << bestPlan.m_partitionOrder); ++partition)
+        {
+            const uint32_t riceParam(bestPlan.m_riceParams[partition]);
+            writer.Write(riceParam, 4u);
+
+            const uint32_t start(partition == 0u ? bestOrder : partition * partitionSize);
+            for (uint32_t i(start); i < (partition + 1u) * partitionSize; ++i)
+            {
+                writer.WriteUnary(bestFolded[i] >> riceParam);
+                if (riceParam > 0u) { writer.Write(bestFolded[i] & ((1u << riceParam) - 1u), riceParam); }
+            }
+        }
+    }
+
+    void WriteUTF8Number(BitWriter& writer, const uint32_t value)
+    {
+        if (value < 0x80u) { writer.Write(value, 8u); return; }
+
+        uint32_t numContinuationBytes(1u);
+        while (numContinuationBytes < 6u && value >= (1u << (6u - numContinuationBytes + 6u * numContinuationBytes))) { ++numContinuationBytes; }
+
+        const uint32_t leadingOnes(((0xFF00u >> (numContinuationBytes + 1u)) & 0xFFu));
+        writer.Write(leadingOnes | (value >> (6u * numContinuationBytes)), 8u);
+        for (uint32_t i(numContinuationBytes); i > 0u; --i) { writer.Write(0x80u | ((value >> (6u * (i - 1u))) & 0x3Fu), 8u); }
+    }
+
+    bool ReadUTF8Number(BitReader& reader)
+    {
+        uint64_t firstByte(0u);
+        if (!reader.Read(8u, firstByte)) { return false; }
+
+        uint32_t numContinuationBytes(0u);
+        for (uint64_t mask(0x80u); (firstByte & mask) != 0u && mask > 1u; mask >>= 1u) { ++numContinuationBytes; }
+        if (numContinuationBytes == 1u || numContinuationBytes > 7u) { return false; }
+
+        for (uint32_t i(1u); i < numContinuationBytes; ++i)
+        {
+            uint64_t continuation(0u);
+            if (!reader.Read(8u, continuation) || (continuation & 0xC0u) != 0x80u) { return false; }
+        }
+
+        return true;
+    }
+
+    bool DecodeResidual(BitReader& reader, const uint32_t blockSize, const uint32_t predictorOrder, int32_t* outResidual)
+    {
+        uint64_t codingMethod(0u), partitionOrder(0u);
+        if (!reader.Read(2u, codingMethod) || codingMethod > 1u || !reader.Read(4u, partitionOrder)) { return false; }
+
+        const uint32_t paramBits(codingMethod == 0u ? 4u : 5u);
+        const uint32_t escapeParam((1u << paramBits) - 1u);
+        const uint32_t numPartitions(1u << partitionOrder);
+        const uint32_t partitionSize(blockSize >> partitionOrder);
+        if ((blockSize % numPartitions) != 0u || partitionSize < predictorOrder) { return false; }
+
+        for (uint32_t partition(0u); partition < numPartitions; ++partition)
+        {
+            const uint32_t start(partition == 0u ? predictorOrder : partition * partitionSize);
+            const uint32_t end((partition + 1u) * partitionSize);
+
+            uint64_t riceParam(0u);
+            if (!reader.Read(paramBits, riceParam)) { return false; }
+
+            if (riceParam == escapeParam)
+            {
+                uint64_t rawBits(0u);
+                if (!reader.Read(5u, rawBits)) { return false; }
+
+                for (uint32_t i(start); i < end; ++i)
+                {
+                    int64_t value(0);
+                    if (!reader.ReadSigned(static_cast<uint32_t>(rawBits), value)) { return false; }
+                    outResidual[i] = static_cast<int32_t>(value);
+                }
+
+                continue;
+            }
+
+            for (uint32_t i(start); i < end; ++i)
+            {
+                uint32_t quotient(0u);
+                uint64_t remainder(0u);
+                if (!reader.ReadUnary(quotient) || !reader.Read(static_cast<uint32_t>(riceParam), remainder)) { return false; }
+
+                const uint32_t folded((quotient << riceParam) | static_cast<uint32_t>(remainder));
+                outResidual[i] = static_cast<int32_t>(folded >> 1) ^ -static_cast<int32_t>(folded & 1u);
+            }
+        }
+
+        return true;
+    }
+
+    bool DecodeSubframe(BitReader& reader, const uint32_t blockSize, uint32_t bitsPerSample, int32_t* outSamples)
+    {
+        uint64_t padding(0u), type(0u), hasWastedBits(0u);
+        if (!reader.Read(1u, padding) || padding != 0u || !reader.Read(6u, type) || !reader.Read(1u, hasWastedBits)) { return false; }
+
+        uint32_t wastedBits(0u);
+        if (hasWastedBits != 0u)
+        {
+            uint32_t numZeros(0u);
+            if (!reader.ReadUnary(numZeros)) { return false; }
+            wastedBits = numZeros + 1u;
+            if (wastedBits >= bitsPerSample) { return false; }
+            bitsPerSample -= wastedBits;
+        }
+
+        if (type == 0b000000u)
+        {
+            int64_t value(0);
+            if (!reader.ReadSigned(bitsPerSample, value)) { return false; }
+            std::fill_n(outSamples, blockSize, static_cast<int32_t>(value));
+        }
+        else if (type == 0b000001u)
+        {
+            for (uint32_t i(0u); i < blockSize; ++i)
+            {
+                int64_t value(0);
+                if (!reader.ReadSigned(bitsPerSample, value)) { return false; }
+                outSamples[i] = static_cast<int32_t>(value);
+            }
+        }
+        else if ((type & 0b111000u) == 0b001000u && (type & 0b000111u) <= FLACCodecStatics::MAX_FIXED_ORDER)
+        {
+            const uint32_t order(static_cast<uint32_t>(type & 0b000111u));
+            if (order > blockSize) { return false; }
+
+            for (uint32_t i(0u); i < order; ++i)
+            {
+                int64_t value(0);
+                if (!reader.ReadSigned(bitsPerSample, value)) { return false; }
+                outSamples[i] = static_cast<int32_t>(value);
+            }
+
+            if (!DecodeResidual(reader, blockSize, order, outSamples)) { return false; }
+
+            // Residuals were decoded in place, add the prediction back
+            for (uint32_t i(order); i < blockSize; ++i)
+            {
+                const int64_t residual(outSamples[i]);
+                int64_t prediction(0);
+                switch (order)
+                {
+                    case 0u: { break; }
+                    case 1u: { prediction = outSamples[i - 1]; break; }
+                    case 2u: { prediction = 2ll * outSamples[i - 1] - outSamples[i - 2]; break; }
+                    case 3u: { prediction = 3ll * outSamples[i - 1] - 3ll * outSamples[i - 2] + outSamples[i - 3]; break; }
+                    default: { prediction = 4ll * outSamples[i - 1] - 6ll * outSamples[i - 2] + 4ll * outSamples[i - 3] - outSamples[i - 4]; break; }
+                }
+
+                outSamples[i] = static_cast<int32_t>(prediction + residual);
+            }
+        }
+        else if ((type & 0b100000u) != 0u)
+        {
+            const uint32_t order(static_cast<uint32_t>(type & 0b011111u) + 1u);
+            if (order > blockSize) { return false; }
+
+            for (uint32_t i(0u); i < order; ++i)
+            {
+                int64_t value(0);
+                if (!reader.ReadSigned(bitsPerSample, value)) { return false; }
+                outSamples[i] = static_cast<int32_t>(value);
+            }
+
+            uint64_t precision(0u);
+            int64_t shift(0);
+            if (!reader.Read(4u, precision) || precision == 0b1111u || !reader.ReadSigned(5u, shift) || shift < 0) { return false; }
+
+            std::array<int32_t, 32> coefficients{};
+            for (uint32_t i(0u); i < order; ++i)
+            {
+                int64_t coefficient(0);
+                if (!reader.ReadSigned(static_cast<uint32_t>(precision) + 1u, coefficient)) { return false; }
+                coefficients[i] = static_cast<int32_t>(coefficient);
+            }
+
+            if (!DecodeResidual(reader, blockSize, order, outSamples)) { return false; }
+
+            for (uint32_t i(order); i < blockSize; ++i)
+            {
+                int64_t prediction(0);
+                for (uint32_t j(0u); j < order; ++j) { prediction += static_cast<int64_t>(coefficients[j]) * outSamples[i - j - 1u]; }
+                outSamples[i] = static_cast<int32_t>(outSamples[i] + (prediction >> shift));
+            }
+        }
+        else { return false; }
+
+        if (wastedBits > 0u)
+        {
+            for (uint32_t i(0u); i < blockSize; ++i) { outSamples[i] = static_cast<int32_t>(static_cast<uint32_t>(outSamples[i]) << wastedBits); }
+        }
+
+        return true;
+    }
+}
+
+std::vector<uint8_t> FLACCodec::Encode(const int16_t* samples, const size_t numFrames, uint32_t numChannels, const uint32_t sampleRate)
+{
+    numChannels = std::clamp(numChannels, 1u, 8u);
+
+    std::vector<uint8_t> outData(FLAC_MAGIC.begin(), FLAC_MAGIC.end());
+    outData.reserve(numFrames * numChannels + 64u);
+
+    // STREAMINFO (the MD5 is left zeroed, which means "not computed")
+    {
+        BitWriter writer(outData);
+        writer.Write(1u, 1u); // Last metadata block
+        writer.Write(0u, 7u);
+        writer.Write(STREAMINFO_SIZE, 24u);
+        writer.Write(std::min<size_t>(FLACCodecStatics::BLOCK_SIZE, std::max<size_t>(numFrames, 16u)), 16u);
+        writer.Write(FLACCodecStatics::BLOCK_SIZE, 16u);
+        writer.Write(0u, 24u);
+        writer.Write(0u, 24u);
+        writer.Write(sampleRate, 20u);
+        writer.Write(numChannels - 1u, 3u);
+        writer.Write(BITS_PER_SAMPLE - 1u, 5u);
+        writer.Write(numFrames, 36u);
+        writer.Write(0u, 64u);
+        writer.Write(0u, 64u);
+    }
+
+    std::vector<int32_t> channelSamples(FLACCodecStatics::BLOCK_SIZE);
+    std::vector<int32_t> residual(FLACCodecStatics::BLOCK_SIZE);
+    std::vector<uint32_t> foldedResidual(FLACCodecStatics::BLOCK_SIZE);
+
+    uint32_t frameNumber(0u);
+    for (size_t frameStart(0); frameStart < numFrames; frameStart += FLACCodecStatics::BLOCK_SIZE, ++frameNumber)
+    {
+        const auto blockSize(static_cast<uint32_t>(std::min<size_t>(FLACCodecStatics::BLOCK_SIZE, numFrames - frameStart)));
+        const size_t frameOffset(outData.size());
+
+        BitWriter writer(outData);
+        writer.Write(FRAME_SYNC_CODE, 14u);
+        writer.Write(0u, 1u); // Reserved
+        writer.Write(0u, 1u); // Fixed block size
+        writer.Write(0b0111u, 4u); // Block size stored as 16 bits after the frame number
+        writer.Write(0b0000u, 4u); // Sample rate from STREAMINFO
+        writer.Write(numChannels - 1u, 4u); // Independent channels
+        writer.Write(0b100u, 3u); // 16 bits per sample
+        writer.Write(0u, 1u);
+        WriteUTF8Number(writer, frameNumber);
+        writer.Write(blockSize - 1u, 16u);
+        writer.Write(UpdateCRC8(0u, &outData[frameOffset], outData.size() - frameOffset), 8u);
+
+        for (uint32_t channel(0u); channel < numChannels; ++channel)
+        {
+            for (uint32_t i(0u); i < blockSize; ++i) { channelSamples[i] = samples[(frameStart + i) * numChannels + channel]; }
+            EncodeSubframe(writer, channelSamples.data(), blockSize, residual, foldedResidual);
+        }
+
+        writer.AlignToByte();
+        writer.Write(UpdateCRC16(0u, &outData[frameOffset], outData.size() - frameOffset), 16u);
+    }
+
+    return outData;
+}
+
+bool FLACCodec::IsFLAC(const uint8_t* data, const size_t size)
+{
+    return size >= FLAC_MAGIC.size() && std::memcmp(data, FLAC_MAGIC.data(), FLAC_MAGIC.size()) == 0;
+}
+
+bool FLACCodec::Decode(const uint8_t* data, const size_t size, std::vector<int16_t>& outSamples, uint32_t& outNumChannels, uint32_t& outSampleRate)
+{
+    outSamples.clear();
+    if (!IsFLAC(data, size)) { return false; }
+
+    BitReader reader(data + FLAC_MAGIC.size(), size - FLAC_MAGIC.size());
+
+    // Metadata, only STREAMINFO matters
+    uint32_t streamBitsPerSample(0u);
+    uint64_t totalFrames(0u);
+    bool isLastBlock(false);
+    while (!isLastBlock)
+    {
+        uint64_t lastFlag(0u), blockType(0u), blockSize(0u);
+        if (!reader.Read(1u, lastFlag) || !reader.Read(7u, blockType) || !reader.Read(24u, blockSize)) { return false; }
+        isLastBlock = lastFlag != 0u;
+
+        if (blockType == 0u)
+        {
+            uint64_t value(0u);
+            if (blockSize < STREAMINFO_SIZE || !reader.Read(16u, value) || !reader.Read(16u, value) || !reader.Read(24u, value)
+                || !reader.Read(24u, value) || !reader.Read(20u, value)) { return false; }
+            outSampleRate = static_cast<uint32_t>(value);
+
+            if (!reader.Read(3u, value)) { return false; }
+            outNumChannels = static_cast<uint32_t>(value) + 1u;
+
+            if (!reader.Read(5u, value)) { return false; }
+            streamBitsPerSample = static_cast<uint32_t>(value) + 1u;
+
+            if (!reader.Read(36u, totalFrames)) { return false; }
+            blockSize -= STREAMINFO_SIZE - 16u;
+        }
+
+        for (uint64_t i(0u); i < blockSize; ++i)
+        {
+            uint64_t skipped(0u);
+            if (!reader.Read(8u, skipped)) { return false; }
+        }
+    }
+
+    if (outNumChannels == 0u || streamBitsPerSample == 0u) { return false; }
+    if (totalFrames > 0u) { outSamples.reserve(static_cast<size_t>(totalFrames) * outNumChannels); }
+
+    std::vector<std::vector<int32_t>> channelSamples(outNumChannels);
+    while (!reader.IsAtEnd())
+    {
+        uint64_t syncCode(0u), reserved(0u), blockingStrategy(0u), blockSizeCode(0u), sampleRateCode(0u), channelAssignment(0u), sampleSizeCode(0u);
+        if (!reader.Read(14u, syncCode) || syncCode != FRAME_SYNC_CODE || !reader.Read(1u, reserved) || !reader.Read(1u, blockingStrategy)
+            || !reader.Read(4u, blockSizeCode) || !reader.Read(4u, sampleRateCode) || !reader.Read(4u, channelAssignment)
+            || !reader.Read(3u, sampleSizeCode) || !reader.Read(1u, reserved)) { return false; }
+
+        if (!ReadUTF8Number(reader)) { return false; }
+
+        uint32_t blockSize(0u);
+        uint64_t value(0u);
+        if (blockSizeCode == 0b0001u) { blockSize = 192u; }
+        else if (blockSizeCode >= 0b0010u && blockSizeCode <= 0b0101u) { blockSize = 576u << (blockSizeCode - 2u); }
+        else if (blockSizeCode == 0b0110u && reader.Read(8u, value)) { blockSize = static_cast<uint32_t>(value) + 1u; }
+        else if (blockSizeCode == 0b0111u && reader.Read(16u, value)) { blockSize = static_cast<uint32_t>(value) + 1u; }
+        else if (blockSizeCode >= 0b1000u) { blockSize = 256u << (blockSizeCode - 8u); }
+        if (blockSize == 0u) { return false; }
+
+        if (sampleRateCode == 0b1100u && !reader.Read(8u, value)) { return false; }
+        if ((sampleRateCode == 0b1101u || sampleRateCode == 0b1110u) && !reader.Read(16u, value)) { return false; }
+        if (!reader.Read(8u, value)) { return false; } // CRC-8
+
+        constexpr std::array<uint32_t, 8> SAMPLE_SIZES{0u, 8u, 12u, 0u, 16u, 20u, 24u, 32u};
+        const uint32_t bitsPerSample(sampleSizeCode == 0u ? streamBitsPerSample : SAMPLE_SIZES[sampleSizeCode]);
+        if (bitsPerSample == 0u || bitsPerSample > 24u) { return false; }
+
+        // 8 = left/side, 9 = side/right, 10 = mid/side
+        const bool isDecorrelated(channelAssignment >= 8u && channelAssignment <= 10u);
+        if ((isDecorrelated && outNumChannels != 2u) || (!isDecorrelated && channelAssignment + 1u != outNumChannels)) { return false; }
+
+        for (uint32_t channel(0u); channel < outNumChannels; ++channel)
+        {
+            // The side channel carries one extra bit
+            const bool isSideChannel((channelAssignment == 8u && channel == 1u) || (channelAssignment == 9u && channel == 0u)
+                || (channelAssignment == 10u && channel == 1u));
+
+            channelSamples[channel].resize(blockSize);
+            if (!DecodeSubframe(reader, blockSize, bitsPerSample + (isSideChannel ? 1u : 0u), channelSamples[channel].data())) { return false; }
+        }
+
+        reader.AlignToByte();
+        if (!reader.Read(16u, value)) { return false; } // CRC-16
+
+        if (isDecorrelated)
+        {
+            auto& first(channelSamples[0]);
+            auto& second(channelSamples[1]);
+            for (uint32_t i(0u); i < blockSize; ++i)
+            {
+                if (channelAssignment == 8u) { second[i] = first[i] - second[i]; }
+                else if (channelAssignment == 9u) { first[i] += second[i]; }
+                else
+                {
+                    const int32_t side(second[i]);
+                    const int32_t mid((first[i] * 2) | (side & 1));
+                    first[i] = (mid + side) >> 1;
+                    second[i] = (mid - side) >> 1;
+                }
+            }
+        }
+
+        // Everything ends up as 16-bit, the same as the rest of the bank model
+        for (uint32_t i(0u); i < blockSize; ++i)
+        {
+            for (uint32_t channel(0u); channel < outNumChannels; ++channel)
+            {
+                const int32_t sample(channelSamples[channel][i]);
+                outSamples.emplace_back(static_cast<int16_t>(bitsPerSample > 16u ? sample >> (bitsPerSample - 16u)
+                    : sample << (16u - bitsPerSample)));
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,85 @@
+#include "Header/IO/MappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::filesystem::path& file)
+{
+    Close();
+
+#ifdef _WIN32
+    const HANDLE fileHandle(CreateFileW(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+    if (fileHandle == INVALID_HANDLE_VALUE) { return false; }
+    m_fileHandle = fileHandle;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+        Close();
+        return false;
+    }
+
+    m_mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mappingHandle == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    m_data = static_cast<const char*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd(open(file.c_str(), O_RDONLY));
+    if (fd < 0) { return false; }
+
+    struct stat fileStat{};
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    void* data(mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0));
+    close(fd);
+    if (data == MAP_FAILED) { return false; }
+
+    m_data = static_cast<const char*>(data);
+    m_size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+    if (m_data == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+    if (m_data != nullptr) { UnmapViewOfFile(m_data); }
+    if (m_mappingHandle != nullptr) { CloseHandle(m_mappingHandle); }
+    if (m_fileHandle != nullptr) { CloseHandle(m_fileHandle); }
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+#else
+    if (m_data != nullptr) { munmap(const_cast<char*>(m_data), m_size); }
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
@@ -3,7 +3,9 @@
 #include "Header/IO/BinaryReader.h"
 #include "Header/Logger.h"
 #include "Header/SF2/Helpers/SF2Helpers.h"
+#include "Header/SF2/Helpers/SF3Helpers.h"
 #include "Header/BankReadOptions.h"
+#include "Header/Profiler.h"
 #include "sf2cute/generator_item.hpp"
 #include "sf2cute/modulator.hpp"
 #include "sf2cute/types.hpp"
@@ -17,14 +19,37 @@
 #include "Dependencies/TinySoundFont/tsf.h"
 
 Soundbank SF2Reader::ProcessFile(const std::filesystem::path& file, const BankReadOptions& options)
+{
+    BinaryReader reader;
+    if(reader.readFile(file)) { return ProcessFile(reader, file, options); }
+
+    return Soundbank(file.filename().replace_extension("").string());
+}
+
+Soundbank SF2Reader::ProcessFile(BinaryReader& reader, const std::filesystem::path& file, const BankReadOptions& options)
 {
     Soundbank outResult(file.filename().replace_extension("").string());
     
-    BinaryReader reader;
-    if(reader.readFile(file))
+    if(!reader.GetData().empty())
     {
-        const auto& sf2Data(reader.GetData());
-        const tsf* sf2(tsf_load_memory(sf2Data.data(), static_cast<int>(sf2Data.size())));
+        // SF3 banks are decompressed into a plain SF2 image first
+        const auto& fileData(reader.GetData());
+        BinaryBuffer decompressedData{};
+        const bool isCompressed(SF3Helpers::IsCompressed(fileData.data(), fileData.size()));
+        if (isCompressed)
+        {
+            const Profiler::StageScope decodeScope(EProfileStage::SF3_DECODE);
+            if (!SF3Helpers::DecompressToSF2(fileData.data(), fileData.size(), decompressedData))
+            {
+                Logger::LogMessage("(Bank: '%s') Failed to decompress SF3 samples", outResult.m_bankName.c_str());
+                return outResult;
+            }
+        }
+
+        const Profiler::StageScope parseScope(EProfileStage::SF2_PARSE);
+
+        const auto& sf2Data(isCompressed ? decompressedData : fileData);
+        tsf* sf2(tsf_load_memory(sf2Data.data(), static_cast<int>(sf2Data.size())));
         assert(sf2 != nullptr);
         if (sf2 != nullptr)
         {
@@ -32,6 +57,7 @@ Soundbank SF2Reader::ProcessFile(const std::filesystem::path& file, const BankRe
             if (numPresets <= 0)
             {
                 Logger::LogMessage("(Bank: '%s') Preset count was <= 0", outResult.m_bankName.c_str());
+                tsf_close(sf2);
                 return outResult;
             }
 
@@ -357,6 +383,7 @@ Soundbank SF2Reader::ProcessFile(const std::filesystem::path& file, const BankRe
                     if(sampleType == sf2cute::SFSampleLink::kMonoSample)
                     {
                         std::vector sampleData(&sf2->samplesAsShort[shdr.start], &sf2->samplesAsShort[shdr.end]);
+                        Profiler::AddCounter(EProfileCounter::SAMPLES_PROCESSED, sampleData.size());
                         outResult.m_samples.emplace_back(sampleIndex, std::string(shdr.sampleName.data()),
                             std::move(sampleData), shdr.sampleRate, 1u, isLooping, isLoopReleasing, loopStart, loopEnd);
                     }
@@ -377,6 +404,8 @@ Soundbank SF2Reader::ProcessFile(const std::filesystem::path& file, const BankRe
 
                 ++sampleIndex;
             }
+
+            tsf_close(sf2);
         }
     }
     
@@ -3,215 +3,375 @@
 #include "Header/Logger.h"
 #include "Header/MathFunctions.h"
 #include "Header/SF2/Helpers/SF2Helpers.h"
+#include "Header/SF2/Helpers/SF3Helpers.h"
 #include "Header/BankWriteOptions.h"
+#include "Header/Parallel.h"
+#include "Header/Profiler.h"
+#include "Header/SF2/Data/SF2Hydra.h"
+#include <array>
 #include <filesystem>
 #include <cassert>
+#include <format>
 #include <fstream>
+#include <unordered_map>
+
+namespace
+{
+    constexpr std::string_view SF2_FORM_TYPE = "sfbk";
+    constexpr std::string_view SOUND_ENGINE = "EMU8000";
+    constexpr size_t MAX_INFO_TEXT_LEN = 255;
+
+    // Null terminated and padded to an even size
+    [[nodiscard]] size_t GetZSTRSize(const std::string_view text) { return (text.size() + 2) & ~size_t(1); }
+    [[nodiscard]] size_t GetZSTRChunkSize(const std::string_view text) { return SF2Helpers::RIFF_CHUNK_HEADER_SIZE + GetZSTRSize(text); }
+
+    void WriteZSTRChunk(std::ostream& stream, const std::string_view fourCC, const std::string_view text)
+    {
+        const auto size(GetZSTRSize(text));
+        SF2Helpers::WriteChunkHeader(stream, fourCC, static_cast<uint32_t>(size));
+        stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+
+        constexpr std::array<char, 2> padding{};
+        stream.write(padding.data(), static_cast<std::streamsize>(size - text.size()));
+    }
+}
 
 bool SF2Writer::WriteData(const Soundbank& soundbank, const BankWriteOptions& options) const
 {
-    const std::string convertedName(ConvertNameToSFName(soundbank.m_bankName));
+    auto savePath(options.m_saveFolder);
+    if (!savePath.empty() && std::filesystem::exists(savePath))
+    {
+        const auto sf2Path(savePath.append(std::filesystem::path(GetFileName(soundbank, options)).wstring()));
+        std::ofstream ofs(sf2Path, std::ios::binary);
+        return WriteData(soundbank, options, ofs);
+    }
+
+    return false;
+}
+
+bool SF2Writer::WriteData(const Soundbank& soundbank, const BankWriteOptions& options, std::ostream& stream) const
+{
+    Profiler::StageScope modelBuildScope(EProfileStage::SF2_MODEL_BUILD);
+
+    std::vector<std::vector<uint8_t>> compressedSamples{};
+    if (options.m_compressSamples)
+    {
+        const Profiler::StageScope encodeScope(EProfileStage::SF3_ENCODE);
+        compressedSamples = SF3Helpers::CompressSamples(soundbank.m_samples);
+    }
 
-    sf2cute::SoundFont sf2;
-    sf2.set_bank_name(convertedName);
-    sf2.set_sound_engine("EMU8000");
-    sf2.set_comment(std::format("Current preset is set to {0}", soundbank.m_defaultPreset));
+    SF2Hydra hydra;
+    hydra.Reserve(soundbank.m_presets.size(), soundbank.m_samples.size());
 
-    for (const auto& sample : soundbank.m_samples)
+    // Indexed like the bank's samples, stereo samples are not written so they have no shdr index
+    std::vector<int32_t> shdrIndices(soundbank.m_samples.size(), -1);
+    int32_t numShdrSamples(0);
+    size_t samplePoolSize(0);
+    size_t sampleStart(0);
+    bool hasCompressedSamples(false);
+    for (size_t i(0); i < soundbank.m_samples.size(); ++i)
     {
+        const auto& sample(soundbank.m_samples[i]);
         if (sample.m_channels != 1u)
         {
             Logger::LogMessage("Unable to support stereo samples (sample: %s)", sample.m_sampleName.c_str());
             continue;
         }
-        
-        sf2.NewSample(sample.m_sampleName, sample.m_sampleData, sample.m_loopStart,
-            sample.m_loopEnd, sample.m_sampleRate, 0ui8, 0i8);
+
+        // SF3: start and end are byte offsets into the sample pool, loop points are relative to the decoded sample
+        const bool isCompressed(!compressedSamples.empty() && !compressedSamples[i].empty());
+        const size_t sampleEnd(sampleStart + (isCompressed ? compressedSamples[i].size() : sample.m_sampleData.size()));
+        const size_t loopOffset(isCompressed ? 0 : sampleStart);
+        if (sampleEnd > UINT32_MAX || loopOffset + sample.m_loopEnd > UINT32_MAX)
+        {
+            Logger::LogMessage("Too much sample data to fit in an SF2 file!");
+            return false;
+        }
+
+        shdrIndices[i] = numShdrSamples++;
+        hydra.AddSample(sample.m_sampleName, static_cast<uint32_t>(sampleStart), static_cast<uint32_t>(sampleEnd),
+            static_cast<uint32_t>(loopOffset + sample.m_loopStart), static_cast<uint32_t>(loopOffset + sample.m_loopEnd), sample.m_sampleRate,
+            static_cast<uint16_t>(static_cast<uint16_t>(sf2cute::SFSampleLink::kMonoSample) | (isCompressed ? SF3Helpers::SAMPLE_TYPE_COMPRESSED : 0ui16)));
+
+        samplePoolSize += isCompressed ? compressedSamples[i].size() : sizeof(int16_t) * (sample.m_sampleData.size() + SF3Helpers::NUM_TERMINATOR_SAMPLES);
+        sampleStart = isCompressed ? sampleEnd : sampleEnd + SF3Helpers::NUM_TERMINATOR_SAMPLES;
+        hasCompressedSamples |= isCompressed;
+    }
+
+    // Each preset's instrument is built on its own, then they are added in preset order so the output matches building them one by one
+    std::vector<SF2InstrumentZones> instruments(soundbank.m_presets.size());
+    std::vector<uint64_t> instrumentHashes(soundbank.m_presets.size());
+    Parallel::For(soundbank.m_presets.size(), [&](const size_t presetIndex, uint32_t)
+    {
+        BuildInstrument(soundbank, soundbank.m_presets[presetIndex], shdrIndices, options, instruments[presetIndex]);
+        instrumentHashes[presetIndex] = instruments[presetIndex].GetHash();
+    });
+
+    // Presets with the same zones (velocity / volume variants etc.) share one instrument, named after the first preset using it
+    std::unordered_multimap<uint64_t, size_t> uniqueInstruments{};
+    std::vector<int32_t> sharedInstruments(soundbank.m_presets.size(), -1); // The preset whose instrument is used instead
+    size_t numZones(0);
+    size_t numModulators(0);
+    size_t numGenerators(0);
+    for (size_t presetIndex(0); presetIndex < soundbank.m_presets.size(); ++presetIndex)
+    {
+        const auto& zones(instruments[presetIndex]);
+        const auto [sameHashBegin, sameHashEnd](uniqueInstruments.equal_range(instrumentHashes[presetIndex]));
+        const auto sameInstrument(std::find_if(sameHashBegin, sameHashEnd, [&](const auto& other) { return instruments[other.second].HasSameZones(zones); }));
+        if (sameInstrument != sameHashEnd)
+        {
+            sharedInstruments[presetIndex] = static_cast<int32_t>(sameInstrument->second);
+            continue;
+        }
+
+        uniqueInstruments.emplace(instrumentHashes[presetIndex], presetIndex);
+        numZones += zones.m_bags.size();
+        numModulators += zones.m_modulators.size();
+        numGenerators += zones.m_generators.size();
+    }
+
+    hydra.ReserveZones(numZones, numModulators, numGenerators);
+
+    std::vector<uint16_t> instrumentIndices(soundbank.m_presets.size(), 0ui16);
+    for (size_t presetIndex(0); presetIndex < soundbank.m_presets.size(); ++presetIndex)
+    {
+        const auto& preset(soundbank.m_presets[presetIndex]);
+        const int32_t sharedPreset(sharedInstruments[presetIndex]);
+        instrumentIndices[presetIndex] = sharedPreset >= 0 ? instrumentIndices[sharedPreset] : hydra.AddInstrument(preset.m_presetName, instruments[presetIndex]);
+        hydra.AddPreset(preset.m_presetName, preset.m_index, 0ui16, instrumentIndices[presetIndex]);
     }
 
-    for (const auto& preset : soundbank.m_presets)
+    instruments.clear();
+
+    if (!hydra.Finish() || samplePoolSize > UINT32_MAX)
+    {
+        Logger::LogMessage("Too many presets, voices or samples to fit in an SF2 file!");
+        return false;
+    }
+
+    modelBuildScope.End();
+    const Profiler::StageScope riffWriteScope(EProfileStage::SF2_RIFF_WRITE);
+
+    const std::string bankName(ConvertNameToSFName(soundbank.m_bankName).substr(0, MAX_INFO_TEXT_LEN));
+    const std::string comment(std::format("Current preset is set to {0}", soundbank.m_defaultPreset).substr(0, MAX_INFO_TEXT_LEN));
+    const size_t infoListSize(SF2Helpers::RIFF_LIST_HEADER_SIZE + SF2Helpers::RIFF_CHUNK_HEADER_SIZE + sizeof(uint32_t) +
+        GetZSTRChunkSize(SOUND_ENGINE) + GetZSTRChunkSize(bankName) + GetZSTRChunkSize(comment));
+    const size_t sdtaListSize(SF2Helpers::RIFF_LIST_HEADER_SIZE + SF2Helpers::RIFF_CHUNK_HEADER_SIZE + samplePoolSize + samplePoolSize % 2);
+    const size_t riffSize(SF2_FORM_TYPE.size() + infoListSize + sdtaListSize + hydra.GetListSize());
+
+    const auto oldExceptions(stream.exceptions());
+    try
     {
-        std::vector<sf2cute::SFPresetZone> presetZones;
-        std::vector<sf2cute::SFInstrumentZone> instrumentZones;
-        for (const auto& voice : preset.m_voices)
+        stream.exceptions(std::ios::badbit | std::ios::failbit);
+
+        SF2Helpers::WriteChunkHeader(stream, "RIFF", static_cast<uint32_t>(riffSize));
+        stream.write(SF2_FORM_TYPE.data(), static_cast<std::streamsize>(SF2_FORM_TYPE.size()));
+
+        // SF3 (compressed samples) is marked by a major version of 3
+        SF2Helpers::WriteListHeader(stream, "INFO", static_cast<uint32_t>(infoListSize - SF2Helpers::RIFF_CHUNK_HEADER_SIZE));
+        const std::array<uint16_t, 2> version{hasCompressedSamples ? 3ui16 : 2ui16, 1ui16};
+        SF2Helpers::WriteChunkHeader(stream, "ifil", sizeof(version));
+        stream.write(reinterpret_cast<const char*>(version.data()), sizeof(version));
+        WriteZSTRChunk(stream, "isng", SOUND_ENGINE);
+        WriteZSTRChunk(stream, "INAM", bankName);
+        WriteZSTRChunk(stream, "ICMT", comment);
+
+        // The PCM is written straight from the bank, each sample followed by the terminator samples the spec asks for
+        SF2Helpers::WriteListHeader(stream, "sdta", static_cast<uint32_t>(sdtaListSize - SF2Helpers::RIFF_CHUNK_HEADER_SIZE));
+        SF2Helpers::WriteChunkHeader(stream, "smpl", static_cast<uint32_t>(samplePoolSize));
+        constexpr std::array<int16_t, SF3Helpers::NUM_TERMINATOR_SAMPLES> terminatorSamples{};
+        for (size_t i(0); i < soundbank.m_samples.size(); ++i)
         {
-            // Skip writing voices that have no sample index / banks that have no samples
-            if(soundbank.m_samples.empty() || voice.m_sampleIndex <= 0ui8)
+            if (shdrIndices[i] < 0) { continue; }
+
+            if (!compressedSamples.empty() && !compressedSamples[i].empty())
             {
+                stream.write(reinterpret_cast<const char*>(compressedSamples[i].data()), static_cast<std::streamsize>(compressedSamples[i].size()));
                 continue;
             }
 
-            const size_t sampleIndex(voice.m_sampleIndex - 1ui8);
-            const auto& sample(soundbank.m_samples.at(sampleIndex));
+            const auto& sampleData(soundbank.m_samples[i].m_sampleData);
+            stream.write(reinterpret_cast<const char*>(sampleData.data()), static_cast<std::streamsize>(sizeof(int16_t) * sampleData.size()));
+            stream.write(reinterpret_cast<const char*>(terminatorSamples.data()), sizeof(terminatorSamples));
+        }
 
-            uint16_t sampleMode(0ui16);
-            if (sample.m_isLooping) { sampleMode |= static_cast<uint16_t>(sf2cute::SampleMode::kLoopContinuously); }
-            if (sample.m_isLoopReleasing) { sampleMode |= 2ui16; }
+        if (samplePoolSize % 2 != 0) { stream.put('\0'); }
+
+        hydra.Write(stream);
+        stream.exceptions(oldExceptions);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        stream.exceptions(oldExceptions);
+        Logger::LogMessage(e.what());
+        return false;
+    }
+}
 
-            const auto& zoneRange(voice.m_keyZone);
-            const auto& velRange(voice.m_velocityZone);
+void SF2Writer::BuildInstrument(const Soundbank& soundbank, const BankPreset& preset, const std::vector<int32_t>& shdrIndices,
+    const BankWriteOptions& options, SF2InstrumentZones& outZones) const
+{
+    outZones.Reserve(preset.m_voices.size());
+    for (const auto& voice : preset.m_voices)
+    {
+        // Skip writing voices that have no sample index / banks that have no samples
+        if(soundbank.m_samples.empty() || voice.m_sampleIndex <= 0ui8)
+        {
+            continue;
+        }
 
-            sf2cute::SFInstrumentZone instrumentZone(sf2.samples()[sampleIndex], std::vector{
-                sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kKeyRange, sf2cute::RangesType(zoneRange.m_low, zoneRange.m_high)),
-                sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kVelRange, sf2cute::RangesType(velRange.m_low, velRange.m_high))
-            }, std::vector<sf2cute::SFModulatorItem>{});
+        // Stereo samples are not written, and this runs on a worker so a bad index is skipped rather than thrown
+        const size_t sampleIndex(voice.m_sampleIndex - 1ui8);
+        if (sampleIndex >= soundbank.m_samples.size() || shdrIndices[sampleIndex] < 0) { continue; }
 
-            const int8_t voiceVolBefore(voice.m_volume);
-            const int16_t voiceVolumeAbs(std::clamp(static_cast<int16_t>(std::abs(voiceVolBefore) * 10i16), 0i16, 144i16)); // Using abs on volume since SF2 does not support negative attenuation
-            if (voiceVolumeAbs != 0i16)
-            {
-                instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kInitialAttenuation, voiceVolumeAbs));
-            }
-            
-            if (voice.m_originalKey != 0ui8)
-            {
-                instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kOverridingRootKey, voice.m_originalKey));
-            }
+        const auto& sample(soundbank.m_samples[sampleIndex]);
 
-            if (sampleMode != 0ui16)
-            {
-                instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kSampleModes, static_cast<int16_t>(sampleMode)));
-            }
+        uint16_t sampleMode(0ui16);
+        if (sample.m_isLooping) { sampleMode |= static_cast<uint16_t>(sf2cute::SampleMode::kLoopContinuously); }
+        if (sample.m_isLoopReleasing) { sampleMode |= 2ui16; }
 
-            // Envelope
-            // TODO: Plot points from E4B onto an ADSR envelope and grab the time, since the time is inaccurate below (a binary value of 126 could be 2.1 sec, when it normally is say 80 sec)
+        const auto& zoneRange(voice.m_keyZone);
+        const auto& velRange(voice.m_velocityZone);
 
-            const auto& ampEnv(voice.m_ampEnv);
-            const int16_t ampDelaySec(SF2Helpers::secToTimecent(ampEnv.m_delaySec));
-            if (ampDelaySec != 0i16) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kDelayVolEnv, ampDelaySec)); }
+        outZones.BeginZone();
+        outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kKeyRange, sf2cute::RangesType(zoneRange.m_low, zoneRange.m_high)));
+        outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kVelRange, sf2cute::RangesType(velRange.m_low, velRange.m_high)));
 
-            const int16_t ampAttackSec(SF2Helpers::secToTimecent(ampEnv.m_attackSec));
-            if (ampAttackSec != 0i16) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kAttackVolEnv, ampAttackSec)); }
+        const int8_t voiceVolBefore(voice.m_volume);
+        const int16_t voiceVolumeAbs(std::clamp(static_cast<int16_t>(std::abs(voiceVolBefore) * 10i16), 0i16, 144i16)); // Using abs on volume since SF2 does not support negative attenuation
+        if (voiceVolumeAbs != 0i16)
+        {
+            outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kInitialAttenuation, voiceVolumeAbs));
+        }
+        
+        if (voice.m_originalKey != 0ui8)
+        {
+            outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kOverridingRootKey, voice.m_originalKey));
+        }
 
-            const int16_t ampHoldSec(SF2Helpers::secToTimecent(ampEnv.m_holdSec));
-            if (ampHoldSec != 0i16) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kHoldVolEnv, ampHoldSec)); }
+        if (sampleMode != 0ui16)
+        {
+            outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kSampleModes, static_cast<int16_t>(sampleMode)));
+        }
 
-            // Sustain Level is expressed in dB for Amp Env, and is also opposite because of SF2
-            const float ampSustainLevel(ampEnv.m_sustainDB);
-            if (ampSustainLevel < 100.f)
-            {
-                instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kSustainVolEnv,
-                    SF2Helpers::valueToRelativePercent(-(ampSustainLevel / 100.f * SF2Helpers::MAX_SUSTAIN_VOL_ENV) + SF2Helpers::MAX_SUSTAIN_VOL_ENV)));
-            }
+        // Envelope
+        // TODO: Plot points from E4B onto an ADSR envelope and grab the time, since the time is inaccurate below (a binary value of 126 could be 2.1 sec, when it normally is say 80 sec)
 
-            const int16_t ampDecaySec(SF2Helpers::secToTimecent(ampEnv.m_decaySec));
-            if (ampSustainLevel < 100.f && ampDecaySec != 0i16) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kDecayVolEnv, ampDecaySec)); }
+        const auto& ampEnv(voice.m_ampEnv);
+        const int16_t ampDelaySec(SF2Helpers::secToTimecent(ampEnv.m_delaySec));
+        if (ampDelaySec != 0i16) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kDelayVolEnv, ampDelaySec)); }
 
-            const int16_t ampReleaseSec(SF2Helpers::secToTimecent(ampEnv.m_releaseSec));
-            if (ampReleaseSec != 0i16) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kReleaseVolEnv, ampReleaseSec)); }
+        const int16_t ampAttackSec(SF2Helpers::secToTimecent(ampEnv.m_attackSec));
+        if (ampAttackSec != 0i16) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kAttackVolEnv, ampAttackSec)); }
 
-            /*
-             * Filter Env
-             */
+        const int16_t ampHoldSec(SF2Helpers::secToTimecent(ampEnv.m_holdSec));
+        if (ampHoldSec != 0i16) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kHoldVolEnv, ampHoldSec)); }
 
-            const auto& filterEnv(voice.m_filterEnv);
-            const int16_t filterAttackSec(SF2Helpers::secToTimecent(filterEnv.m_attackSec));
-            if (filterAttackSec != 0i16) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kAttackModEnv, filterAttackSec)); }
+        // Sustain Level is expressed in dB for Amp Env, and is also opposite because of SF2
+        const float ampSustainLevel(ampEnv.m_sustainDB);
+        if (ampSustainLevel < 100.f)
+        {
+            outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kSustainVolEnv,
+                SF2Helpers::valueToRelativePercent(-(ampSustainLevel / 100.f * SF2Helpers::MAX_SUSTAIN_VOL_ENV) + SF2Helpers::MAX_SUSTAIN_VOL_ENV)));
+        }
 
-            const int16_t filterDelaySec(SF2Helpers::secToTimecent(filterEnv.m_delaySec));
-            if (filterDelaySec != 0i16) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kDelayModEnv, filterDelaySec)); }
+        const int16_t ampDecaySec(SF2Helpers::secToTimecent(ampEnv.m_decaySec));
+        if (ampSustainLevel < 100.f && ampDecaySec != 0i16) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kDecayVolEnv, ampDecaySec)); }
 
-            const int16_t filterHoldSec(SF2Helpers::secToTimecent(filterEnv.m_holdSec));
-            if (filterHoldSec != 0i16) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kHoldModEnv, filterHoldSec)); }
+        const int16_t ampReleaseSec(SF2Helpers::secToTimecent(ampEnv.m_releaseSec));
+        if (ampReleaseSec != 0i16) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kReleaseVolEnv, ampReleaseSec)); }
 
-            // Opposite because of SF2
-            const float filterSustainLevel(filterEnv.m_sustainDB);
-            if (filterSustainLevel < 100.f) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kSustainModEnv,
-                SF2Helpers::valueToRelativePercent(-filterSustainLevel + 100.f))); }
+        /*
+         * Filter Env
+         */
 
-            const int16_t filterDecaySec(SF2Helpers::secToTimecent(filterEnv.m_decaySec));
-            if (filterSustainLevel < 100.f && filterDecaySec != 0i16) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kDecayModEnv, filterDecaySec)); }
+        const auto& filterEnv(voice.m_filterEnv);
+        const int16_t filterAttackSec(SF2Helpers::secToTimecent(filterEnv.m_attackSec));
+        if (filterAttackSec != 0i16) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kAttackModEnv, filterAttackSec)); }
 
-            const int16_t filterReleaseSec(SF2Helpers::secToTimecent(filterEnv.m_releaseSec));
-            if (filterReleaseSec != 0i16) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kReleaseModEnv, filterReleaseSec)); }
+        const int16_t filterDelaySec(SF2Helpers::secToTimecent(filterEnv.m_delaySec));
+        if (filterDelaySec != 0i16) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kDelayModEnv, filterDelaySec)); }
 
-            // Filters
+        const int16_t filterHoldSec(SF2Helpers::secToTimecent(filterEnv.m_holdSec));
+        if (filterHoldSec != 0i16) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kHoldModEnv, filterHoldSec)); }
 
-            const int16_t filterFreqCents(SF2Helpers::hertzToCents(voice.m_filterFrequency));
-            if (filterFreqCents >= SF2Helpers::SF2_FILTER_MIN_FREQ && filterFreqCents < SF2Helpers::SF2_FILTER_MAX_FREQ) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kInitialFilterFc, filterFreqCents)); }
-            
-            if (voice.m_filterQ > 0.f) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kInitialFilterQ,
-                SF2Helpers::valueToRelativePercent(voice.m_filterQ))); }
+        // Opposite because of SF2
+        const float filterSustainLevel(filterEnv.m_sustainDB);
+        if (filterSustainLevel < 100.f) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kSustainModEnv,
+            SF2Helpers::valueToRelativePercent(-filterSustainLevel + 100.f))); }
 
-            // LFO
+        const int16_t filterDecaySec(SF2Helpers::secToTimecent(filterEnv.m_decaySec));
+        if (filterSustainLevel < 100.f && filterDecaySec != 0i16) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kDecayModEnv, filterDecaySec)); }
 
-            const int16_t lfo1Freq(SF2Helpers::hertzToCents(voice.m_lfo1.m_rate));
-            if (lfo1Freq != 0i16) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kFreqModLFO, lfo1Freq)); }
+        const int16_t filterReleaseSec(SF2Helpers::secToTimecent(filterEnv.m_releaseSec));
+        if (filterReleaseSec != 0i16) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kReleaseModEnv, filterReleaseSec)); }
 
-            const int16_t lfo1Delay(SF2Helpers::secToTimecent(voice.m_lfo1.m_delay));
-            if (lfo1Delay != 0i16) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kDelayModLFO, lfo1Delay)); }
+        // Filters
 
-            if (options.m_useConverterSpecificData)
-            {
-                const uint8_t lfo1Shape(voice.m_lfo1.m_shape);
-                if (lfo1Shape != 0ui8) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kUnused3, lfo1Shape)); }
+        const int16_t filterFreqCents(SF2Helpers::hertzToCents(voice.m_filterFrequency));
+        if (filterFreqCents >= SF2Helpers::SF2_FILTER_MIN_FREQ && filterFreqCents < SF2Helpers::SF2_FILTER_MAX_FREQ) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kInitialFilterFc, filterFreqCents)); }
+        
+        if (voice.m_filterQ > 0.f) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kInitialFilterQ,
+            SF2Helpers::valueToRelativePercent(voice.m_filterQ))); }
 
-                const bool lfo1KeySync(voice.m_lfo1.m_keySync);
-                if (lfo1KeySync) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kUnused4, 1i16)); }
-            }
+        // LFO
 
-            // Realtime Controls
+        const int16_t lfo1Freq(SF2Helpers::hertzToCents(voice.m_lfo1.m_rate));
+        if (lfo1Freq != 0i16) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kFreqModLFO, lfo1Freq)); }
 
-            for(const auto& rtControl : voice.m_realtimeControls)
-            {
-                WriteModOrGen(instrumentZone, rtControl, options);
-            }
-            
-            // Amplifier / Oscillator
-            
-            if (voice.m_pan != 0i8) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kPan, SF2Helpers::valueToRelativePercent(voice.m_pan))); }
-            if (voice.m_fineTune != 0.) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kFineTune, static_cast<int16_t>(std::round(voice.m_fineTune)))); }
-            if (voice.m_coarseTune != 0i8) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kCoarseTune, voice.m_coarseTune)); }
-            
-            if (voice.m_chorusAmount > 0.f) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kChorusEffectsSend,
-                SF2Helpers::valueToRelativePercent(voice.m_chorusAmount))); }
+        const int16_t lfo1Delay(SF2Helpers::secToTimecent(voice.m_lfo1.m_delay));
+        if (lfo1Delay != 0i16) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kDelayModLFO, lfo1Delay)); }
 
-            // Other
+        if (options.m_useConverterSpecificData)
+        {
+            const uint8_t lfo1Shape(voice.m_lfo1.m_shape);
+            if (lfo1Shape != 0ui8) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kUnused3, lfo1Shape)); }
 
-            if (options.m_useConverterSpecificData)
-            {
-                if (voice.m_chorusWidth > 0.f) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kUnused5,
-                    SF2Helpers::valueToRelativePercent(voice.m_chorusWidth))); }
+            const bool lfo1KeySync(voice.m_lfo1.m_keySync);
+            if (lfo1KeySync) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kUnused4, 1i16)); }
+        }
 
-                const int32_t attenuationSign(voiceVolBefore > 0i8 ? 1 : voiceVolBefore < 0i8 ? -1 : 0);
-                if (attenuationSign != 0i16) { instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kUnused2,
-                    static_cast<int16_t>(attenuationSign))); }
-            }
+        // Realtime Controls
 
-            instrumentZones.emplace_back(instrumentZone);
+        for(const auto& rtControl : voice.m_realtimeControls)
+        {
+            WriteModOrGen(outZones, rtControl, options);
         }
+        
+        // Amplifier / Oscillator
+        
+        if (voice.m_pan != 0i8) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kPan, SF2Helpers::valueToRelativePercent(voice.m_pan))); }
+        if (voice.m_fineTune != 0.) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kFineTune, static_cast<int16_t>(std::round(voice.m_fineTune)))); }
+        if (voice.m_coarseTune != 0i8) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kCoarseTune, voice.m_coarseTune)); }
+        
+        if (voice.m_chorusAmount > 0.f) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kChorusEffectsSend,
+            SF2Helpers::valueToRelativePercent(voice.m_chorusAmount))); }
 
-        const auto& presetName(preset.m_presetName);
-        presetZones.emplace_back(sf2.NewInstrument(presetName, instrumentZones));
-        sf2.NewPreset(presetName, preset.m_index, 0ui16, presetZones);
-    }
+        // Other
 
-    try
-    {
-        auto savePath(options.m_saveFolder);
-        if (!savePath.empty() && std::filesystem::exists(savePath))
+        if (options.m_useConverterSpecificData)
         {
-            auto sf2Path(savePath.append(std::filesystem::path(convertedName + ".sf2").wstring()));
-            std::ofstream ofs(sf2Path, std::ios::binary);
-            sf2.Write(ofs);
-            return true;
+            if (voice.m_chorusWidth > 0.f) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kUnused5,
+                SF2Helpers::valueToRelativePercent(voice.m_chorusWidth))); }
+
+            const int32_t attenuationSign(voiceVolBefore > 0i8 ? 1 : voiceVolBefore < 0i8 ? -1 : 0);
+            if (attenuationSign != 0i16) { outZones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kUnused2,
+                static_cast<int16_t>(attenuationSign))); }
         }
-    }
-    catch (const std::fstream::failure& e)
-    {
-        Logger::LogMessage(e.what());
-        return false;
-    }
-    catch (const std::exception& e)
-    {
-        Logger::LogMessage(e.what());
-        return false;
+
+        outZones.EndZone(static_cast<uint16_t>(shdrIndices[sampleIndex]));
     }
 
-    return false;
+    outZones.HoistGlobalZone();
+}
+
+std::string SF2Writer::GetFileName(const Soundbank& soundbank, const BankWriteOptions& options) const
+{
+    return ConvertNameToSFName(soundbank.m_bankName) + (options.m_compressSamples ? ".sf3" : ".sf2");
 }
 
-void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const BankRealtimeControl& rtControl, const BankWriteOptions& options) const
+void SF2Writer::WriteModOrGen(SF2InstrumentZones& zones, const BankRealtimeControl& rtControl, const BankWriteOptions& options) const
 {
     // Don't write null controls
     if(rtControl.m_src == ERealtimeControlSrc::SRC_OFF && rtControl.m_dst == ERealtimeControlDst::DST_OFF)
@@ -254,7 +414,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                     const sf2cute::SFModulator fs1(sf2cute::SFMidiController::kHold, sf2cute::SFControllerDirection::kIncrease,
                         sf2cute::SFControllerPolarity::kUnipolar, sf2cute::SFControllerType::kLinear);
                     
-                    instrumentZone.SetModulator(sf2cute::SFModulatorItem(fs1, sf2cute::SFGenerator::kSustainVolEnv, static_cast<int16_t>(rtControl.m_amount),
+                    zones.SetModulator(sf2cute::SFModulatorItem(fs1, sf2cute::SFGenerator::kSustainVolEnv, static_cast<int16_t>(rtControl.m_amount),
                         sf2cute::SFModulator(), sf2cute::SFTransform::kAbsoluteValue));
                     
                     break;
@@ -281,7 +441,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                     const sf2cute::SFModulator velPos(sf2cute::SFGeneralController::kNoteOnVelocity, sf2cute::SFControllerDirection::kIncrease,
                         sf2cute::SFControllerPolarity::kUnipolar, sf2cute::SFControllerType::kLinear);
 
-                    instrumentZone.SetModulator(sf2cute::SFModulatorItem(velPos, sf2cute::SFGenerator::kInitialFilterQ, static_cast<int16_t>(rtControl.m_amount),
+                    zones.SetModulator(sf2cute::SFModulatorItem(velPos, sf2cute::SFGenerator::kInitialFilterQ, static_cast<int16_t>(rtControl.m_amount),
                         sf2cute::SFModulator(), sf2cute::SFTransform::kAbsoluteValue));
                     
                     break;
@@ -308,7 +468,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                     const sf2cute::SFModulator pressure(sf2cute::SFGeneralController::kChannelPressure, sf2cute::SFControllerDirection::kIncrease,
                         sf2cute::SFControllerPolarity::kUnipolar, sf2cute::SFControllerType::kLinear);
 
-                    instrumentZone.SetModulator(sf2cute::SFModulatorItem(pressure, sf2cute::SFGenerator::kAttackVolEnv, static_cast<int16_t>(rtControl.m_amount),
+                    zones.SetModulator(sf2cute::SFModulatorItem(pressure, sf2cute::SFGenerator::kAttackVolEnv, static_cast<int16_t>(rtControl.m_amount),
                         sf2cute::SFModulator(), sf2cute::SFTransform::kAbsoluteValue));
                     
                     break;
@@ -335,7 +495,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                     const sf2cute::SFModulator pitchWheel(sf2cute::SFGeneralController::kPitchWheel, sf2cute::SFControllerDirection::kIncrease,
                         sf2cute::SFControllerPolarity::kBipolar, sf2cute::SFControllerType::kLinear);
                     
-                    instrumentZone.SetModulator(sf2cute::SFModulatorItem(pitchWheel, sf2cute::SFGenerator::kFineTune, static_cast<int16_t>(std::roundf(rtControl.m_amount)),
+                    zones.SetModulator(sf2cute::SFModulatorItem(pitchWheel, sf2cute::SFGenerator::kFineTune, static_cast<int16_t>(std::roundf(rtControl.m_amount)),
                         sf2cute::SFModulator(), sf2cute::SFTransform::kAbsoluteValue));
                     
                     break;
@@ -362,7 +522,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                     const sf2cute::SFModulator modWheel(sf2cute::SFMidiController::kModulationDepth, sf2cute::SFControllerDirection::kIncrease,
                         sf2cute::SFControllerPolarity::kUnipolar, sf2cute::SFControllerType::kLinear);
 
-                    instrumentZone.SetModulator(sf2cute::SFModulatorItem(modWheel, sf2cute::SFGenerator::kInitialFilterFc,
+                    zones.SetModulator(sf2cute::SFModulatorItem(modWheel, sf2cute::SFGenerator::kInitialFilterFc,
                         SF2Helpers::filterFreqPercentToCents(rtControl.m_amount),
                         sf2cute::SFModulator(), sf2cute::SFTransform::kAbsoluteValue));
                     
@@ -375,7 +535,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                     const sf2cute::SFModulator modWheel(sf2cute::SFMidiController::kModulationDepth, sf2cute::SFControllerDirection::kIncrease,
                         sf2cute::SFControllerPolarity::kUnipolar, sf2cute::SFControllerType::kLinear);
 
-                    instrumentZone.SetModulator(sf2cute::SFModulatorItem(modWheel, sf2cute::SFGenerator::kVibLfoToPitch, static_cast<int16_t>(rtControl.m_amount),
+                    zones.SetModulator(sf2cute::SFModulatorItem(modWheel, sf2cute::SFGenerator::kVibLfoToPitch, static_cast<int16_t>(rtControl.m_amount),
                         sf2cute::SFModulator(), sf2cute::SFTransform::kAbsoluteValue));
                     
                     break;
@@ -399,7 +559,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                 case ERealtimeControlDst::FILTER_FREQ:
                 {
                     // LFO 1 ~ -> Filter Frequency
-                    instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kModLfoToFilterFc,
+                    zones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kModLfoToFilterFc,
                         SF2Helpers::filterFreqPercentToCents(rtControl.m_amount)));
 
                     break;
@@ -410,7 +570,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                     if (options.m_useConverterSpecificData)
                     {
                         // LFO 1 ~ -> Amp Pan
-                        instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kUnused1, static_cast<int16_t>(rtControl.m_amount)));
+                        zones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kUnused1, static_cast<int16_t>(rtControl.m_amount)));
                     }
                     
                     break;
@@ -420,14 +580,14 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                 {
                     // LFO 1 ~ -> Amp Volume
                     const int16_t cB(SF2Helpers::convert_dB_to_cB(rtControl.m_amount * SF2Helpers::MIN_MAX_LFO1_TO_VOLUME / 100.f)); // Converted to [-15, 15]
-                    instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kModLfoToVolume, cB));
+                    zones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kModLfoToVolume, cB));
                     break;
                 }
                 
                 case ERealtimeControlDst::PITCH:
                 {
                     // LFO 1 ~ -> Pitch
-                    instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kModLfoToPitch, static_cast<int16_t>(rtControl.m_amount)));
+                    zones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kModLfoToPitch, static_cast<int16_t>(rtControl.m_amount)));
                     break;
                 }
             }
@@ -449,7 +609,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                 case ERealtimeControlDst::FILTER_FREQ:
                 {
                     // Filter Env + -> Filter Frequency
-                    instrumentZone.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kModEnvToFilterFc,
+                    zones.SetGenerator(sf2cute::SFGeneratorItem(sf2cute::SFGenerator::kModEnvToFilterFc,
                         SF2Helpers::filterFreqPercentToCents(rtControl.m_amount)));
                     
                     break;
@@ -476,7 +636,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                     const sf2cute::SFModulator pedal(sf2cute::SFMidiController::kController4, sf2cute::SFControllerDirection::kIncrease,
                         sf2cute::SFControllerPolarity::kUnipolar, sf2cute::SFControllerType::kLinear);
 
-                    instrumentZone.SetModulator(sf2cute::SFModulatorItem(pedal, sf2cute::SFGenerator::kInitialAttenuation, static_cast<int16_t>(rtControl.m_amount),
+                    zones.SetModulator(sf2cute::SFModulatorItem(pedal, sf2cute::SFGenerator::kInitialAttenuation, static_cast<int16_t>(rtControl.m_amount),
                         sf2cute::SFModulator(), sf2cute::SFTransform::kAbsoluteValue));
                     
                     break;
@@ -503,7 +663,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                 case ERealtimeControlDst::AMP_VOLUME:
                 {
                     // Velocity < -> Amp Volume
-                    instrumentZone.SetModulator(sf2cute::SFModulatorItem(velLess, sf2cute::SFGenerator::kInitialAttenuation, static_cast<int16_t>(rtControl.m_amount),
+                    zones.SetModulator(sf2cute::SFModulatorItem(velLess, sf2cute::SFGenerator::kInitialAttenuation, static_cast<int16_t>(rtControl.m_amount),
                         sf2cute::SFModulator(), sf2cute::SFTransform::kAbsoluteValue));
                     
                     break;
@@ -512,7 +672,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                 case ERealtimeControlDst::FILTER_ENV_ATTACK:
                 {
                     // Velocity < -> Filter Env Attack
-                    instrumentZone.SetModulator(sf2cute::SFModulatorItem(velLess, sf2cute::SFGenerator::kAttackModEnv, static_cast<int16_t>(rtControl.m_amount),
+                    zones.SetModulator(sf2cute::SFModulatorItem(velLess, sf2cute::SFGenerator::kAttackModEnv, static_cast<int16_t>(rtControl.m_amount),
                         sf2cute::SFModulator(), sf2cute::SFTransform::kAbsoluteValue));
                     
                     break;
@@ -521,7 +681,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                 case ERealtimeControlDst::FILTER_FREQ:
                 {
                     // Velocity < -> Filter Freq
-                    instrumentZone.SetModulator(sf2cute::SFModulatorItem(velLess, sf2cute::SFGenerator::kInitialFilterFc,
+                    zones.SetModulator(sf2cute::SFModulatorItem(velLess, sf2cute::SFGenerator::kInitialFilterFc,
                         SF2Helpers::filterFreqPercentToCents(rtControl.m_amount),
                         sf2cute::SFModulator(), sf2cute::SFTransform::kAbsoluteValue));
                     
@@ -549,7 +709,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                     const sf2cute::SFModulator keyCenter(sf2cute::SFGeneralController::kNoteOnKeyNumber, sf2cute::SFControllerDirection::kIncrease,
                         sf2cute::SFControllerPolarity::kBipolar, sf2cute::SFControllerType::kLinear);
 
-                    instrumentZone.SetModulator(sf2cute::SFModulatorItem(keyCenter, sf2cute::SFGenerator::kInitialFilterFc,
+                    zones.SetModulator(sf2cute::SFModulatorItem(keyCenter, sf2cute::SFGenerator::kInitialFilterFc,
                         SF2Helpers::filterFreqPercentToCents(rtControl.m_amount),
                         sf2cute::SFModulator(), sf2cute::SFTransform::kAbsoluteValue));
                     
@@ -562,7 +722,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                     const sf2cute::SFModulator velCenter(sf2cute::SFGeneralController::kNoteOnVelocity, sf2cute::SFControllerDirection::kIncrease,
                         sf2cute::SFControllerPolarity::kBipolar, sf2cute::SFControllerType::kLinear);
 
-                    instrumentZone.SetModulator(sf2cute::SFModulatorItem(velCenter, sf2cute::SFGenerator::kPan, static_cast<int16_t>(rtControl.m_amount),
+                    zones.SetModulator(sf2cute::SFModulatorItem(velCenter, sf2cute::SFGenerator::kPan, static_cast<int16_t>(rtControl.m_amount),
                         sf2cute::SFModulator(), sf2cute::SFTransform::kAbsoluteValue));
                     
                     break;
@@ -590,7 +750,7 @@ void SF2Writer::WriteModOrGen(sf2cute::SFInstrumentZone& instrumentZone, const B
                         sf2cute::SFControllerDirection::kIncrease,
                         sf2cute::SFControllerPolarity::kUnipolar, sf2cute::SFControllerType::kLinear);
 
-                    instrumentZone.SetModulator(sf2cute::SFModulatorItem(midiA,
+                    zones.SetModulator(sf2cute::SFModulatorItem(midiA,
                         sf2cute::SFGenerator::kInitialAttenuation, static_cast<int16_t>(rtControl.m_amount),
                         sf2cute::SFModulator(), sf2cute::SFTransform::kAbsoluteValue));
                     
@@ -0,0 +1,295 @@
+#include "Header/IO/SFZWriter.h"
+#include "Header/BankWriteOptions.h"
+#include "Header/Data/Soundbank.h"
+#include "Header/IO/AsyncIO.h"
+#include "Header/IO/BinaryWriter.h"
+#include "Header/Logger.h"
+#include "Header/MathFunctions.h"
+#include "Header/Parallel.h"
+#include "Header/Profiler.h"
+#include "Header/SF2/Helpers/SF2Helpers.h"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <format>
+#include <mutex>
+
+bool SFZWriter::WriteData(const Soundbank& soundbank, const BankWriteOptions& options, AsyncIOBackend& ioBackend) const
+{
+    const Profiler::StageScope sfzWriteScope(EProfileStage::SFZ_WRITE);
+
+    if (options.m_saveFolder.empty() || !std::filesystem::exists(options.m_saveFolder))
+    {
+        Logger::LogMessage("Path was empty or did not exist.");
+        return false;
+    }
+
+    const auto bankFolder(options.m_saveFolder / GetFolderName(soundbank));
+    auto tempFolder(bankFolder);
+    tempFolder += SFZWriterStatics::TEMP_FOLDER_SUFFIX;
+
+    std::error_code errorCode;
+    std::filesystem::remove_all(tempFolder, errorCode);
+    std::filesystem::create_directories(tempFolder / SFZWriterStatics::SAMPLE_FOLDER_NAME, errorCode);
+    if (errorCode)
+    {
+        Logger::LogMessage("Failed to create '%s'", tempFolder.string().c_str());
+        return false;
+    }
+
+    std::mutex writeMutex;
+    std::condition_variable writeCondition;
+    size_t bytesInFlight(0);
+    size_t numWritesInFlight(0);
+    bool allWritten(true);
+
+    const auto submitWrite([&](const std::filesystem::path& file, BinaryBuffer&& data)
+    {
+        const size_t numBytes(data.size());
+        {
+            std::unique_lock uLock(writeMutex);
+            writeCondition.wait(uLock, [&] { return bytesInFlight == 0 || bytesInFlight + numBytes <= SFZWriterStatics::MAX_BYTES_IN_FLIGHT; });
+            bytesInFlight += numBytes;
+            ++numWritesInFlight;
+        }
+
+        ioBackend.SubmitWrite(file, std::move(data), [&, numBytes](const bool succeeded)
+        {
+            // Notified under the lock, the waiting thread may destroy all of this as soon as it wakes up
+            std::lock_guard lock(writeMutex);
+            bytesInFlight -= numBytes;
+            --numWritesInFlight;
+            if (!succeeded) { allWritten = false; }
+            writeCondition.notify_all();
+        });
+    });
+
+    // Samples are encoded in parallel and each one is handed to the backend as soon as it is ready
+    Parallel::For(soundbank.m_samples.size(), [&](const size_t i, uint32_t)
+    {
+        const auto& sample(soundbank.m_samples[i]);
+        submitWrite(tempFolder / SFZWriterStatics::SAMPLE_FOLDER_NAME / GetSampleFileName(sample, i), EncodeWAV(sample));
+    });
+
+    for (const auto& preset : soundbank.m_presets)
+    {
+        const auto sfz(WritePreset(soundbank, preset));
+        auto sfzData(BufferPool::GetSharedPool().Acquire(sfz.length()));
+        std::ranges::copy(sfz, sfzData.begin());
+        submitWrite(tempFolder / GetPresetFileName(preset), std::move(sfzData));
+    }
+
+    {
+        std::unique_lock uLock(writeMutex);
+        writeCondition.wait(uLock, [&] { return numWritesInFlight == 0; });
+    }
+
+    if (allWritten && ReplaceFolder(tempFolder, bankFolder)) { return true; }
+
+    std::filesystem::remove_all(tempFolder, errorCode);
+    Logger::LogMessage("Failed to write '%s'", bankFolder.string().c_str());
+    return false;
+}
+
+std::string SFZWriter::GetFolderName(const Soundbank& soundbank) const
+{
+    return ConvertNameToFileName(soundbank.m_bankName);
+}
+
+std::string SFZWriter::GetPresetFileName(const BankPreset& preset) const
+{
+    // The index keeps presets with the same name apart, and sorts them in bank order
+    return std::format("{:03} {}.sfz", preset.m_index, ConvertNameToFileName(preset.m_presetName));
+}
+
+std::string SFZWriter::GetSampleFileName(const BankSample& sample, const size_t sampleIndex) const
+{
+    return std::format("{:03} {}.wav", sampleIndex + 1, ConvertNameToFileName(sample.m_sampleName));
+}
+
+std::string SFZWriter::WritePreset(const Soundbank& soundbank, const BankPreset& preset) const
+{
+    std::string outSFZ(std::format("// {} - {}\n\n<control>\ndefault_path={}/\n", soundbank.m_bankName, preset.m_presetName,
+        SFZWriterStatics::SAMPLE_FOLDER_NAME));
+
+    for (const auto& voice : preset.m_voices)
+    {
+        // Skip writing voices that have no sample index / banks that have no samples
+        if (voice.m_sampleIndex <= 0ui16 || voice.m_sampleIndex > soundbank.m_samples.size()) { continue; }
+
+        WriteRegion(outSFZ, soundbank, voice);
+    }
+
+    return outSFZ;
+}
+
+void SFZWriter::WriteRegion(std::string& outSFZ, const Soundbank& soundbank, const BankVoice& voice) const
+{
+    const size_t sampleIndex(voice.m_sampleIndex - 1ui16);
+    const auto& sample(soundbank.m_samples[sampleIndex]);
+
+    // 'sample' is the only opcode that may contain spaces, so every opcode gets its own line
+    outSFZ += std::format("\n<region>\nsample={}\n", GetSampleFileName(sample, sampleIndex));
+    outSFZ += std::format("lokey={}\nhikey={}\nlovel={}\nhivel={}\n", voice.m_keyZone.m_low, voice.m_keyZone.m_high,
+        voice.m_velocityZone.m_low, voice.m_velocityZone.m_high);
+
+    if (voice.m_originalKey != 0ui8) { outSFZ += std::format("pitch_keycenter={}\n", voice.m_originalKey); }
+
+    // Loops (bank loop ends are exclusive like SF2, SFZ loop ends are inclusive)
+
+    if (sample.m_isLooping)
+    {
+        outSFZ += std::format("loop_mode={}\nloop_start={}\nloop_end={}\n", sample.m_isLoopReleasing ? "loop_sustain" : "loop_continuous",
+            sample.m_loopStart, sample.m_loopEnd > 0u ? sample.m_loopEnd - 1u : 0u);
+    }
+    else { outSFZ += "loop_mode=no_loop\n"; }
+
+    // Amplifier / Oscillator
+
+    if (voice.m_volume != 0i8) { outSFZ += std::format("volume={}\n", voice.m_volume); }
+    if (voice.m_pan != 0i8)
+    {
+        outSFZ += std::format("pan={:.1f}\n", std::clamp(static_cast<float>(voice.m_pan) * SFZWriterStatics::BANK_PAN_TO_SFZ, -100.f, 100.f));
+    }
+
+    if (voice.m_coarseTune != 0i8) { outSFZ += std::format("transpose={}\n", voice.m_coarseTune); }
+    if (voice.m_fineTune != 0.) { outSFZ += std::format("tune={}\n", static_cast<int32_t>(std::round(voice.m_fineTune))); }
+
+    // Envelopes (sustain levels are percentages in both the bank and SFZ)
+
+    const auto writeEnvelope([&outSFZ](const std::string_view& prefix, const ADSR_Envelope& env)
+    {
+        if (env.m_delaySec > 0.) { outSFZ += std::format("{}_delay={:.4f}\n", prefix, env.m_delaySec); }
+        if (env.m_attackSec > 0.) { outSFZ += std::format("{}_attack={:.4f}\n", prefix, env.m_attackSec); }
+        if (env.m_holdSec > 0.) { outSFZ += std::format("{}_hold={:.4f}\n", prefix, env.m_holdSec); }
+        if (env.m_sustainDB < ADSR_EnvelopeStatics::MAX_SUSTAIN_DB)
+        {
+            if (env.m_decaySec > 0.) { outSFZ += std::format("{}_decay={:.4f}\n", prefix, env.m_decaySec); }
+            outSFZ += std::format("{}_sustain={:.2f}\n", prefix, std::max(env.m_sustainDB, ADSR_EnvelopeStatics::MIN_ADSR));
+        }
+
+        if (env.m_releaseSec > 0.) { outSFZ += std::format("{}_release={:.4f}\n", prefix, env.m_releaseSec); }
+    });
+
+    writeEnvelope("ampeg", voice.m_ampEnv);
+
+    // Filter
+
+    const int16_t filterFreqCents(SF2Helpers::hertzToCents(voice.m_filterFrequency));
+    if (filterFreqCents >= SF2Helpers::SF2_FILTER_MIN_FREQ && filterFreqCents < SF2Helpers::SF2_FILTER_MAX_FREQ)
+    {
+        outSFZ += std::format("fil_type=lpf_2p\ncutoff={}\n", voice.m_filterFrequency);
+        if (voice.m_filterQ > 0.f)
+        {
+            const float resonanceDB(SF2Helpers::convert_cB_to_dB(SF2Helpers::valueToRelativePercent(voice.m_filterQ)));
+            outSFZ += std::format("resonance={:.1f}\n", std::min(resonanceDB, SFZWriterStatics::MAX_RESONANCE_DB));
+        }
+
+        writeEnvelope("fileg", voice.m_filterEnv);
+
+        float filterEnvAmount(0.f);
+        if (voice.GetAmountFromRTControl(ERealtimeControlSrc::FILTER_ENV_POLARITY_POS, ERealtimeControlDst::FILTER_FREQ, filterEnvAmount))
+        {
+            outSFZ += std::format("fileg_depth={}\n", SF2Helpers::filterFreqPercentToCents(filterEnvAmount));
+        }
+    }
+
+    // LFO 1, SFZ has a separate LFO per destination so each routing gets its own copy of the rate and delay
+
+    const auto writeLFO([&outSFZ, &voice](const std::string_view& prefix, const ERealtimeControlDst dst, const auto& toDepth)
+    {
+        float amount(0.f);
+        if (!voice.GetAmountFromRTControl(ERealtimeControlSrc::LFO1_POLARITY_CENTER, dst, amount)) { return; }
+
+        outSFZ += std::format("{0}_freq={1:.3f}\n{0}_depth={2}\n", prefix, voice.m_lfo1.m_rate, toDepth(amount));
+        if (voice.m_lfo1.m_delay > 0.) { outSFZ += std::format("{}_delay={:.4f}\n", prefix, voice.m_lfo1.m_delay); }
+    });
+
+    writeLFO("pitchlfo", ERealtimeControlDst::PITCH, [](const float amount) { return static_cast<int32_t>(amount); });
+    writeLFO("fillfo", ERealtimeControlDst::FILTER_FREQ, [](const float amount) { return SF2Helpers::filterFreqPercentToCents(amount); });
+    writeLFO("amplfo", ERealtimeControlDst::AMP_VOLUME, [](const float amount) { return amount * SF2Helpers::MIN_MAX_LFO1_TO_VOLUME / 100.f; });
+
+    // Realtime Controls
+
+    float pitchWheelAmount(0.f);
+    if (voice.GetAmountFromRTControl(ERealtimeControlSrc::PITCH_WHEEL, ERealtimeControlDst::PITCH, pitchWheelAmount))
+    {
+        const auto bendCents(static_cast<int32_t>(std::roundf(pitchWheelAmount)));
+        outSFZ += std::format("bend_up={}\nbend_down={}\n", bendCents, -bendCents);
+    }
+}
+
+BinaryBuffer SFZWriter::EncodeWAV(const BankSample& sample) const
+{
+    constexpr uint16_t PCM_FORMAT(1ui16);
+    constexpr uint16_t BITS_PER_SAMPLE(16ui16);
+    constexpr uint32_t FMT_CHUNK_SIZE(16u);
+
+    const auto numChannels(static_cast<uint16_t>(std::max(sample.m_channels, 1u)));
+    const auto blockAlign(static_cast<uint16_t>(numChannels * sizeof(int16_t)));
+    const uint32_t byteRate(sample.m_sampleRate * blockAlign);
+    const auto dataSize(static_cast<uint32_t>(sample.m_sampleData.size() * sizeof(int16_t)));
+    const uint32_t riffSize(4u + (8u + FMT_CHUNK_SIZE) + (8u + dataSize));
+
+    Profiler::AddCounter(EProfileCounter::SAMPLES_PROCESSED, sample.m_sampleData.size());
+
+    // WAV is little-endian like the platforms we build for, so fields are written as-is
+    BinaryWriter writer;
+    writer.writeType("RIFF", 4);
+    writer.writeType(&riffSize);
+    writer.writeType("WAVE", 4);
+
+    writer.writeType("fmt ", 4);
+    writer.writeType(&FMT_CHUNK_SIZE);
+    writer.writeType(&PCM_FORMAT);
+    writer.writeType(&numChannels);
+    writer.writeType(&sample.m_sampleRate);
+    writer.writeType(&byteRate);
+    writer.writeType(&blockAlign);
+    writer.writeType(&BITS_PER_SAMPLE);
+
+    writer.writeType("data", 4);
+    writer.writeType(&dataSize);
+    if (dataSize > 0u) { writer.writeType(sample.m_sampleData.data(), dataSize); }
+
+    return writer.TakeData();
+}
+
+std::string SFZWriter::ConvertNameToFileName(const std::string_view& name) const
+{
+    // Names come from the bank (and may be null-padded), keep only what every filesystem accepts
+    std::string outName(std::begin(name), std::ranges::find(name, '\0'));
+    std::ranges::replace_if(outName, [](const char c)
+    {
+        return static_cast<uint8_t>(c) < 0x20u || std::string_view("<>:\"/\\|?*").find(c) != std::string_view::npos;
+    }, '_');
+
+    while (!outName.empty() && (outName.back() == ' ' || outName.back() == '.')) { outName.pop_back(); }
+    return outName.empty() ? "Untitled" : outName;
+}
+
+bool SFZWriter::ReplaceFolder(const std::filesystem::path& tempFolder, const std::filesystem::path& bankFolder) const
+{
+    // The previous conversion of this bank is moved aside first and only deleted once the new folder is in place
+    auto oldFolder(bankFolder);
+    oldFolder += SFZWriterStatics::OLD_FOLDER_SUFFIX;
+
+    std::error_code errorCode;
+    const bool hadPrevious(std::filesystem::exists(bankFolder, errorCode));
+    if (hadPrevious)
+    {
+        std::filesystem::remove_all(oldFolder, errorCode);
+        std::filesystem::rename(bankFolder, oldFolder, errorCode);
+        if (errorCode) { return false; }
+    }
+
+    std::filesystem::rename(tempFolder, bankFolder, errorCode);
+    if (errorCode)
+    {
+        if (hadPrevious) { std::filesystem::rename(oldFolder, bankFolder, errorCode); }
+        return false;
+    }
+
+    if (hadPrevious) { std::filesystem::remove_all(oldFolder, errorCode); }
+    return true;
+}
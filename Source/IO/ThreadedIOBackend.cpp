@@ -0,0 +1,98 @@
+#include "Header/IO/ThreadedIOBackend.h"
+#include <algorithm>
+
+ThreadedIOBackend::ThreadedIOBackend(const uint32_t numThreads)
+{
+    for (uint32_t i(0u); i < std::max(numThreads, 1u); ++i)
+    {
+        m_threads.emplace_back([this] { ProcessRequests(); });
+    }
+}
+
+ThreadedIOBackend::~ThreadedIOBackend()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_isEnabled = false;
+    }
+
+    m_requestCondition.notify_all();
+    for (auto& thread : m_threads) { thread.join(); }
+}
+
+uint64_t ThreadedIOBackend::SubmitRead(const std::filesystem::path& file)
+{
+    uint64_t requestId(0u);
+    {
+        std::lock_guard lock(m_mutex);
+        requestId = m_nextRequestId++;
+        m_requests.push(IORequest{file, {}, {}, requestId, false});
+    }
+
+    m_requestCondition.notify_one();
+    return requestId;
+}
+
+bool ThreadedIOBackend::WaitRead(const uint64_t requestId, BinaryBuffer& outData)
+{
+    std::unique_lock uLock(m_mutex);
+    m_completeCondition.wait(uLock, [&] { return m_completedReads.contains(requestId); });
+
+    auto node(m_completedReads.extract(requestId));
+    outData = std::move(node.mapped().m_data);
+    return node.mapped().m_succeeded;
+}
+
+void ThreadedIOBackend::SubmitWrite(const std::filesystem::path& file, BinaryBuffer&& data, AsyncWriteCallback&& onComplete)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_requests.push(IORequest{file, std::move(data), std::move(onComplete), 0u, true});
+        ++m_numPendingWrites;
+    }
+
+    m_requestCondition.notify_one();
+}
+
+void ThreadedIOBackend::WaitForWrites()
+{
+    std::unique_lock uLock(m_mutex);
+    m_completeCondition.wait(uLock, [this] { return m_numPendingWrites == 0u; });
+}
+
+void ThreadedIOBackend::ProcessRequests()
+{
+    while (true)
+    {
+        std::unique_lock uLock(m_mutex);
+        m_requestCondition.wait(uLock, [this] { return !m_isEnabled || !m_requests.empty(); });
+
+        if (!m_isEnabled && m_requests.empty()) { break; }
+
+        auto request(std::move(m_requests.front()));
+        m_requests.pop();
+
+        // Do the actual I/O outside the lock
+        uLock.unlock();
+
+        if (request.m_isWrite)
+        {
+            const bool succeeded(AsyncIO::WriteWholeFile(request.m_file, request.m_data));
+            if (request.m_onComplete) { request.m_onComplete(succeeded); }
+
+            uLock.lock();
+            --m_numPendingWrites;
+        }
+        else
+        {
+            ReadResult result;
+            result.m_succeeded = AsyncIO::ReadWholeFile(request.m_file, result.m_data);
+
+            uLock.lock();
+            m_completedReads.emplace(request.m_requestId, std::move(result));
+        }
+
+        uLock.unlock();
+        m_completeCondition.notify_all();
+    }
+}
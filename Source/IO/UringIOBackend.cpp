@@ -0,0 +1,215 @@
+#include "Header/IO/UringIOBackend.h"
+
+#if HAS_IO_URING
+#include "Header/Logger.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace UringIOBackendStatics
+{
+    // Linux caps a single read/write at just under 2 GiB, anything larger is split over several SQEs
+    constexpr size_t MAX_TRANSFER_SIZE = 1024ull * 1024ull * 1024ull;
+}
+
+UringIOBackend::UringIOBackend(const uint32_t queueDepth)
+{
+    const int ret(io_uring_queue_init(queueDepth, &m_ring, 0u));
+    if (ret < 0)
+    {
+        Logger::LogMessage("io_uring_queue_init failed (%d)", ret);
+        return;
+    }
+
+    m_isValid = true;
+    m_completionThread = std::thread([this] { ProcessCompletions(); });
+}
+
+UringIOBackend::~UringIOBackend()
+{
+    if (!m_isValid) { return; }
+
+    WaitForWrites();
+
+    {
+        std::lock_guard lock(m_submitMutex);
+        io_uring_sqe* sqe(io_uring_get_sqe(&m_ring));
+        while (sqe == nullptr)
+        {
+            io_uring_submit(&m_ring);
+            sqe = io_uring_get_sqe(&m_ring);
+        }
+
+        // A NOP without a request wakes up the completion thread so it can exit
+        io_uring_prep_nop(sqe);
+        io_uring_sqe_set_data(sqe, nullptr);
+        io_uring_submit(&m_ring);
+    }
+
+    m_completionThread.join();
+    io_uring_queue_exit(&m_ring);
+}
+
+uint64_t UringIOBackend::SubmitRead(const std::filesystem::path& file)
+{
+    auto* request(new IORequest());
+    {
+        std::lock_guard lock(m_submitMutex);
+        request->m_requestId = m_nextRequestId++;
+    }
+
+    const auto requestId(request->m_requestId);
+    request->m_fileDescriptor = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+
+    struct stat fileStat{};
+    if (request->m_fileDescriptor < 0 || fstat(request->m_fileDescriptor, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        CompleteRequest(request, false);
+        return requestId;
+    }
+
+    request->m_data = BufferPool::GetSharedPool().Acquire(static_cast<size_t>(fileStat.st_size));
+    SubmitRequest(request);
+    return requestId;
+}
+
+bool UringIOBackend::WaitRead(const uint64_t requestId, BinaryBuffer& outData)
+{
+    std::unique_lock uLock(m_resultMutex);
+    m_completeCondition.wait(uLock, [&] { return m_completedReads.contains(requestId); });
+
+    auto node(m_completedReads.extract(requestId));
+    outData = std::move(node.mapped().m_data);
+    return node.mapped().m_succeeded;
+}
+
+void UringIOBackend::SubmitWrite(const std::filesystem::path& file, BinaryBuffer&& data, AsyncWriteCallback&& onComplete)
+{
+    {
+        std::lock_guard lock(m_resultMutex);
+        ++m_numPendingWrites;
+    }
+
+    auto* request(new IORequest());
+    request->m_data = std::move(data);
+    request->m_onComplete = std::move(onComplete);
+    request->m_isWrite = true;
+    request->m_fileDescriptor = open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (request->m_fileDescriptor < 0 || request->m_data.empty())
+    {
+        CompleteRequest(request, request->m_fileDescriptor >= 0);
+        return;
+    }
+
+    SubmitRequest(request);
+}
+
+void UringIOBackend::WaitForWrites()
+{
+    std::unique_lock uLock(m_resultMutex);
+    m_completeCondition.wait(uLock, [this] { return m_numPendingWrites == 0u; });
+}
+
+void UringIOBackend::SubmitRequest(IORequest* request)
+{
+    const size_t transferSize(std::min(request->m_data.size() - request->m_offset, UringIOBackendStatics::MAX_TRANSFER_SIZE));
+    char* transferData(std::next(request->m_data.data(), static_cast<std::ptrdiff_t>(request->m_offset)));
+
+    std::unique_lock uLock(m_submitMutex);
+    if (m_hasFailed)
+    {
+        uLock.unlock();
+        CompleteRequest(request, false);
+        return;
+    }
+
+    io_uring_sqe* sqe(io_uring_get_sqe(&m_ring));
+    while (sqe == nullptr)
+    {
+        // Submission queue is full, flush it to make room
+        io_uring_submit(&m_ring);
+        sqe = io_uring_get_sqe(&m_ring);
+    }
+
+    if (request->m_isWrite) { io_uring_prep_write(sqe, request->m_fileDescriptor, transferData, static_cast<unsigned>(transferSize), request->m_offset); }
+    else { io_uring_prep_read(sqe, request->m_fileDescriptor, transferData, static_cast<unsigned>(transferSize), request->m_offset); }
+
+    io_uring_sqe_set_data(sqe, request);
+    io_uring_submit(&m_ring);
+    m_submittedRequests.insert(request);
+}
+
+void UringIOBackend::CompleteRequest(IORequest* request, const bool succeeded)
+{
+    if (request->m_fileDescriptor >= 0) { close(request->m_fileDescriptor); }
+
+    if (request->m_isWrite)
+    {
+        if (request->m_onComplete) { request->m_onComplete(succeeded); }
+
+        std::lock_guard lock(m_resultMutex);
+        --m_numPendingWrites;
+    }
+    else
+    {
+        std::lock_guard lock(m_resultMutex);
+        m_completedReads.emplace(request->m_requestId, ReadResult{std::move(request->m_data), succeeded});
+    }
+
+    delete request;
+    m_completeCondition.notify_all();
+}
+
+void UringIOBackend::ProcessCompletions()
+{
+    while (true)
+    {
+        io_uring_cqe* cqe(nullptr);
+        const int waitResult(io_uring_wait_cqe(&m_ring, &cqe));
+        if (waitResult == -EINTR) { continue; }
+
+        if (waitResult < 0 || cqe == nullptr)
+        {
+            Logger::LogMessage("io_uring_wait_cqe failed (%d), failing outstanding I/O", waitResult);
+            FailOutstandingRequests();
+            break;
+        }
+
+        auto* request(static_cast<IORequest*>(io_uring_cqe_get_data(cqe)));
+        const int result(cqe->res);
+        io_uring_cqe_seen(&m_ring, cqe);
+
+        if (request == nullptr) { break; }
+
+        {
+            std::lock_guard lock(m_submitMutex);
+            m_submittedRequests.erase(request);
+        }
+
+        if (result <= 0)
+        {
+            CompleteRequest(request, false);
+            continue;
+        }
+
+        // Short transfers get resubmitted for the remainder
+        request->m_offset += static_cast<size_t>(result);
+        if (request->m_offset < request->m_data.size()) { SubmitRequest(request); }
+        else { CompleteRequest(request, true); }
+    }
+}
+
+void UringIOBackend::FailOutstandingRequests()
+{
+    std::unordered_set<IORequest*> outstandingRequests{};
+    {
+        std::lock_guard lock(m_submitMutex);
+        m_hasFailed = true;
+        outstandingRequests.swap(m_submittedRequests);
+    }
+
+    for (auto* request : outstandingRequests) { CompleteRequest(request, false); }
+}
+#endif
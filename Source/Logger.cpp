@@ -1,15 +1,28 @@
 ﻿#include "Header/Logger.h"
 
+#include <cstdio>
+
 #ifdef _WIN32
 #include <Windows.h>
 #endif
 
 void Logger::LogToPlatform(const std::string& msg)
 {
+    if (m_echoToStdout)
+    {
+        std::fputs(msg.c_str(), stdout);
+        std::fputc('\n', stdout);
+    }
+
 #ifdef _WIN32
     OutputDebugStringA(msg.c_str());
     OutputDebugStringA("\n");
 #else
-#error Platform logger not implemented!
+    // No debugger output elsewhere, stderr stands in unless the message already went to stdout
+    if (!m_echoToStdout)
+    {
+        std::fputs(msg.c_str(), stderr);
+        std::fputc('\n', stderr);
+    }
 #endif
 }
\ No newline at end of file
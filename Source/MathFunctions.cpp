@@ -33,8 +33,14 @@ float MathFunctions::round_f_places(const float value, const uint32_t places)
 	return std::ceilf(value * convertedPlace) / convertedPlace;
 }
 
-uint32_t MathFunctions::byteswapUINT32(const uint32_t value)
+uint64_t MathFunctions::hashFNV1a(const void* data, const size_t size, uint64_t hash)
 {
-    return ((value>>24) & 0xff) | ((value<<8) & 0xff0000) |
-        ((value>>8) & 0xff00) | ((value<<24) & 0xff000000);
+	const auto* bytes(static_cast<const uint8_t*>(data));
+	for(size_t i(0); i < size; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= FNV1A_PRIME;
+	}
+
+	return hash;
 }
\ No newline at end of file
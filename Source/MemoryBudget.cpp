@@ -0,0 +1,81 @@
+#include "Header/MemoryBudget.h"
+#include <algorithm>
+#include <cassert>
+
+bool MemoryBudget::Acquire(const size_t numBytes)
+{
+    std::unique_lock uLock(m_mutex);
+    m_condition.wait(uLock, [&] { return m_isCancelled || m_bytesInUse == 0 || m_bytesInUse + numBytes <= m_budgetBytes; });
+    if (m_isCancelled) { return false; }
+
+    m_bytesInUse += numBytes;
+    return true;
+}
+
+bool MemoryBudget::TryAcquire(const size_t numBytes)
+{
+    std::lock_guard lock(m_mutex);
+    if (m_isCancelled || (m_bytesInUse != 0 && m_bytesInUse + numBytes > m_budgetBytes)) { return false; }
+
+    m_bytesInUse += numBytes;
+    return true;
+}
+
+bool MemoryBudget::TryAcquireSpare(const size_t numBytes)
+{
+    std::lock_guard lock(m_mutex);
+    if (m_isCancelled || m_bytesInUse + m_spareBytes + numBytes > m_budgetBytes) { return false; }
+
+    m_spareBytes += numBytes;
+    return true;
+}
+
+void MemoryBudget::Release(const size_t numBytes)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        assert(numBytes <= m_bytesInUse);
+        m_bytesInUse -= std::min(numBytes, m_bytesInUse);
+    }
+
+    m_condition.notify_all();
+}
+
+void MemoryBudget::ReleaseSpare(const size_t numBytes)
+{
+    std::lock_guard lock(m_mutex);
+    assert(numBytes <= m_spareBytes);
+    m_spareBytes -= std::min(numBytes, m_spareBytes);
+}
+
+void MemoryBudget::Cancel()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_isCancelled = true;
+    }
+
+    m_condition.notify_all();
+}
+
+void MemoryBudget::Reset(const size_t budgetBytes)
+{
+    std::lock_guard lock(m_mutex);
+    m_budgetBytes = budgetBytes;
+    m_bytesInUse = 0;
+    m_spareBytes = 0;
+    m_isCancelled = false;
+}
+
+size_t MemoryBudget::GetBytesInUse() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_bytesInUse;
+}
+
+size_t MemoryBudget::GetSpareOverflow() const
+{
+    std::lock_guard lock(m_mutex);
+    const size_t totalBytes(m_bytesInUse + m_spareBytes);
+    return totalBytes > m_budgetBytes ? std::min(totalBytes - m_budgetBytes, m_spareBytes) : 0;
+}
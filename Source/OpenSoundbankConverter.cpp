@@ -7,6 +7,8 @@
 #include "Header/IO/BinaryWriter.h"
 #include "Header/Logger.h"
 #include "Header/BankConverter.h"
+#include "Header/CommandLine.h"
+#include "Header/Resampler.h"
 #include <fstream>
 #include <ShlObj_core.h>
 #include <tchar.h>
@@ -94,8 +96,6 @@ void E4BViewer::Render()
 	ImGui::SetNextWindowSize(windowSize);
 	if(ImGui::Begin("##main", nullptr, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoTitleBar))
 	{
-		if(!m_viewDetailsMenuOpen && !m_seqQueryMenuOpen) { m_tempResults.clear(); }
-
 		if(ImGui::BeginTabBar("##maintabbar"))
 		{
 			DisplayConverter(windowSize);
@@ -120,6 +120,13 @@ void E4BViewer::Render()
 
 int WINAPI WinMain(_In_ const HINSTANCE hInstance, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int)
 {
+    const auto args(WindowsPlatform::GetCommandLineArgs());
+    if (!args.empty())
+    {
+        WindowsPlatform::AttachParentConsole();
+        return CommandLine::Run(args);
+    }
+
     constexpr auto windowName(_T("OpenSoundbankConverterGUI"));
 
     const WNDCLASSEX wc{static_cast<UINT>(sizeof WNDCLASSEX), 0u, E4BViewer::WndProc,
@@ -256,7 +263,7 @@ void E4BViewer::DisplayConverter(const ImVec2& windowSize)
 {
     if (ImGui::BeginTabItem("Converter"))
     {
-        ImGui::BeginDisabled(m_threadPool.GetNumTasks() > 0);
+        ImGui::BeginDisabled(m_batchRunner.IsRunning());
 
         if (ImGui::BeginListBox("##banks", ImVec2(windowSize.x * 0.85f, windowSize.y * 0.75f)))
         {
@@ -280,11 +287,10 @@ void E4BViewer::DisplayConverter(const ImVec2& windowSize)
                         {
                             ImGui::CloseCurrentPopup();
                             
-                            if (m_tempResults.emplace_back(E4BReader::ProcessFile(file)).IsValid())
-                            {
-                                tempOpenVDMenu = true;
-                                m_viewDetailsMenuOpen = true;
-                            }
+                            m_viewDetailsFile = file;
+                            m_bankDetailsCache.Load(file);
+                            tempOpenVDMenu = true;
+                            m_viewDetailsMenuOpen = true;
                         }
 
                         ImGui::EndDisabled();
@@ -316,7 +322,7 @@ void E4BViewer::DisplayConverter(const ImVec2& windowSize)
 
         ImGui::SameLine();
 
-        ImGui::Text("Banks In Progress: %d", static_cast<int32_t>(m_threadPool.GetNumTasks()));
+        ImGui::Text("Banks In Progress: %d", static_cast<int32_t>(m_batchRunner.GetNumBanksInProgress()));
 
         if (!m_bankFiles.empty())
         {
@@ -331,16 +337,7 @@ void E4BViewer::DisplayConverter(const ImVec2& windowSize)
                 {
                     if (ImGui::Button("Sequence Query"))
                     {
-                        m_tempResults.clear();
-                        
-                        for(const auto& file : m_bankFiles)
-                        {
-                            if(std::filesystem::exists(file))
-                            {
-                                m_tempResults.emplace_back(E4BReader::ProcessFile(file));
-                            }
-                        }
-                        
+                        m_sequenceQuery.Start(m_bankFiles);
                         openSeqPopup = true;
                     }
 
@@ -368,7 +365,7 @@ void E4BViewer::DisplayConverter(const ImVec2& windowSize)
             ofn.hwndOwner = m_hwnd;
             ofn.lpstrFile = szFile.data();
             ofn.nMaxFile = MAX_PATH * MAX_FILES;
-            ofn.lpstrFilter = _T("Supported Files\0*.e4b;*.sf2");
+            ofn.lpstrFilter = _T("Supported Files\0*.e4b;*.sf2;*.sf3");
             ofn.Flags = OFN_ALLOWMULTISELECT | OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST | OFN_EXPLORER;
 
             if(GetOpenFileName(&ofn))
@@ -421,6 +418,12 @@ void E4BViewer::DisplayConverter(const ImVec2& windowSize)
 
             if (!m_bankFiles.empty()) { ImGui::EndDisabled(); }
 
+            if (ImGui::Selectable("SFZ", strCI(m_conversionType, "SFZ"))) { m_conversionType = "SFZ"; }
+            if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+            {
+                ImGui::SetTooltip("A folder per bank, with an .sfz per preset and the samples as separate WAV files.");
+            }
+
             ImGui::EndCombo();
         }
 
@@ -435,6 +438,7 @@ void E4BViewer::DisplayConverter(const ImVec2& windowSize)
                 m_writeOptions.m_saveFolder = WindowsPlatform::GetSaveFolder();
                 if (!m_writeOptions.m_saveFolder.empty())
                 {
+                    std::vector<ConversionJob> jobs{};
                     for (const auto& file : m_bankFiles)
                     {
                         if (exists(file))
@@ -444,42 +448,37 @@ void E4BViewer::DisplayConverter(const ImVec2& windowSize)
                             {
                                 if (strCI(m_conversionType, "SF2"))
                                 {
-                                    m_threadPool.queueFunc([&, file]
-                                    {
-                                        const auto result(E4BReader::ProcessFile(file));
-                                        if (result.IsValid())
-                                        {
-                                            if (BankConverter::CreateSF2(result, m_writeOptions))
-                                            {
-                                                Logger::LogMessage("Successfully converted to SF2!");
-                                            } 
-                                        }
-                                    });
+                                    jobs.emplace_back(file, EBankFormat::E4B, EBankFormat::SF2);
                                 }
+                                else if (strCI(m_conversionType, "SFZ"))
+                                {
+                                    jobs.emplace_back(file, EBankFormat::E4B, EBankFormat::SFZ);
+                                }
+                            }
+                            else if (strCI(ext, ".SF3") && strCI(m_conversionType, "SF2"))
+                            {
+                                jobs.emplace_back(file, EBankFormat::SF2, EBankFormat::SF2);
                             }
                             else
                             {
-                                if (strCI(ext, ".SF2"))
+                                if (strCI(ext, ".SF2") || strCI(ext, ".SF3"))
                                 {
                                     if (strCI(m_conversionType, "E4B"))
                                     {
-                                        m_threadPool.queueFunc([&, file]
-                                        {
-                                            const auto result(SF2Reader::ProcessFile(file, m_readOptions));
-                                            if (result.IsValid())
-                                            {
-                                                if (BankConverter::CreateE4B(result, m_writeOptions))
-                                                {
-                                                    Logger::LogMessage("Successfully converted to E4B!");
-                                                }
-                                            }
-                                        });
+                                        jobs.emplace_back(file, EBankFormat::SF2, EBankFormat::E4B);
+                                    }
+                                    else if (strCI(m_conversionType, "SFZ"))
+                                    {
+                                        jobs.emplace_back(file, EBankFormat::SF2, EBankFormat::SFZ);
                                     }
                                 }
                             }
                         }
                     }
 
+                    // Converting into the same folder again resumes from the manifest, skipping banks that are already done
+                    m_batchRunner.Start(m_writeOptions.m_saveFolder / BatchManifestStatics::DEFAULT_MANIFEST_NAME, std::move(jobs),
+                        m_readOptions, m_writeOptions);
                     m_queueClear = true;
                 }
             }
@@ -489,13 +488,21 @@ void E4BViewer::DisplayConverter(const ImVec2& windowSize)
 
         ImGui::EndDisabled();
 
-        if (m_queueClear && m_threadPool.GetNumTasks() == 0)
+        if (m_queueClear && !m_batchRunner.IsRunning())
         {
             m_queueClear = false;
-            m_bankFiles.clear();
-            m_conversionType.clear();
-            m_readOptions = {};
-            m_writeOptions = {};
+
+            // Keep failed banks in the list so they can be retried
+            const auto summary(m_batchRunner.Wait());
+            m_bankFiles = m_batchRunner.GetFailedInputs();
+            Logger::LogMessage("Converted: %u, skipped: %u, failed: %u", summary.m_numConverted, summary.m_numSkipped, summary.m_numFailed);
+
+            if (m_bankFiles.empty())
+            {
+                m_conversionType.clear();
+                m_readOptions = {};
+                m_writeOptions = {};
+            }
         }
 
         ImGui::EndTabItem();
@@ -504,177 +511,215 @@ void E4BViewer::DisplayConverter(const ImVec2& windowSize)
 
 void E4BViewer::DisplayBankInfoWindow(const std::string_view& popupName)
 {
-    if(m_tempResults.empty()) { return; }
-    const auto& bank(m_tempResults[0]);
+    if(m_viewDetailsFile.empty()) { return; }
     
     if (ImGui::BeginPopupModal(popupName.data(), &m_viewDetailsMenuOpen))
     {
-        if (ImGui::TreeNode("Presets"))
+        std::shared_ptr<const BankDetails> details;
+        const auto detailsState(m_bankDetailsCache.GetDetails(m_viewDetailsFile, details));
+        if (detailsState != EBankDetailsState::READY)
         {
-            int32_t presetIndex(0u);
-            for (auto& preset : bank.m_presets)
-            {
-                ImGui::PushID(presetIndex);
-                if (ImGui::TreeNode(std::string("P" + std::format("{:03}", preset.m_index) + " " + preset.m_presetName).c_str()))
-                {
-                    int32_t voiceIndex(1u);
-                    for (const auto& voice : preset.m_voices)
-                    {
-                        ImGui::PushID(voiceIndex);
-                        
-                        if (ImGui::TreeNode(std::string("Voice #" + std::to_string(voiceIndex)).c_str()))
-                        {
-                            const auto& zoneRange(voice.m_keyZone);
-                            const auto& velRange(voice.m_velocityZone);
-                            ImGui::Text("Original Key: %s", E4VoiceHelpers::GetMIDINoteFromKey(voice.m_originalKey).data());
-                            ImGui::Text("Zone Range: %s-%s", E4VoiceHelpers::GetMIDINoteFromKey(zoneRange.m_low).data(),
-                                E4VoiceHelpers::GetMIDINoteFromKey(zoneRange.m_high).data());
-                            ImGui::Text("Velocity Range: %u-%u", velRange.m_low, velRange.m_high);
-                            ImGui::Text("Filter Frequency: %d", voice.m_filterFrequency);
-                            ImGui::Text("Pan: %d", voice.m_pan);
-                            ImGui::Text("Volume: %d", voice.m_volume);
-                            ImGui::Text("Fine Tune: %f", voice.m_fineTune);
-
-                            ImGui::TreePop();
-                        }
+            if (detailsState == EBankDetailsState::FAILED) { ImGui::TextUnformatted("Unable to read this bank :("); }
+            else { ImGui::Text("Loading %s %c", m_viewDetailsFile.filename().string().c_str(), "|/-\\"[static_cast<int32_t>(ImGui::GetTime() * 8.) % 4]); }
 
-                        ImGui::PopID();
-                        ++voiceIndex;
-                    }
+            ImGui::EndPopup();
+            return;
+        }
 
-                    ImGui::TreePop();
-                }
+        if (m_bankDetailsView.GetBank() != details.get()) { m_bankDetailsView.SetBank(details); }
 
+        // Every row is one text line high, so only the rows in view are submitted
+        const auto& rows(m_bankDetailsView.GetRows());
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int32_t>(rows.size()), ImGui::GetTextLineHeightWithSpacing());
+        while (clipper.Step())
+        {
+            for (int32_t rowIndex(clipper.DisplayStart); rowIndex < clipper.DisplayEnd; ++rowIndex)
+            {
+                ImGui::PushID(rowIndex);
+                DisplayBankDetailsRow(*details, rows[rowIndex]);
                 ImGui::PopID();
-                ++presetIndex;
             }
-
-            ImGui::TreePop();
         }
 
-        if (ImGui::TreeNode("Samples"))
-        {
-            int32_t sampleIndex(0u);
-            for (const auto& sample : bank.m_samples)
-            {
-                ImGui::PushID(sampleIndex);
-                if (ImGui::TreeNode(sample.m_sampleName.c_str()))
-                {
-                    ImGui::Text("Sample Rate: %u", sample.m_sampleRate);
-                    ImGui::Text("Loop Start: %u", sample.m_loopStart);
-                    ImGui::Text("Loop End: %u", sample.m_loopEnd);
-                    ImGui::Text("Loop: %d", sample.m_isLooping ? 1 : 0);
-                    ImGui::Text("Release: %d", sample.m_isLoopReleasing ? 1 : 0);
-                    ImGui::Text("Sample Size: %zd", sample.m_sampleData.size());
+        ImGui::EndPopup();
+    }
+}
 
-                    ImGui::TreePop();
-                }
+void E4BViewer::DisplayBankDetailsRow(const BankDetails& details, const DetailsRow& row)
+{
+    const auto& bank(details.m_bank);
+    const float indent(static_cast<float>(row.m_depth) * ImGui::GetStyle().IndentSpacing);
+    if (indent > 0.f) { ImGui::Indent(indent); }
 
-                ImGui::PopID();
-                ++sampleIndex;
-            }
+    // Open state lives in the view, ImGui is only told what to draw
+    const auto treeNode([&row](const char* fmt, auto... args)
+    {
+        const bool isOpen(m_bankDetailsView.IsOpen(row));
+        ImGui::SetNextItemOpen(isOpen, ImGuiCond_Always);
+        if (ImGui::TreeNodeEx("##row", ImGuiTreeNodeFlags_NoTreePushOnOpen, fmt, args...) != isOpen) { m_bankDetailsView.SetOpen(row, !isOpen); }
+    });
 
-            ImGui::TreePop();
+    switch (row.m_type)
+    {
+    case EDetailsRowType::SECTION:
+        treeNode("%s", BankDetailsViewStatics::SECTION_NAMES[row.m_index]);
+        break;
+    case EDetailsRowType::PRESET:
+        treeNode("%s", details.m_presetLabels[row.m_index].c_str());
+        break;
+    case EDetailsRowType::VOICE:
+        treeNode("Voice #%u", row.m_subIndex + 1u);
+        break;
+    case EDetailsRowType::VOICE_INFO:
+    {
+        const auto& voice(bank.m_presets[row.m_index].m_voices[row.m_subIndex]);
+        const auto& zoneRange(voice.m_keyZone);
+        const auto& velRange(voice.m_velocityZone);
+        switch (row.m_line)
+        {
+        case 0ui16: ImGui::Text("Original Key: %s", E4VoiceHelpers::GetMIDINoteFromKey(voice.m_originalKey).data()); break;
+        case 1ui16: ImGui::Text("Zone Range: %s-%s", E4VoiceHelpers::GetMIDINoteFromKey(zoneRange.m_low).data(),
+            E4VoiceHelpers::GetMIDINoteFromKey(zoneRange.m_high).data()); break;
+        case 2ui16: ImGui::Text("Velocity Range: %u-%u", velRange.m_low, velRange.m_high); break;
+        case 3ui16: ImGui::Text("Filter Frequency: %d", voice.m_filterFrequency); break;
+        case 4ui16: ImGui::Text("Pan: %d", voice.m_pan); break;
+        case 5ui16: ImGui::Text("Volume: %d", voice.m_volume); break;
+        default: ImGui::Text("Fine Tune: %f", voice.m_fineTune); break;
         }
 
-        if (ImGui::TreeNode("Sequences"))
+        break;
+    }
+    case EDetailsRowType::SAMPLE:
+        treeNode("%s", bank.m_samples[row.m_index].m_sampleName.c_str());
+        break;
+    case EDetailsRowType::SAMPLE_INFO:
+    {
+        const auto& sample(bank.m_samples[row.m_index]);
+        switch (row.m_line)
         {
-            int32_t seqIndex(0u);
-            for (const auto& seq : bank.m_sequences)
-            {
-                ImGui::PushID(seqIndex);
+        case 0ui16: ImGui::Text("Sample Rate: %u", sample.m_sampleRate); break;
+        case 1ui16: ImGui::Text("Loop Start: %u", sample.m_loopStart); break;
+        case 2ui16: ImGui::Text("Loop End: %u", sample.m_loopEnd); break;
+        case 3ui16: ImGui::Text("Loop: %d", sample.m_isLooping ? 1 : 0); break;
+        case 4ui16: ImGui::Text("Release: %d", sample.m_isLoopReleasing ? 1 : 0); break;
+        default: ImGui::Text("Sample Size: %zd", details.m_sampleSizes[row.m_index]); break;
+        }
 
-                if (ImGui::TreeNode(seq.m_sequenceName.c_str()))
-                {
-                    if (ImGui::Button("Extract Sequence"))
-                    {
-                        auto seqPathTemp(seq.m_sequenceName);
-                        seqPathTemp.resize(MAX_PATH);
-
-                        OPENFILENAMEA ofn{};
-                        ofn.lStructSize = sizeof ofn;
-                        ofn.hwndOwner = nullptr;
-                        ofn.lpstrFilter = ".mid";
-                        ofn.lpstrFile = seqPathTemp.data();
-                        ofn.nMaxFile = MAX_PATH;
-                        ofn.Flags = OFN_EXPLORER;
-                        ofn.lpstrDefExt = "mid";
-
-                        if (GetSaveFileNameA(&ofn) != 0)
-                        {
-                            std::filesystem::path seqPath(seqPathTemp);
-                            BinaryWriter writer(seqPath);
+        break;
+    }
+    case EDetailsRowType::SEQUENCE:
+        treeNode("%s", bank.m_sequences[row.m_index].m_sequenceName.c_str());
+        break;
+    case EDetailsRowType::SEQUENCE_EXTRACT:
+    {
+        const auto& seq(bank.m_sequences[row.m_index]);
 
-                            const auto& seqData(seq.m_midiData);
-                            writer.writeType(seqData.data(), sizeof(char) * seqData.size());
+        // Small so the row stays one text line high
+        if (ImGui::SmallButton("Extract Sequence"))
+        {
+            auto seqPathTemp(seq.m_sequenceName);
+            seqPathTemp.resize(MAX_PATH);
 
-                            if (!writer.finishWriting())
-                            {
-                                Logger::LogMessage("Failed to extract sequence '%s'!", seq.m_sequenceName.c_str());
-                            }
-                            else
-                            {
-                                Logger::LogMessage("Sequence '%s' saved to '%ws'!", seq.m_sequenceName.c_str(), seqPath.c_str());
-                            }
-                        }
-                    }
+            OPENFILENAMEA ofn{};
+            ofn.lStructSize = sizeof ofn;
+            ofn.hwndOwner = nullptr;
+            ofn.lpstrFilter = ".mid";
+            ofn.lpstrFile = seqPathTemp.data();
+            ofn.nMaxFile = MAX_PATH;
+            ofn.Flags = OFN_EXPLORER;
+            ofn.lpstrDefExt = "mid";
 
-                    ImGui::TreePop();
-                }
+            if (GetSaveFileNameA(&ofn) != 0)
+            {
+                std::filesystem::path seqPath(seqPathTemp);
+                BinaryWriter writer(seqPath);
 
-                ImGui::PopID();
-                ++seqIndex;
-            }
+                const auto& seqData(seq.m_midiData);
+                writer.writeType(seqData.data(), sizeof(char) * seqData.size());
 
-            ImGui::TreePop();
+                if (!writer.finishWriting())
+                {
+                    Logger::LogMessage("Failed to extract sequence '%s'!", seq.m_sequenceName.c_str());
+                }
+                else
+                {
+                    Logger::LogMessage("Sequence '%s' saved to '%ws'!", seq.m_sequenceName.c_str(), seqPath.c_str());
+                }
+            }
         }
 
-        ImGui::EndPopup();
+        break;
     }
+    }
+
+    if (indent > 0.f) { ImGui::Unindent(indent); }
 }
 
 void E4BViewer::DisplaySeqQueryPopup()
 {
     if(ImGui::BeginPopupModal(SEQ_QUERY_POPUP_NAME.data(), &m_seqQueryMenuOpen))
     {
+        if (m_sequenceQuery.IsRunning())
+        {
+            const auto numFiles(m_sequenceQuery.GetNumFiles()), numFilesDone(m_sequenceQuery.GetNumFilesDone());
+            const auto progressStr(std::to_string(numFilesDone) + " / " + std::to_string(numFiles) + " banks");
+            ImGui::ProgressBar(numFiles > 0u ? static_cast<float>(numFilesDone) / static_cast<float>(numFiles) : 0.f, ImVec2(-1.f, 0.f), progressStr.c_str());
+        }
+
+        ImGui::InputText("Sequence Name", m_seqQueryFilter.data(), m_seqQueryFilter.size());
+        const std::string_view filter(m_seqQueryFilter.data());
+        const auto matchesFilter([&filter](const BankSequence& seq)
+        {
+            return std::search(seq.m_sequenceName.begin(), seq.m_sequenceName.end(), filter.begin(), filter.end(),
+                [](const char a, const char b) { return std::tolower(static_cast<uint8_t>(a)) == std::tolower(static_cast<uint8_t>(b)); }) != seq.m_sequenceName.end();
+        });
+
         bool foundSequences(false);
-        for(const auto& bank : m_tempResults)
+        for(const auto& result : m_sequenceQuery.GetResults())
         {
-            if(bank.IsValid() && !bank.m_sequences.empty())
+            const auto numMatches(std::ranges::count_if(result->m_sequences, matchesFilter));
+            if(numMatches == 0) { continue; }
+
+            if (ImGui::TreeNode(result->m_file.string().c_str(), "%s", result->m_bankName.c_str()))
             {
-                if (ImGui::TreeNode(bank.m_bankName.c_str()))
+                for(const auto& seq : result->m_sequences)
+                {
+                    if (matchesFilter(seq)) { ImGui::BulletText("%s (%zu bytes)", seq.m_sequenceName.c_str(), seq.m_midiData.size()); }
+                }
+
+                if(ImGui::Button(std::string("Extract " + std::to_string(numMatches) + " Sequences").c_str()))
                 {
-                    if(ImGui::Button(std::string("Extract " + std::to_string(bank.m_sequences.size()) + " Sequences").c_str()))
+                    const auto saveFolder(WindowsPlatform::GetSaveFolder());
+                
+                    for(const auto& seq : result->m_sequences)
                     {
-                        const auto saveFolder(WindowsPlatform::GetSaveFolder());
-                    
-                        for(const auto& seq : bank.m_sequences)
-                        {
-                            const auto path(std::filesystem::path(saveFolder).append(seq.m_sequenceName + ".mid"));
-                            BinaryWriter writer(path);
+                        if (!matchesFilter(seq)) { continue; }
 
-                            const auto& seqData(seq.m_midiData);
-                            writer.writeType(seqData.data(), sizeof(char) * seqData.size());
+                        const auto path(std::filesystem::path(saveFolder).append(seq.m_sequenceName + ".mid"));
+                        BinaryWriter writer(path);
 
-                            if (!writer.finishWriting())
-                            {
-                                Logger::LogMessage("Failed to extract sequence '%s'!", seq.m_sequenceName.c_str());
-                            }
-                            else
-                            {
-                                Logger::LogMessage("Sequence '%s' saved to '%ws'!", seq.m_sequenceName.c_str(), path.c_str());
-                            }
+                        const auto& seqData(seq.m_midiData);
+                        writer.writeType(seqData.data(), sizeof(char) * seqData.size());
+
+                        if (!writer.finishWriting())
+                        {
+                            Logger::LogMessage("Failed to extract sequence '%s'!", seq.m_sequenceName.c_str());
+                        }
+                        else
+                        {
+                            Logger::LogMessage("Sequence '%s' saved to '%ws'!", seq.m_sequenceName.c_str(), path.c_str());
                         }
                     }
-                    
-                    ImGui::TreePop();
                 }
-
-                foundSequences = true;
+                
+                ImGui::TreePop();
             }
+
+            foundSequences = true;
         }
 
-        if(!foundSequences)
+        if(!foundSequences && !m_sequenceQuery.IsRunning())
         {
             ImGui::TextUnformatted("Found no sequences :(");
         }
@@ -749,6 +794,49 @@ void E4BViewer::DisplayOptions()
                 {
                     ImGui::SetTooltip("Uses specific conversion data from E4BViewer, allowing for more accurate data.");
                 }
+
+                constexpr uint32_t minMemoryBudgetMB(64u);
+                constexpr uint32_t maxMemoryBudgetMB(16384u);
+                ImGui::SliderScalar("Memory Budget (MB)", ImGuiDataType_U32, &m_writeOptions.m_memoryBudgetMB, &minMemoryBudgetMB, &maxMemoryBudgetMB);
+                if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+                {
+                    ImGui::SetTooltip("Maximum memory used by banks being converted at once. A bank larger than this is still converted, but on its own.");
+                }
+
+                ImGui::Checkbox("Compress Samples (SF3)", &m_writeOptions.m_compressSamples);
+                if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+                {
+                    ImGui::SetTooltip("SF2 output is written as a lossless FLAC compressed .sf3, which is several times smaller.");
+                }
+
+                ImGui::Checkbox("Trim Silence", &m_writeOptions.m_trimSilence);
+                if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+                {
+                    ImGui::SetTooltip("Strips leading and trailing silence from samples, loop points are moved to match and loops are never cut.");
+                }
+
+                const auto sampleRateLabel(m_writeOptions.m_targetSampleRate == 0u ? std::string("Original") : std::to_string(m_writeOptions.m_targetSampleRate));
+                if (ImGui::BeginCombo("Sample Rate", sampleRateLabel.c_str()))
+                {
+                    if (ImGui::Selectable("Original", m_writeOptions.m_targetSampleRate == 0u)) { m_writeOptions.m_targetSampleRate = 0u; }
+                    for (const uint32_t sampleRate : ResamplerStatics::SUPPORTED_RATES)
+                    {
+                        if (ImGui::Selectable(std::to_string(sampleRate).c_str(), m_writeOptions.m_targetSampleRate == sampleRate)) { m_writeOptions.m_targetSampleRate = sampleRate; }
+                    }
+
+                    ImGui::EndCombo();
+                }
+
+                if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+                {
+                    ImGui::SetTooltip("Resamples every sample at another rate, loop points and tuning are adjusted to match.");
+                }
+
+                ImGui::Checkbox("Export Profiles", &m_writeOptions.m_exportProfiles);
+                if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+                {
+                    ImGui::SetTooltip("Writes the time spent in each conversion stage for every bank, as JSON and as a Chrome trace.");
+                }
                 
                 ImGui::EndTabItem();
             }
@@ -781,6 +869,7 @@ void E4BViewer::DisplayConsole()
             if (GetSaveFileName(&ofn))
             {
                 std::ofstream ofs(ofn.lpstrFile, std::ios::binary);
+                const auto logLock(Logger::LockLogMessages());
                 for(const auto& msg : Logger::GetLogMessages()) 
                 {
                     ofs.write(msg.c_str(), static_cast<std::streamsize>(msg.length()));
@@ -791,6 +880,7 @@ void E4BViewer::DisplayConsole()
 
         if(ImGui::BeginListBox("##console", {-1.f, -1.f}))
         {
+            const auto logLock(Logger::LockLogMessages());
             for(const auto& msg : Logger::GetLogMessages()) 
             {
                 ImGui::TextUnformatted(msg.c_str(), msg.data() + msg.length());
@@ -0,0 +1,150 @@
+#include "Header/Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct ParallelJob final
+    {
+        ParallelJob(const std::function<void(size_t, uint32_t)>& func, const size_t count, const uint32_t numWorkers) : m_func(func), m_count(count), m_numWorkers(numWorkers) {}
+
+        // Pulls indices until none are left, the first exception stops everyone from taking more
+        void Run(const uint32_t workerIndex)
+        {
+            try
+            {
+                for (size_t index(m_nextIndex++); index < m_count; index = m_nextIndex++) { m_func(index, workerIndex); }
+            }
+            catch (...)
+            {
+                std::lock_guard lock(m_exceptionMutex);
+                if (!m_exception) { m_exception = std::current_exception(); }
+                m_nextIndex = m_count;
+            }
+        }
+
+        [[nodiscard]] bool HasWork() const { return m_nextIndex < m_count; }
+
+        const std::function<void(size_t, uint32_t)>& m_func;
+        const size_t m_count;
+        const uint32_t m_numWorkers;
+        std::atomic<size_t> m_nextIndex{0};
+
+        // Guarded by the pool mutex, the caller is worker 0
+        uint32_t m_numJoined = 1u;
+        uint32_t m_numActiveHelpers = 0u;
+
+        std::mutex m_exceptionMutex;
+        std::exception_ptr m_exception{};
+    };
+
+    /*
+     * One set of threads shared by every Parallel::For, including nested ones started from inside a task or a pipeline worker.
+     * Callers always work through their own job, so a caller only ever waits on helpers that are already running and nesting cannot deadlock.
+     */
+    struct WorkerPool final
+    {
+        explicit WorkerPool(const uint32_t numThreads)
+        {
+            m_threads.reserve(numThreads);
+            for (uint32_t i(0u); i < numThreads; ++i) { m_threads.emplace_back([this] { WorkerLoop(); }); }
+        }
+
+        ~WorkerPool()
+        {
+            {
+                std::lock_guard lock(m_mutex);
+                m_isStopping = true;
+            }
+
+            m_workAvailable.notify_all();
+            for (auto& thread : m_threads) { thread.join(); }
+        }
+
+        WorkerPool(WorkerPool const&) = delete; WorkerPool& operator=(const WorkerPool&) = delete;
+
+        [[nodiscard]] uint32_t GetNumThreads() const { return static_cast<uint32_t>(m_threads.size()); }
+
+        void Run(ParallelJob& job)
+        {
+            {
+                std::lock_guard lock(m_mutex);
+                m_jobs.emplace_back(&job);
+            }
+
+            for (uint32_t i(1u); i < job.m_numWorkers; ++i) { m_workAvailable.notify_one(); }
+
+            job.Run(0u);
+
+            // Once the job is off the list no helper can join, only the ones still running are waited on
+            std::unique_lock lock(m_mutex);
+            std::erase(m_jobs, &job);
+            m_helperDone.wait(lock, [&job] { return job.m_numActiveHelpers == 0u; });
+        }
+
+    private:
+        void WorkerLoop()
+        {
+            std::unique_lock lock(m_mutex);
+            while (true)
+            {
+                m_workAvailable.wait(lock, [this] { return m_isStopping || !m_jobs.empty(); });
+                if (m_isStopping) { break; }
+
+                // Drained jobs only wait on their helpers now, they are dropped so a later job is not starved
+                std::erase_if(m_jobs, [](const ParallelJob* job) { return !job->HasWork(); });
+                if (m_jobs.empty()) { continue; }
+
+                ParallelJob* job(m_jobs.front());
+                const uint32_t workerIndex(job->m_numJoined++);
+                ++job->m_numActiveHelpers;
+                if (job->m_numJoined == job->m_numWorkers) { m_jobs.erase(m_jobs.begin()); }
+
+                lock.unlock();
+                job->Run(workerIndex);
+                lock.lock();
+
+                if (--job->m_numActiveHelpers == 0u) { m_helperDone.notify_all(); }
+            }
+        }
+
+        std::mutex m_mutex;
+        std::condition_variable m_workAvailable;
+        std::condition_variable m_helperDone;
+        std::vector<ParallelJob*> m_jobs{}; // Jobs still taking helpers, oldest first
+        std::vector<std::thread> m_threads{};
+        bool m_isStopping = false;
+    };
+
+    WorkerPool& GetWorkerPool()
+    {
+        // The caller is the remaining worker
+        static WorkerPool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1u);
+        return pool;
+    }
+}
+
+uint32_t Parallel::GetNumWorkers(const size_t count)
+{
+    return static_cast<uint32_t>(std::clamp<size_t>(count, 1, GetWorkerPool().GetNumThreads() + 1u));
+}
+
+void Parallel::For(const size_t count, const std::function<void(size_t, uint32_t)>& func)
+{
+    const uint32_t numWorkers(GetNumWorkers(count));
+    if (numWorkers == 1u)
+    {
+        for (size_t i(0); i < count; ++i) { func(i, 0u); }
+        return;
+    }
+
+    ParallelJob job(func, count, numWorkers);
+    GetWorkerPool().Run(job);
+
+    if (job.m_exception) { std::rethrow_exception(job.m_exception); }
+}
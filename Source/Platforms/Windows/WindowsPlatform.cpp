@@ -1,6 +1,8 @@
 ﻿#include "Header/Platforms/Windows/WindowsPlatform.h"
 #include <array>
+#include <cstdio>
 #include <ShlObj_core.h>
+#include <shellapi.h>
 #include <tchar.h>
 
 std::filesystem::path WindowsPlatform::GetSaveFolder()
@@ -56,4 +58,40 @@ std::filesystem::path WindowsPlatform::GetSavePath(const std::string_view& filen
     }
 
     return std::filesystem::path();
+}
+
+std::vector<std::string> WindowsPlatform::GetCommandLineArgs()
+{
+    std::vector<std::string> outArgs{};
+
+    int numArgs(0);
+    LPWSTR* argList(CommandLineToArgvW(GetCommandLineW(), &numArgs));
+    if (argList == nullptr) { return outArgs; }
+
+    for (int i(1); i < numArgs; ++i)
+    {
+        const int utf8Len(WideCharToMultiByte(CP_UTF8, 0, argList[i], -1, nullptr, 0, nullptr, nullptr));
+        if (utf8Len <= 0) { continue; }
+
+        std::string arg(static_cast<size_t>(utf8Len), '\0');
+        WideCharToMultiByte(CP_UTF8, 0, argList[i], -1, arg.data(), utf8Len, nullptr, nullptr);
+
+        // Remove the null-terminating character
+        arg.resize(arg.length() - 1);
+        outArgs.emplace_back(std::move(arg));
+    }
+
+    LocalFree(argList);
+    return outArgs;
+}
+
+void WindowsPlatform::AttachParentConsole()
+{
+    // This is a GUI subsystem app, so there is no console unless we attach to the one we were started from
+    if (AttachConsole(ATTACH_PARENT_PROCESS))
+    {
+        FILE* stream(nullptr);
+        freopen_s(&stream, "CONOUT$", "w", stdout);
+        freopen_s(&stream, "CONOUT$", "w", stderr);
+    }
 }
\ No newline at end of file
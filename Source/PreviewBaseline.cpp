@@ -0,0 +1,150 @@
+#include "Header/PreviewBaseline.h"
+#include <charconv>
+#include <format>
+#include <fstream>
+
+namespace
+{
+    template<typename T>
+    bool ParseValue(const std::string_view& str, T& outValue)
+    {
+        return std::from_chars(str.data(), str.data() + str.size(), outValue).ec == std::errc();
+    }
+
+    template<size_t N>
+    bool ParseFloatList(const std::string_view& str, std::array<float, N>& outValues)
+    {
+        size_t valueStart(0);
+        for (size_t i(0); i < N; ++i)
+        {
+            const size_t valueEnd(i + 1 < N ? str.find(',', valueStart) : str.length());
+            if (valueEnd == std::string_view::npos || !ParseValue(str.substr(valueStart, valueEnd - valueStart), outValues[i])) { return false; }
+            valueStart = valueEnd + 1;
+        }
+
+        return true;
+    }
+
+    template<size_t N>
+    std::string SerializeFloatList(const std::array<float, N>& values)
+    {
+        std::string outStr;
+        for (size_t i(0); i < N; ++i)
+        {
+            if (i != 0) { outStr += ','; }
+            outStr += std::format("{}", values[i]);
+        }
+
+        return outStr;
+    }
+}
+
+bool PreviewBaseline::Load(const std::filesystem::path& baselineFile)
+{
+    m_banks.clear();
+    m_bankIndices.clear();
+
+    std::ifstream ifs(baselineFile, std::ios::binary);
+    if (!ifs.is_open()) { return false; }
+
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+        if (line.empty() || line.front() == '#') { continue; }
+
+        std::string bankName;
+        PresetFingerprint preset{};
+        NoteFingerprint note{};
+        if (!DeserializeNote(line, bankName, preset, note)) { continue; }
+
+        auto bankIt(m_bankIndices.find(bankName));
+        if (bankIt == m_bankIndices.end())
+        {
+            bankIt = m_bankIndices.emplace(bankName, m_banks.size()).first;
+            m_banks.emplace_back().m_bankName = bankName;
+        }
+
+        // Lines are written grouped by preset, so a new preset only ever follows the previous one
+        auto& presets(m_banks[bankIt->second].m_presets);
+        if (presets.empty() || presets.back().m_presetIndex != preset.m_presetIndex) { presets.emplace_back(std::move(preset)); }
+        presets.back().m_notes.emplace_back(note);
+    }
+
+    return true;
+}
+
+bool PreviewBaseline::Save(const std::filesystem::path& baselineFile) const
+{
+    auto tempFile(baselineFile);
+    tempFile += ".tmp";
+
+    {
+        std::ofstream ofs(tempFile, std::ios::binary | std::ios::trunc);
+        if (!ofs.is_open()) { return false; }
+
+        ofs << PreviewBaselineStatics::BASELINE_HEADER << '\n';
+        for (const auto& bank : m_banks)
+        {
+            for (const auto& preset : bank.m_presets)
+            {
+                for (const auto& note : preset.m_notes)
+                {
+                    ofs << std::format("{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\n", bank.m_bankName, preset.m_presetIndex, preset.m_presetName, note.m_note.m_key,
+                        note.m_note.m_velocity, note.m_pitchHz, SerializeFloatList(note.m_rmsDB), SerializeFloatList(note.m_bandsDB));
+                }
+            }
+        }
+
+        ofs.flush();
+        if (!ofs.good()) { return false; }
+    }
+
+    std::error_code errorCode;
+    std::filesystem::rename(tempFile, baselineFile, errorCode);
+    return !errorCode;
+}
+
+const BankFingerprint* PreviewBaseline::FindBank(const std::string& bankName) const
+{
+    const auto it(m_bankIndices.find(bankName));
+    return it != m_bankIndices.end() ? &m_banks[it->second] : nullptr;
+}
+
+void PreviewBaseline::AddOrUpdateBank(BankFingerprint&& bank)
+{
+    if (const auto it(m_bankIndices.find(bank.m_bankName)); it != m_bankIndices.end())
+    {
+        m_banks[it->second] = std::move(bank);
+        return;
+    }
+
+    m_bankIndices.emplace(bank.m_bankName, m_banks.size());
+    m_banks.emplace_back(std::move(bank));
+}
+
+bool PreviewBaseline::DeserializeNote(const std::string& line, std::string& outBankName, PresetFingerprint& outPreset, NoteFingerprint& outNote)
+{
+    constexpr size_t NUM_COLUMNS(8);
+    std::array<std::string_view, NUM_COLUMNS> columns{};
+
+    const std::string_view lineView(line);
+    size_t columnStart(0);
+    for (size_t i(0); i < NUM_COLUMNS; ++i)
+    {
+        const size_t columnEnd(i + 1 < NUM_COLUMNS ? lineView.find('\t', columnStart) : lineView.length());
+        if (columnEnd == std::string_view::npos) { return false; }
+
+        columns[i] = lineView.substr(columnStart, columnEnd - columnStart);
+        columnStart = columnEnd + 1;
+    }
+
+    uint32_t key(0u), velocity(0u);
+    if (columns[0].empty() || !ParseValue(columns[1], outPreset.m_presetIndex) || !ParseValue(columns[3], key) || !ParseValue(columns[4], velocity)
+        || !ParseValue(columns[5], outNote.m_pitchHz) || !ParseFloatList(columns[6], outNote.m_rmsDB) || !ParseFloatList(columns[7], outNote.m_bandsDB)) { return false; }
+
+    outBankName = columns[0];
+    outPreset.m_presetName = columns[2];
+    outNote.m_note.m_key = static_cast<uint8_t>(key);
+    outNote.m_note.m_velocity = static_cast<uint8_t>(velocity);
+    return true;
+}
@@ -0,0 +1,286 @@
+#include "Header/PreviewRenderer.h"
+#include "Header/IO/BinaryReader.h"
+#include "Header/Logger.h"
+#include "Header/Parallel.h"
+#include "Header/SF2/Helpers/SF3Helpers.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <format>
+#include <memory>
+#include <numbers>
+
+// Declarations only, the implementation is compiled in SF2Reader.cpp
+#include "Dependencies/TinySoundFont/tsf.h"
+
+namespace
+{
+    constexpr auto NUM_HOLD_SAMPLES(static_cast<size_t>(PreviewRendererStatics::NOTE_HOLD_SEC * PreviewRendererStatics::SAMPLE_RATE));
+    constexpr auto NUM_NOTE_SAMPLES(NUM_HOLD_SAMPLES + static_cast<size_t>(PreviewRendererStatics::NOTE_TAIL_SEC * PreviewRendererStatics::SAMPLE_RATE));
+
+    // Closed however fingerprinting ends, Parallel::For rethrows a worker's exception
+    struct TSFCloser final
+    {
+        void operator()(tsf* instance) const { tsf_close(instance); }
+    };
+
+    using TSFInstance = std::unique_ptr<tsf, TSFCloser>;
+
+    float PowerToDB(const double power)
+    {
+        return power > 0. ? std::max(static_cast<float>(10. * std::log10(power)), PreviewRendererStatics::SILENCE_DB) : PreviewRendererStatics::SILENCE_DB;
+    }
+
+    // In-place radix-2, size must be a power of 2
+    void FFT(std::vector<std::complex<float>>& data)
+    {
+        const size_t size(data.size());
+        for (size_t i(1), j(0); i < size; ++i)
+        {
+            size_t bit(size >> 1);
+            for (; (j & bit) != 0; bit >>= 1) { j ^= bit; }
+            j ^= bit;
+            if (i < j) { std::swap(data[i], data[j]); }
+        }
+
+        for (size_t length(2); length <= size; length <<= 1)
+        {
+            const float angle(-2.f * std::numbers::pi_v<float> / static_cast<float>(length));
+            const std::complex<float> step(std::cos(angle), std::sin(angle));
+            for (size_t start(0); start < size; start += length)
+            {
+                std::complex<float> twiddle(1.f, 0.f);
+                for (size_t k(0); k < length / 2; ++k)
+                {
+                    const auto even(data[start + k]);
+                    const auto odd(data[start + k + length / 2] * twiddle);
+                    data[start + k] = even + odd;
+                    data[start + k + length / 2] = even - odd;
+                    twiddle *= step;
+                }
+            }
+        }
+    }
+
+    void RenderNote(tsf* sf2, const int presetIndex, const PreviewTestNote& note, std::vector<float>& outSamples)
+    {
+        outSamples.assign(NUM_NOTE_SAMPLES, 0.f);
+        tsf_note_on(sf2, presetIndex, note.m_key, static_cast<float>(note.m_velocity) / 127.f);
+        tsf_render_float(sf2, outSamples.data(), static_cast<int>(NUM_HOLD_SAMPLES), 0);
+        tsf_note_off(sf2, presetIndex, note.m_key);
+        tsf_render_float(sf2, &outSamples[NUM_HOLD_SAMPLES], static_cast<int>(NUM_NOTE_SAMPLES - NUM_HOLD_SAMPLES), 0);
+
+        // Nothing carries over into the next note
+        tsf_note_kill_all(sf2);
+    }
+
+    NoteFingerprint FingerprintNote(const PreviewTestNote& note, const std::vector<float>& samples, std::vector<std::complex<float>>& fftBuffer)
+    {
+        using namespace PreviewRendererStatics;
+
+        NoteFingerprint outFingerprint{};
+        outFingerprint.m_note = note;
+
+        const size_t frameSize(samples.size() / NUM_RMS_FRAMES);
+        for (uint32_t frame(0u); frame < NUM_RMS_FRAMES; ++frame)
+        {
+            double sumSquares(0.);
+            for (size_t i(frame * frameSize); i < (frame + 1u) * frameSize; ++i) { sumSquares += static_cast<double>(samples[i]) * samples[i]; }
+            outFingerprint.m_rmsDB[frame] = PowerToDB(sumSquares / static_cast<double>(frameSize));
+        }
+
+        // Hann windowed spectrum from the middle of the hold, past most attacks and before the release
+        const size_t windowStart(NUM_HOLD_SAMPLES > FFT_SIZE ? (NUM_HOLD_SAMPLES - FFT_SIZE) / 2 + FFT_SIZE / 4 : 0);
+        fftBuffer.resize(FFT_SIZE);
+        for (uint32_t i(0u); i < FFT_SIZE; ++i)
+        {
+            const float window(0.5f - 0.5f * std::cos(2.f * std::numbers::pi_v<float> * static_cast<float>(i) / static_cast<float>(FFT_SIZE - 1u)));
+            fftBuffer[i] = {samples[windowStart + i] * window, 0.f};
+        }
+
+        FFT(fftBuffer);
+
+        constexpr float binHz(static_cast<float>(SAMPLE_RATE) / static_cast<float>(FFT_SIZE));
+        const auto getBinPower([&fftBuffer](const size_t bin) { return static_cast<double>(std::norm(fftBuffer[bin])); });
+
+        constexpr auto firstBin(static_cast<size_t>(MIN_BAND_HZ / binHz));
+        constexpr auto endBin(static_cast<size_t>(MAX_BAND_HZ / binHz));
+
+        std::array<double, NUM_SPECTRAL_BANDS> bandPowers{};
+        double totalPower(0.);
+        size_t peakBin(firstBin);
+        for (size_t bin(firstBin); bin < endBin; ++bin)
+        {
+            const double power(getBinPower(bin));
+            const float band(std::log(static_cast<float>(bin) * binHz / MIN_BAND_HZ) / std::log(MAX_BAND_HZ / MIN_BAND_HZ) * NUM_SPECTRAL_BANDS);
+            bandPowers[std::clamp(static_cast<size_t>(band), size_t(0), size_t(NUM_SPECTRAL_BANDS - 1u))] += power;
+            totalPower += power;
+            if (power > getBinPower(peakBin)) { peakBin = bin; }
+        }
+
+        if (totalPower <= 0.)
+        {
+            outFingerprint.m_bandsDB.fill(SILENCE_DB);
+            return outFingerprint;
+        }
+
+        for (uint32_t band(0u); band < NUM_SPECTRAL_BANDS; ++band) { outFingerprint.m_bandsDB[band] = PowerToDB(bandPowers[band] / totalPower); }
+
+        // Parabolic interpolation of the log peak, gets well under a cent of accuracy from 10 Hz bins.
+        // A peak on the edge of the scanned bins has no neighbour on one side and is taken as is.
+        double offset(0.);
+        if (peakBin > firstBin && peakBin + 1 < endBin)
+        {
+            const double prevDB(PowerToDB(getBinPower(peakBin - 1))), peakDB(PowerToDB(getBinPower(peakBin))), nextDB(PowerToDB(getBinPower(peakBin + 1)));
+            const double curvature(prevDB - 2. * peakDB + nextDB);
+            if (curvature < 0.) { offset = 0.5 * (prevDB - nextDB) / curvature; }
+        }
+
+        outFingerprint.m_pitchHz = static_cast<float>((static_cast<double>(peakBin) + offset) * binHz);
+        return outFingerprint;
+    }
+}
+
+bool PreviewRenderer::FingerprintBank(const std::filesystem::path& file, BankFingerprint& outFingerprint)
+{
+    outFingerprint.m_bankName = file.filename().replace_extension("").string();
+    outFingerprint.m_presets.clear();
+
+    BinaryReader reader;
+    if (!reader.readFile(file))
+    {
+        Logger::LogMessage("(Bank: '%s') Unable to read the file", outFingerprint.m_bankName.c_str());
+        return false;
+    }
+
+    const auto& fileData(reader.GetData());
+    BinaryBuffer decompressedData{};
+    const bool isCompressed(SF3Helpers::IsCompressed(fileData.data(), fileData.size()));
+    if (isCompressed && !SF3Helpers::DecompressToSF2(fileData.data(), fileData.size(), decompressedData)) { return false; }
+
+    const auto& sf2Data(isCompressed ? decompressedData : fileData);
+    tsf* sf2(tsf_load_memory(sf2Data.data(), static_cast<int>(sf2Data.size())));
+    if (sf2 == nullptr)
+    {
+        Logger::LogMessage("(Bank: '%s') Unable to load the bank for playback", outFingerprint.m_bankName.c_str());
+        return false;
+    }
+
+    tsf_set_output(sf2, TSF_MONO, static_cast<int>(PreviewRendererStatics::SAMPLE_RATE), 0.f);
+
+    // Each worker plays on its own copy, they share the loaded samples (tsf_copy itself is not thread safe)
+    const auto numPresets(static_cast<size_t>(tsf_get_presetcount(sf2)));
+    std::vector<TSFInstance> workerInstances{};
+    workerInstances.emplace_back(sf2);
+    for (uint32_t i(1u); i < Parallel::GetNumWorkers(numPresets); ++i) { workerInstances.emplace_back(tsf_copy(sf2)); }
+
+    outFingerprint.m_presets.resize(numPresets);
+    Parallel::For(numPresets, [&](const size_t presetIndex, const uint32_t workerIndex)
+    {
+        tsf* instance(workerInstances[workerIndex].get());
+        auto& preset(outFingerprint.m_presets[presetIndex]);
+        preset.m_presetIndex = static_cast<uint32_t>(presetIndex);
+        preset.m_presetName = tsf_get_presetname(instance, static_cast<int>(presetIndex));
+
+        std::vector<float> samples{};
+        std::vector<std::complex<float>> fftBuffer{};
+        for (const auto& note : PreviewRendererStatics::TEST_NOTES)
+        {
+            RenderNote(instance, static_cast<int>(presetIndex), note, samples);
+            preset.m_notes.emplace_back(FingerprintNote(note, samples, fftBuffer));
+        }
+    });
+
+    return true;
+}
+
+std::vector<std::string> PreviewRenderer::CompareFingerprints(const BankFingerprint& baseline, const BankFingerprint& current)
+{
+    using namespace PreviewRendererStatics;
+
+    std::vector<std::string> outDifferences{};
+    if (baseline.m_presets.size() != current.m_presets.size())
+    {
+        outDifferences.emplace_back(std::format("Preset count changed from {} to {}", baseline.m_presets.size(), current.m_presets.size()));
+    }
+
+    for (size_t i(0); i < std::min(baseline.m_presets.size(), current.m_presets.size()); ++i)
+    {
+        const auto& expectedPreset(baseline.m_presets[i]);
+        const auto& preset(current.m_presets[i]);
+        if (expectedPreset.m_presetName != preset.m_presetName)
+        {
+            outDifferences.emplace_back(std::format("Preset {} was '{}', is now '{}'", i, expectedPreset.m_presetName, preset.m_presetName));
+            continue;
+        }
+
+        for (const auto& note : preset.m_notes)
+        {
+            const auto expectedIt(std::ranges::find_if(expectedPreset.m_notes, [&note](const NoteFingerprint& expectedNote)
+            {
+                return expectedNote.m_note.m_key == note.m_note.m_key && expectedNote.m_note.m_velocity == note.m_note.m_velocity;
+            }));
+
+            if (expectedIt == expectedPreset.m_notes.end()) { continue; }
+
+            const auto& expected(*expectedIt);
+            const auto prefix(std::format("Preset {} '{}' key {} vel {}:", i, preset.m_presetName, note.m_note.m_key, note.m_note.m_velocity));
+
+            // Envelope: the worst frame that is above the noise floor in either render
+            float worstRMSDiff(0.f);
+            uint32_t worstFrame(0u);
+            for (uint32_t frame(0u); frame < NUM_RMS_FRAMES; ++frame)
+            {
+                if (std::max(expected.m_rmsDB[frame], note.m_rmsDB[frame]) < MIN_COMPARED_RMS_DB) { continue; }
+
+                const float diff(note.m_rmsDB[frame] - expected.m_rmsDB[frame]);
+                if (std::abs(diff) > std::abs(worstRMSDiff))
+                {
+                    worstRMSDiff = diff;
+                    worstFrame = frame;
+                }
+            }
+
+            if (std::abs(worstRMSDiff) > RMS_TOLERANCE_DB)
+            {
+                const float frameSec((NOTE_HOLD_SEC + NOTE_TAIL_SEC) * static_cast<float>(worstFrame) / static_cast<float>(NUM_RMS_FRAMES));
+                outDifferences.emplace_back(std::format("{} level {:+.1f} dB at {:.2f} s", prefix, worstRMSDiff, frameSec));
+            }
+
+            float worstBandDiff(0.f);
+            uint32_t worstBand(0u);
+            for (uint32_t band(0u); band < NUM_SPECTRAL_BANDS; ++band)
+            {
+                if (std::max(expected.m_bandsDB[band], note.m_bandsDB[band]) < MIN_COMPARED_BAND_DB) { continue; }
+
+                const float diff(note.m_bandsDB[band] - expected.m_bandsDB[band]);
+                if (std::abs(diff) > std::abs(worstBandDiff))
+                {
+                    worstBandDiff = diff;
+                    worstBand = band;
+                }
+            }
+
+            if (std::abs(worstBandDiff) > SPECTRAL_TOLERANCE_DB)
+            {
+                const float bandHz(MIN_BAND_HZ * std::pow(MAX_BAND_HZ / MIN_BAND_HZ, static_cast<float>(worstBand) / static_cast<float>(NUM_SPECTRAL_BANDS)));
+                outDifferences.emplace_back(std::format("{} spectrum {:+.1f} dB around {:.0f} Hz", prefix, worstBandDiff, bandHz));
+            }
+
+            if (expected.m_pitchHz > 0.f && note.m_pitchHz > 0.f)
+            {
+                const float cents(1200.f * std::log2(note.m_pitchHz / expected.m_pitchHz));
+                if (std::abs(cents) > PITCH_TOLERANCE_CENTS)
+                {
+                    outDifferences.emplace_back(std::format("{} pitch {:+.1f} cents ({:.1f} Hz -> {:.1f} Hz)", prefix, cents, expected.m_pitchHz, note.m_pitchHz));
+                }
+            }
+            else if ((expected.m_pitchHz > 0.f) != (note.m_pitchHz > 0.f))
+            {
+                outDifferences.emplace_back(std::format("{} {}", prefix, note.m_pitchHz > 0.f ? "was silent, now sounds" : "is now silent"));
+            }
+        }
+    }
+
+    return outDifferences;
+}
@@ -0,0 +1,144 @@
+#include "Header/Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <fstream>
+
+namespace
+{
+    thread_local BankProfile* threadProfile = nullptr;
+
+    std::string EscapeJSON(const std::string_view& str)
+    {
+        std::string outStr;
+        outStr.reserve(str.length());
+        for (const char c : str)
+        {
+            if (c == '"' || c == '\\') { outStr += '\\'; outStr += c; }
+            else if (static_cast<uint8_t>(c) < 0x20u) { outStr += std::format("\\u{:04x}", static_cast<uint32_t>(c)); }
+            else { outStr += c; }
+        }
+
+        return outStr;
+    }
+
+    bool WriteTextFile(const std::filesystem::path& file, const std::string& text)
+    {
+        std::ofstream ofs(file, std::ios::binary | std::ios::trunc);
+        if (!ofs.is_open()) { return false; }
+
+        ofs.write(text.data(), static_cast<std::streamsize>(text.length()));
+        return ofs.good();
+    }
+}
+
+BankProfile::BankProfile(std::string&& bankName) : m_bankName(std::move(bankName))
+{
+    // Pin the epoch before the first stage starts so trace timestamps never go negative
+    static_cast<void>(Profiler::GetEpoch());
+}
+
+void BankProfile::AddStage(const EProfileStage stage, const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end)
+{
+    auto& stageTotal(m_stageTotals[static_cast<size_t>(stage)]);
+    stageTotal.m_duration += end - start;
+    ++stageTotal.m_numCalls;
+
+    if (m_traceEvents.size() >= ProfilerStatics::MAX_TRACE_EVENTS)
+    {
+        ++m_numDroppedEvents;
+        return;
+    }
+
+    const auto startUs(std::chrono::duration_cast<std::chrono::microseconds>(start - Profiler::GetEpoch()).count());
+    const auto durationUs(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    m_traceEvents.emplace_back(startUs, durationUs, Profiler::GetThreadId(), stage);
+}
+
+std::string BankProfile::ToJSON() const
+{
+    std::string outJSON(std::format("{{\n  \"bank\": \"{}\",\n  \"stages\": {{", EscapeJSON(m_bankName)));
+    for (size_t i(0); i < m_stageTotals.size(); ++i)
+    {
+        const auto& stageTotal(m_stageTotals[i]);
+        const std::chrono::duration<double, std::milli> durationMs(stageTotal.m_duration);
+        outJSON += std::format("{}\n    \"{}\": {{ \"ms\": {:.3f}, \"calls\": {} }}", i > 0 ? "," : "", ProfilerStatics::STAGE_NAMES[i],
+            durationMs.count(), stageTotal.m_numCalls);
+    }
+
+    outJSON += "\n  },\n  \"counters\": {";
+    for (size_t i(0); i < m_counters.size(); ++i)
+    {
+        outJSON += std::format("{}\n    \"{}\": {}", i > 0 ? "," : "", ProfilerStatics::COUNTER_NAMES[i], m_counters[i]);
+    }
+
+    outJSON += std::format("\n  }},\n  \"droppedTraceEvents\": {}\n}}\n", m_numDroppedEvents);
+    return outJSON;
+}
+
+std::string BankProfile::ToChromeTrace() const
+{
+    const auto bankName(EscapeJSON(m_bankName));
+
+    std::string outJSON("{\"traceEvents\":[\n");
+    outJSON += std::format("{{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{{\"name\":\"{}\"}}}}", bankName);
+
+    int64_t endUs(0);
+    for (const auto& event : m_traceEvents)
+    {
+        outJSON += std::format(",\n{{\"name\":\"{}\",\"cat\":\"conversion\",\"ph\":\"X\",\"ts\":{},\"dur\":{},\"pid\":1,\"tid\":{}}}",
+            ProfilerStatics::STAGE_NAMES[static_cast<size_t>(event.m_stage)], event.m_startUs, event.m_durationUs, event.m_threadId);
+        endUs = std::max(endUs, event.m_startUs + event.m_durationUs);
+    }
+
+    // Counters go in as a single sample at the end of the bank
+    outJSON += std::format(",\n{{\"name\":\"counters\",\"ph\":\"C\",\"ts\":{},\"pid\":1,\"args\":{{", endUs);
+    for (size_t i(0); i < m_counters.size(); ++i)
+    {
+        outJSON += std::format("{}\"{}\":{}", i > 0 ? "," : "", ProfilerStatics::COUNTER_NAMES[i], m_counters[i]);
+    }
+
+    outJSON += "}}\n],\"displayTimeUnit\":\"ms\"}\n";
+    return outJSON;
+}
+
+BankProfile* Profiler::GetThreadProfile()
+{
+    return threadProfile;
+}
+
+std::chrono::steady_clock::time_point Profiler::GetEpoch()
+{
+    static const auto epoch(std::chrono::steady_clock::now());
+    return epoch;
+}
+
+uint32_t Profiler::GetThreadId()
+{
+    // Small sequential ids read better in trace viewers than hashed std::thread::id
+    static std::atomic<uint32_t> nextThreadId{1u};
+    thread_local const uint32_t threadId(nextThreadId++);
+    return threadId;
+}
+
+void Profiler::AddCounter(const EProfileCounter counter, const uint64_t value)
+{
+    if (threadProfile != nullptr) { threadProfile->AddCounter(counter, value); }
+}
+
+bool Profiler::WriteBankProfile(const BankProfile& profile, const std::filesystem::path& folder)
+{
+    const bool wroteProfile(WriteTextFile(folder / (profile.GetBankName() + ".profile.json"), profile.ToJSON()));
+    const bool wroteTrace(WriteTextFile(folder / (profile.GetBankName() + ".trace.json"), profile.ToChromeTrace()));
+    return wroteProfile && wroteTrace;
+}
+
+Profiler::BankScope::BankScope(BankProfile* profile) : m_prevProfile(threadProfile)
+{
+    threadProfile = profile;
+}
+
+Profiler::BankScope::~BankScope()
+{
+    threadProfile = m_prevProfile;
+}
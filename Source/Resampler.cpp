@@ -0,0 +1,185 @@
+#include "Header/Resampler.h"
+#include "Header/Data/Soundbank.h"
+#include "Header/Parallel.h"
+#include "Header/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+#include <unordered_map>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    struct PolyphaseFilter final
+    {
+        uint32_t m_upFactor = 1u; // Target rate over the gcd
+        uint32_t m_downFactor = 1u; // Source rate over the gcd
+        uint32_t m_numTaps = 0u; // Always a multiple of 4
+        std::vector<float> m_coefficients{}; // NUM_PHASES + 1 phases of m_numTaps, the extra phase is the next sample's first
+    };
+
+    PolyphaseFilter CreateFilter(const uint32_t sourceRate, const uint32_t targetRate)
+    {
+        using namespace ResamplerStatics;
+
+        const uint32_t divisor(std::gcd(sourceRate, targetRate));
+        PolyphaseFilter outFilter{targetRate / divisor, sourceRate / divisor};
+
+        // Downsampling lowers the cutoff to the target Nyquist, which needs a proportionally longer filter
+        const double scale(std::min(1., static_cast<double>(targetRate) / static_cast<double>(sourceRate)));
+        const uint32_t halfTaps((static_cast<uint32_t>(std::ceil(static_cast<double>(HALF_TAPS) / scale)) + 1u) & ~1u);
+        const double cutoff(0.5 * CUTOFF * scale);
+        const double windowNorm(std::cyl_bessel_i(0., KAISER_BETA));
+
+        outFilter.m_numTaps = halfTaps * 2u;
+        outFilter.m_coefficients.resize(static_cast<size_t>(NUM_PHASES + 1u) * outFilter.m_numTaps);
+        for (uint32_t phase(0u); phase <= NUM_PHASES; ++phase)
+        {
+            float* coefficients(&outFilter.m_coefficients[static_cast<size_t>(phase) * outFilter.m_numTaps]);
+            double sum(0.);
+            for (uint32_t tap(0u); tap < outFilter.m_numTaps; ++tap)
+            {
+                // Distance in input samples from the output position to this tap
+                const double distance(static_cast<double>(tap) - static_cast<double>(halfTaps - 1u) - static_cast<double>(phase) / NUM_PHASES);
+                const double windowPos(distance / static_cast<double>(halfTaps));
+                if (std::abs(windowPos) >= 1.)
+                {
+                    coefficients[tap] = 0.f;
+                    continue;
+                }
+
+                const double x(2. * cutoff * distance);
+                const double sinc(x == 0. ? 1. : std::sin(std::numbers::pi * x) / (std::numbers::pi * x));
+                const double window(std::cyl_bessel_i(0., KAISER_BETA * std::sqrt(1. - windowPos * windowPos)) / windowNorm);
+                const double coefficient(2. * cutoff * sinc * window);
+                coefficients[tap] = static_cast<float>(coefficient);
+                sum += coefficient;
+            }
+
+            // Unity gain at DC for every phase, so a constant input stays constant
+            for (uint32_t tap(0u); tap < outFilter.m_numTaps; ++tap) { coefficients[tap] = static_cast<float>(coefficients[tap] / sum); }
+        }
+
+        return outFilter;
+    }
+
+    // Four lanes summed in a fixed order, the scalar path matches the SSE one bit for bit
+    float DotProduct(const float* samples, const float* coefficients, const uint32_t numTaps)
+    {
+#if defined(_M_X64) || defined(__SSE2__)
+        __m128 sum(_mm_setzero_ps());
+        for (uint32_t i(0u); i < numTaps; i += 4u) { sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&samples[i]), _mm_loadu_ps(&coefficients[i]))); }
+
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, sum);
+#else
+        float lanes[4]{};
+        for (uint32_t i(0u); i < numTaps; i += 4u)
+        {
+            for (uint32_t lane(0u); lane < 4u; ++lane) { lanes[lane] += samples[i + lane] * coefficients[i + lane]; }
+        }
+#endif
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+
+    // Interleaved channels, the output holds ceil(numFrames * upFactor / downFactor) frames
+    std::vector<int16_t> ResampleWithFilter(const std::vector<int16_t>& data, const uint32_t numChannels, const PolyphaseFilter& filter)
+    {
+        using namespace ResamplerStatics;
+
+        const size_t numFrames(data.size() / numChannels);
+        const size_t numOutFrames((static_cast<uint64_t>(numFrames) * filter.m_upFactor + filter.m_downFactor - 1u) / filter.m_downFactor);
+        std::vector<int16_t> outData(numOutFrames * numChannels);
+
+        // One channel at a time through a float copy with silence either side, so the filter never reads past the ends
+        const uint32_t halfTaps(filter.m_numTaps / 2u);
+        std::vector<float> input(numFrames + static_cast<size_t>(filter.m_numTaps) * 2u, 0.f);
+        for (uint32_t channel(0u); channel < numChannels; ++channel)
+        {
+            for (size_t frame(0); frame < numFrames; ++frame) { input[halfTaps + frame] = static_cast<float>(data[frame * numChannels + channel]); }
+
+            for (size_t outFrame(0); outFrame < numOutFrames; ++outFrame)
+            {
+                // Integer position keeps the stepping exact over any sample length
+                const uint64_t position(static_cast<uint64_t>(outFrame) * filter.m_downFactor);
+                const size_t frame(position / filter.m_upFactor);
+                const uint64_t scaledRemainder((position % filter.m_upFactor) * NUM_PHASES);
+                const auto phase(static_cast<uint32_t>(scaledRemainder / filter.m_upFactor));
+                const float phaseWeight(static_cast<float>(scaledRemainder % filter.m_upFactor) / static_cast<float>(filter.m_upFactor));
+
+                const float* samples(&input[frame + 1]);
+                const float* coefficients(&filter.m_coefficients[static_cast<size_t>(phase) * filter.m_numTaps]);
+                const float current(DotProduct(samples, coefficients, filter.m_numTaps));
+                const float next(phaseWeight > 0.f ? DotProduct(samples, coefficients + filter.m_numTaps, filter.m_numTaps) : current);
+                const float value(current + (next - current) * phaseWeight);
+
+                outData[outFrame * numChannels + channel] = static_cast<int16_t>(std::clamp(std::round(value), -32768.f, 32767.f));
+            }
+        }
+
+        return outData;
+    }
+
+    uint32_t ScalePosition(const uint32_t position, const PolyphaseFilter& filter)
+    {
+        return static_cast<uint32_t>((static_cast<uint64_t>(position) * filter.m_upFactor + filter.m_downFactor / 2u) / filter.m_downFactor);
+    }
+}
+
+void Resampler::ResampleBank(Soundbank& bank, const uint32_t targetRate)
+{
+    const Profiler::StageScope resampleScope(EProfileStage::SAMPLE_RESAMPLE);
+
+    // One filter per source rate, built up front and shared by the workers
+    std::unordered_map<uint32_t, PolyphaseFilter> filters{};
+    std::vector<size_t> sampleIndices{};
+    for (size_t i(0); i < bank.m_samples.size(); ++i)
+    {
+        const auto& sample(bank.m_samples[i]);
+        if (sample.m_sampleRate == 0u || sample.m_sampleRate == targetRate || sample.m_channels == 0u) { continue; }
+
+        if (!filters.contains(sample.m_sampleRate)) { filters.emplace(sample.m_sampleRate, CreateFilter(sample.m_sampleRate, targetRate)); }
+        sampleIndices.emplace_back(i);
+    }
+
+    if (sampleIndices.empty()) { return; }
+
+    // Pitch change from rounding each loop's length, in cents
+    std::vector<double> loopTuneCorrections(bank.m_samples.size(), 0.);
+    Parallel::For(sampleIndices.size(), [&](const size_t i, uint32_t)
+    {
+        auto& sample(bank.m_samples[sampleIndices[i]]);
+        const auto& filter(filters.at(sample.m_sampleRate));
+        sample.m_sampleData = ResampleWithFilter(sample.m_sampleData, sample.m_channels, filter);
+
+        const auto numFrames(static_cast<uint32_t>(sample.m_sampleData.size() / sample.m_channels));
+        const uint32_t loopLength(sample.m_loopEnd - sample.m_loopStart);
+        sample.m_loopStart = std::min(ScalePosition(sample.m_loopStart, filter), numFrames);
+        sample.m_loopEnd = std::clamp(ScalePosition(sample.m_loopEnd, filter), sample.m_loopStart, numFrames);
+        sample.m_sampleRate = targetRate;
+
+        // A longer loop plays lower, so it needs tuning up by the same ratio
+        const uint32_t newLoopLength(sample.m_loopEnd - sample.m_loopStart);
+        if (sample.m_isLooping && loopLength > 0u && newLoopLength > 0u)
+        {
+            const double exactLength(static_cast<double>(loopLength) * filter.m_upFactor / filter.m_downFactor);
+            loopTuneCorrections[sampleIndices[i]] = 1200. * std::log2(static_cast<double>(newLoopLength) / exactLength);
+        }
+    });
+
+    for (const size_t sampleIndex : sampleIndices) { Profiler::AddCounter(EProfileCounter::SAMPLES_PROCESSED, bank.m_samples[sampleIndex].m_sampleData.size()); }
+
+    // Voices refer to samples by their 1 based position
+    for (auto& preset : bank.m_presets)
+    {
+        for (auto& voice : preset.m_voices)
+        {
+            if (voice.m_sampleIndex == 0ui16 || voice.m_sampleIndex > bank.m_samples.size()) { continue; }
+            voice.m_fineTune += loopTuneCorrections[voice.m_sampleIndex - 1ui16];
+        }
+    }
+}
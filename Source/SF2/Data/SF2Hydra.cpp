@@ -0,0 +1,308 @@
+#include "Header/SF2/Data/SF2Hydra.h"
+#include "Header/MathFunctions.h"
+#include "Header/SF2/Helpers/SF2Helpers.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    [[nodiscard]] std::array<char, SF2HydraStatics::NAME_LEN> ToSF2Name(const std::string_view name)
+    {
+        std::array<char, SF2HydraStatics::NAME_LEN> outName{};
+        std::ranges::copy(name.substr(0, SF2HydraStatics::NAME_LEN - 1), outName.begin());
+        return outName;
+    }
+
+    template<typename T>
+    [[nodiscard]] size_t GetChunkSize(const std::vector<T>& records)
+    {
+        return SF2Helpers::RIFF_CHUNK_HEADER_SIZE + sizeof(T) * records.size();
+    }
+
+    template<typename T>
+    void WriteChunk(std::ostream& stream, const std::string_view fourCC, const std::vector<T>& records)
+    {
+        const auto size(static_cast<uint32_t>(sizeof(T) * records.size()));
+        SF2Helpers::WriteChunkHeader(stream, fourCC, size);
+        stream.write(reinterpret_cast<const char*>(records.data()), size);
+    }
+
+    template<typename T>
+    [[nodiscard]] bool FitsIndex(const std::vector<T>& records) { return records.size() <= UINT16_MAX; }
+
+    // The records are packed with no padding, so their bytes can be hashed and compared directly
+    template<typename T>
+    [[nodiscard]] uint64_t HashRecords(const std::vector<T>& records, const uint64_t hash)
+    {
+        const auto numRecords(static_cast<uint64_t>(records.size()));
+        return MathFunctions::hashFNV1a(records.data(), sizeof(T) * records.size(), MathFunctions::hashFNV1a(&numRecords, sizeof(numRecords), hash));
+    }
+
+    // The SF2 identity of a modulator, a local one with the same source, destination and amount source overrides the global one
+    [[nodiscard]] bool IsSameModulator(const SF2ModList& a, const SF2ModList& b)
+    {
+        return a.m_srcOper == b.m_srcOper && a.m_destOper == b.m_destOper && a.m_amtSrcOper == b.m_amtSrcOper;
+    }
+
+    // The value set most often, the first one seen wins ties
+    template<typename T>
+    [[nodiscard]] std::pair<T, size_t> GetMostCommonValue(const std::vector<T>& values)
+    {
+        std::pair<T, size_t> mostCommon(T{}, 0);
+        for (const auto& value : values)
+        {
+            const auto count(static_cast<size_t>(std::ranges::count(values, value)));
+            if (count > mostCommon.second) { mostCommon = {value, count}; }
+        }
+
+        return mostCommon;
+    }
+
+    template<typename T>
+    [[nodiscard]] bool AreRecordsEqual(const std::vector<T>& a, const std::vector<T>& b)
+    {
+        return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), sizeof(T) * a.size()) == 0);
+    }
+}
+
+void SF2InstrumentZones::Reserve(const size_t numZones)
+{
+    m_bags.reserve(numZones);
+    m_generators.reserve(numZones * SF2HydraStatics::GENERATORS_PER_ZONE);
+}
+
+void SF2InstrumentZones::BeginZone()
+{
+    m_bags.emplace_back(static_cast<uint16_t>(m_generators.size()), static_cast<uint16_t>(m_modulators.size()));
+    m_zoneGeneratorsSet.reset();
+}
+
+void SF2InstrumentZones::SetGenerator(const sf2cute::SFGeneratorItem& generator)
+{
+    const auto op(static_cast<size_t>(generator.op()));
+    m_zoneGenerators[op] = generator.amount().uvalue;
+    m_zoneGeneratorsSet.set(op);
+}
+
+void SF2InstrumentZones::SetModulator(const sf2cute::SFModulatorItem& modulator)
+{
+    const SF2ModList modList(modulator.source_op(), static_cast<uint16_t>(modulator.destination_op()), modulator.amount(),
+        modulator.amount_source_op(), static_cast<uint16_t>(modulator.transform_op()));
+
+    // A modulator with the same source, destination and amount source replaces the old one
+    const auto zoneModulators(std::next(m_modulators.begin(), m_bags.back().m_modulatorIndex));
+    const auto existingModulator(std::find_if(zoneModulators, m_modulators.end(), [&modList](const SF2ModList& other) { return IsSameModulator(other, modList); }));
+
+    if (existingModulator != m_modulators.end()) { *existingModulator = modList; }
+    else { m_modulators.emplace_back(modList); }
+}
+
+void SF2InstrumentZones::EndZone(const uint16_t sampleIndex)
+{
+    const auto addGenerator([this](const sf2cute::SFGenerator op)
+    {
+        const auto opIndex(static_cast<size_t>(op));
+        if (m_zoneGeneratorsSet.test(opIndex)) { m_generators.emplace_back(static_cast<uint16_t>(op), m_zoneGenerators[opIndex]); }
+    });
+
+    addGenerator(sf2cute::SFGenerator::kKeyRange);
+    addGenerator(sf2cute::SFGenerator::kVelRange);
+
+    for (size_t op(0); op < SF2HydraStatics::NUM_GENERATORS; ++op)
+    {
+        const auto generator(static_cast<sf2cute::SFGenerator>(op));
+        if (generator != sf2cute::SFGenerator::kKeyRange && generator != sf2cute::SFGenerator::kVelRange &&
+            generator != sf2cute::SFGenerator::kSampleID && generator != sf2cute::SFGenerator::kInstrument) { addGenerator(generator); }
+    }
+
+    m_generators.emplace_back(static_cast<uint16_t>(sf2cute::SFGenerator::kSampleID), sampleIndex);
+}
+
+void SF2InstrumentZones::HoistGlobalZone()
+{
+    const size_t numZones(m_bags.size());
+    if (numZones < 2) { return; }
+
+    const auto getZoneEnd([this, numZones](const size_t zoneIndex, const bool isGenerators)
+    {
+        if (zoneIndex + 1 < numZones) { return static_cast<size_t>(isGenerators ? m_bags[zoneIndex + 1].m_generatorIndex : m_bags[zoneIndex + 1].m_modulatorIndex); }
+        return isGenerators ? m_generators.size() : m_modulators.size();
+    });
+
+    // Generators: only ones every zone sets can move, a zone without one would otherwise pick up the global value
+    std::array<std::vector<uint16_t>, SF2HydraStatics::NUM_GENERATORS> generatorValues{};
+    for (size_t zoneIndex(0); zoneIndex < numZones; ++zoneIndex)
+    {
+        for (size_t i(m_bags[zoneIndex].m_generatorIndex); i < getZoneEnd(zoneIndex, true); ++i)
+        {
+            generatorValues[m_generators[i].m_oper].emplace_back(m_generators[i].m_amount);
+        }
+    }
+
+    std::vector<SF2GenList> globalGenerators{};
+    for (size_t op(0); op < SF2HydraStatics::NUM_GENERATORS; ++op)
+    {
+        const auto generator(static_cast<sf2cute::SFGenerator>(op));
+        if (generator == sf2cute::SFGenerator::kKeyRange || generator == sf2cute::SFGenerator::kVelRange || generator == sf2cute::SFGenerator::kSampleID ||
+            generatorValues[op].size() != numZones) { continue; }
+
+        // Worth it once at least two zones can drop theirs
+        const auto [value, count](GetMostCommonValue(generatorValues[op]));
+        if (count >= 2) { globalGenerators.emplace_back(static_cast<uint16_t>(op), value); }
+    }
+
+    // Modulators: the candidates are the first zone's, each must be in every zone
+    std::vector<SF2ModList> globalModulators{};
+    for (size_t i(0); i < getZoneEnd(0, false); ++i)
+    {
+        std::vector<int16_t> amounts{};
+        for (size_t zoneIndex(0); zoneIndex < numZones; ++zoneIndex)
+        {
+            for (size_t j(m_bags[zoneIndex].m_modulatorIndex); j < getZoneEnd(zoneIndex, false); ++j)
+            {
+                if (IsSameModulator(m_modulators[i], m_modulators[j])) { amounts.emplace_back(m_modulators[j].m_amount); break; }
+            }
+        }
+
+        if (amounts.size() != numZones) { continue; }
+
+        const auto [amount, count](GetMostCommonValue(amounts));
+        if (count < 2) { continue; }
+
+        auto globalModulator(m_modulators[i]);
+        globalModulator.m_amount = amount;
+        globalModulators.emplace_back(globalModulator);
+    }
+
+    if (globalGenerators.empty() && globalModulators.empty()) { return; }
+
+    // Rebuild with the global zone first, dropping what it now covers
+    std::vector<SF2Bag> bags{};
+    std::vector<SF2ModList> modulators(globalModulators);
+    std::vector<SF2GenList> generators(globalGenerators);
+    bags.reserve(numZones + 1);
+    bags.emplace_back(0ui16, 0ui16);
+
+    for (size_t zoneIndex(0); zoneIndex < numZones; ++zoneIndex)
+    {
+        bags.emplace_back(static_cast<uint16_t>(generators.size()), static_cast<uint16_t>(modulators.size()));
+        for (size_t i(m_bags[zoneIndex].m_generatorIndex); i < getZoneEnd(zoneIndex, true); ++i)
+        {
+            const auto& generator(m_generators[i]);
+            if (std::ranges::none_of(globalGenerators, [&generator](const SF2GenList& global)
+                { return global.m_oper == generator.m_oper && global.m_amount == generator.m_amount; })) { generators.emplace_back(generator); }
+        }
+
+        for (size_t i(m_bags[zoneIndex].m_modulatorIndex); i < getZoneEnd(zoneIndex, false); ++i)
+        {
+            const auto& modulator(m_modulators[i]);
+            // Only dropped when the global one is identical, a different transform still has to override it
+            if (std::ranges::none_of(globalModulators, [&modulator](const SF2ModList& global)
+                { return IsSameModulator(global, modulator) && global.m_amount == modulator.m_amount && global.m_transOper == modulator.m_transOper; }))
+            {
+                modulators.emplace_back(modulator);
+            }
+        }
+    }
+
+    m_bags = std::move(bags);
+    m_modulators = std::move(modulators);
+    m_generators = std::move(generators);
+}
+
+uint64_t SF2InstrumentZones::GetHash() const
+{
+    return HashRecords(m_generators, HashRecords(m_modulators, HashRecords(m_bags, MathFunctions::FNV1A_OFFSET_BASIS)));
+}
+
+bool SF2InstrumentZones::HasSameZones(const SF2InstrumentZones& other) const
+{
+    return AreRecordsEqual(m_bags, other.m_bags) && AreRecordsEqual(m_modulators, other.m_modulators) && AreRecordsEqual(m_generators, other.m_generators);
+}
+
+void SF2Hydra::Reserve(const size_t numPresets, const size_t numSamples)
+{
+    // Every array ends with a terminal record
+    m_presetHeaders.reserve(numPresets + 1);
+    m_presetBags.reserve(numPresets + 1);
+    m_presetModulators.reserve(1);
+    m_presetGenerators.reserve(numPresets + 1);
+    m_instHeaders.reserve(numPresets + 1);
+    m_sampleHeaders.reserve(numSamples + 1);
+}
+
+void SF2Hydra::ReserveZones(const size_t numZones, const size_t numModulators, const size_t numGenerators)
+{
+    m_instBags.reserve(numZones + 1);
+    m_instModulators.reserve(numModulators + 1);
+    m_instGenerators.reserve(numGenerators + 1);
+}
+
+void SF2Hydra::AddSample(const std::string_view name, const uint32_t start, const uint32_t end, const uint32_t loopStart, const uint32_t loopEnd,
+    const uint32_t sampleRate, const uint16_t sampleType)
+{
+    m_sampleHeaders.emplace_back(ToSF2Name(name), start, end, loopStart, loopEnd, sampleRate, 0ui8, 0i8, 0ui16, sampleType);
+}
+
+uint16_t SF2Hydra::AddInstrument(const std::string_view name, const SF2InstrumentZones& zones)
+{
+    m_instHeaders.emplace_back(ToSF2Name(name), static_cast<uint16_t>(m_instBags.size()));
+
+    // Too many records wrap the indices here, Finish catches that
+    const auto generatorOffset(static_cast<uint16_t>(m_instGenerators.size()));
+    const auto modulatorOffset(static_cast<uint16_t>(m_instModulators.size()));
+    for (const auto& bag : zones.m_bags)
+    {
+        m_instBags.emplace_back(static_cast<uint16_t>(bag.m_generatorIndex + generatorOffset), static_cast<uint16_t>(bag.m_modulatorIndex + modulatorOffset));
+    }
+
+    m_instModulators.insert(m_instModulators.end(), zones.m_modulators.begin(), zones.m_modulators.end());
+    m_instGenerators.insert(m_instGenerators.end(), zones.m_generators.begin(), zones.m_generators.end());
+    return static_cast<uint16_t>(m_instHeaders.size() - 1);
+}
+
+void SF2Hydra::AddPreset(const std::string_view name, const uint16_t presetNumber, const uint16_t bank, const uint16_t instrumentIndex)
+{
+    m_presetHeaders.emplace_back(ToSF2Name(name), presetNumber, bank, static_cast<uint16_t>(m_presetBags.size()), 0u, 0u, 0u);
+    m_presetBags.emplace_back(static_cast<uint16_t>(m_presetGenerators.size()), static_cast<uint16_t>(m_presetModulators.size()));
+    m_presetGenerators.emplace_back(static_cast<uint16_t>(sf2cute::SFGenerator::kInstrument), instrumentIndex);
+}
+
+bool SF2Hydra::Finish()
+{
+    m_presetHeaders.emplace_back(ToSF2Name("EOP"), 0ui16, 0ui16, static_cast<uint16_t>(m_presetBags.size()), 0u, 0u, 0u);
+    m_presetBags.emplace_back(static_cast<uint16_t>(m_presetGenerators.size()), static_cast<uint16_t>(m_presetModulators.size()));
+    m_presetModulators.emplace_back();
+    m_presetGenerators.emplace_back();
+
+    m_instHeaders.emplace_back(ToSF2Name("EOI"), static_cast<uint16_t>(m_instBags.size()));
+    m_instBags.emplace_back(static_cast<uint16_t>(m_instGenerators.size()), static_cast<uint16_t>(m_instModulators.size()));
+    m_instModulators.emplace_back();
+    m_instGenerators.emplace_back();
+
+    m_sampleHeaders.emplace_back(ToSF2Name("EOS"));
+
+    return FitsIndex(m_presetHeaders) && FitsIndex(m_presetBags) && FitsIndex(m_presetModulators) && FitsIndex(m_presetGenerators) &&
+        FitsIndex(m_instHeaders) && FitsIndex(m_instBags) && FitsIndex(m_instModulators) && FitsIndex(m_instGenerators) && FitsIndex(m_sampleHeaders);
+}
+
+size_t SF2Hydra::GetListSize() const
+{
+    return SF2Helpers::RIFF_LIST_HEADER_SIZE + GetChunkSize(m_presetHeaders) + GetChunkSize(m_presetBags) + GetChunkSize(m_presetModulators) +
+        GetChunkSize(m_presetGenerators) + GetChunkSize(m_instHeaders) + GetChunkSize(m_instBags) + GetChunkSize(m_instModulators) +
+        GetChunkSize(m_instGenerators) + GetChunkSize(m_sampleHeaders);
+}
+
+void SF2Hydra::Write(std::ostream& stream) const
+{
+    SF2Helpers::WriteListHeader(stream, "pdta", static_cast<uint32_t>(GetListSize() - SF2Helpers::RIFF_CHUNK_HEADER_SIZE));
+    WriteChunk(stream, "phdr", m_presetHeaders);
+    WriteChunk(stream, "pbag", m_presetBags);
+    WriteChunk(stream, "pmod", m_presetModulators);
+    WriteChunk(stream, "pgen", m_presetGenerators);
+    WriteChunk(stream, "inst", m_instHeaders);
+    WriteChunk(stream, "ibag", m_instBags);
+    WriteChunk(stream, "imod", m_instModulators);
+    WriteChunk(stream, "igen", m_instGenerators);
+    WriteChunk(stream, "shdr", m_sampleHeaders);
+}
@@ -53,4 +53,16 @@ void SF2Helpers::InterleaveSamples(const int16_t* leftChannel, const int16_t* ri
         outStereo[i * 2] = leftChannel[i];
         outStereo[i * 2 + 1] = rightChannel[i];
     }
+}
+
+void SF2Helpers::WriteChunkHeader(std::ostream& stream, const std::string_view fourCC, const uint32_t size)
+{
+    stream.write(fourCC.data(), static_cast<std::streamsize>(fourCC.size()));
+    stream.write(reinterpret_cast<const char*>(&size), sizeof(uint32_t));
+}
+
+void SF2Helpers::WriteListHeader(std::ostream& stream, const std::string_view fourCC, const uint32_t size)
+{
+    WriteChunkHeader(stream, "LIST", size);
+    stream.write(fourCC.data(), static_cast<std::streamsize>(fourCC.size()));
 }
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include "Header/SF2/Helpers/SF3Helpers.h"
+#include "Header/Data/Soundbank.h"
+#include "Header/IO/FLACCodec.h"
+#include "Header/Logger.h"
+#include "Header/Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+namespace
+{
+    constexpr uint32_t RIFF_HEADER_SIZE = 8u;
+    constexpr uint32_t SHDR_START_OFFSET = 20u;
+    constexpr uint32_t SHDR_TYPE_OFFSET = 44u;
+
+    struct SF2Layout final
+    {
+        std::string_view m_infoList{}; // Whole chunk, header included
+        std::string_view m_sampleData{}; // 'smpl' contents
+        std::string_view m_presetList{}; // Whole chunk, header included
+        size_t m_shdrOffset = 0; // Offset of the 'shdr' contents in m_presetList
+        uint32_t m_numSampleHeaders = 0u; // Including the terminal record
+    };
+
+    uint32_t ReadU32(const char* data)
+    {
+        uint32_t outValue(0u);
+        std::memcpy(&outValue, data, sizeof(outValue));
+        return outValue;
+    }
+
+    uint16_t ReadU16(const char* data)
+    {
+        uint16_t outValue(0u);
+        std::memcpy(&outValue, data, sizeof(outValue));
+        return outValue;
+    }
+
+    void WriteU32(char* data, const uint32_t value) { std::memcpy(data, &value, sizeof(value)); }
+    void WriteU16(char* data, const uint16_t value) { std::memcpy(data, &value, sizeof(value)); }
+
+    void AppendChunkHeader(BinaryBuffer& outData, const std::string_view& id, const uint32_t size)
+    {
+        outData.insert(outData.end(), id.begin(), id.end());
+        const size_t sizeOffset(outData.size());
+        outData.resize(sizeOffset + sizeof(size));
+        WriteU32(&outData[sizeOffset], size);
+    }
+
+    // Calls 'func' for each chunk in [data, data + size), stopping early if it returns false
+    bool ForEachChunk(const char* data, const size_t size, const std::function<bool(const std::string_view&, const char*, uint32_t)>& func)
+    {
+        size_t offset(0);
+        while (offset + RIFF_HEADER_SIZE <= size)
+        {
+            const std::string_view id(&data[offset], 4);
+            const uint32_t chunkSize(ReadU32(&data[offset + 4]));
+            if (chunkSize > size - offset - RIFF_HEADER_SIZE) { return false; }
+
+            if (!func(id, &data[offset + RIFF_HEADER_SIZE], chunkSize)) { return true; }
+            offset += RIFF_HEADER_SIZE + chunkSize + (chunkSize & 1u);
+        }
+
+        return true;
+    }
+
+    bool ParseLayout(const char* data, const size_t size, SF2Layout& outLayout)
+    {
+        if (size < RIFF_HEADER_SIZE + 4u || std::string_view(data, 4) != "RIFF" || std::string_view(&data[8], 4) != "sfbk") { return false; }
+
+        // The size covers the 'sfbk' form type at least
+        const uint32_t declaredSize(ReadU32(&data[4]));
+        if (declaredSize < 4u) { return false; }
+
+        // Some writers leave the padding byte of an odd 'smpl' out of the RIFF size (padded in size_t, so 0xFFFFFFFF does not wrap)
+        const size_t paddedSize(static_cast<size_t>(declaredSize) + (declaredSize & 1u));
+        const size_t riffSize(std::min(paddedSize, size - RIFF_HEADER_SIZE) - 4u);
+        const bool isValid(ForEachChunk(&data[12], riffSize, [&](const std::string_view& id, const char* chunkData, const uint32_t chunkSize)
+        {
+            if (id != "LIST" || chunkSize < 4u) { return true; }
+
+            const std::string_view listType(chunkData, 4);
+            const std::string_view wholeChunk(chunkData - RIFF_HEADER_SIZE, chunkSize + RIFF_HEADER_SIZE);
+            if (listType == "INFO") { outLayout.m_infoList = wholeChunk; }
+            else if (listType == "sdta")
+            {
+                return ForEachChunk(&chunkData[4], chunkSize - 4u, [&](const std::string_view& subId, const char* subData, const uint32_t subSize)
+                {
+                    if (subId == "smpl") { outLayout.m_sampleData = std::string_view(subData, subSize); }
+                    return true;
+                });
+            }
+            else if (listType == "pdta")
+            {
+                outLayout.m_presetList = wholeChunk;
+                return ForEachChunk(&chunkData[4], chunkSize - 4u, [&](const std::string_view& subId, const char* subData, const uint32_t subSize)
+                {
+                    if (subId == "shdr")
+                    {
+                        outLayout.m_shdrOffset = static_cast<size_t>(subData - wholeChunk.data());
+                        outLayout.m_numSampleHeaders = subSize / SF3Helpers::SHDR_RECORD_SIZE;
+                    }
+
+                    return true;
+                });
+            }
+
+            return true;
+        }));
+
+        return isValid && !outLayout.m_infoList.empty() && !outLayout.m_presetList.empty() && outLayout.m_numSampleHeaders > 0u;
+    }
+}
+
+std::vector<std::vector<uint8_t>> SF3Helpers::CompressSamples(const std::vector<BankSample>& samples)
+{
+    std::vector<std::vector<uint8_t>> outCompressed(samples.size());
+    Parallel::For(samples.size(), [&samples, &outCompressed](const size_t i, uint32_t)
+    {
+        const auto& sample(samples[i]);
+        // Empty samples are encoded too, an SF3 cannot mix compressed and PCM samples
+        if (sample.m_channels == 1u)
+        {
+            outCompressed[i] = FLACCodec::Encode(sample.m_sampleData.data(), sample.m_sampleData.size(), 1u, sample.m_sampleRate);
+        }
+    });
+
+    return outCompressed;
+}
+
+bool SF3Helpers::IsCompressed(const char* data, const size_t size)
+{
+    SF2Layout layout{};
+    if (!ParseLayout(data, size, layout)) { return false; }
+
+    const char* sampleHeaders(&layout.m_presetList[layout.m_shdrOffset]);
+    for (uint32_t i(0u); i + 1u < layout.m_numSampleHeaders; ++i)
+    {
+        if ((ReadU16(&sampleHeaders[i * SHDR_RECORD_SIZE + SHDR_TYPE_OFFSET]) & SAMPLE_TYPE_COMPRESSED) != 0u) { return true; }
+    }
+
+    return false;
+}
+
+bool SF3Helpers::DecompressToSF2(const char* data, const size_t size, BinaryBuffer& outSF2)
+{
+    SF2Layout layout{};
+    if (!ParseLayout(data, size, layout))
+    {
+        Logger::LogMessage("Unable to read the SF3 chunk layout");
+        return false;
+    }
+
+    // Decode every sample first, the new offsets depend on the decoded lengths
+    const uint32_t numSamples(layout.m_numSampleHeaders - 1u);
+    const char* sampleHeaders(&layout.m_presetList[layout.m_shdrOffset]);
+    std::vector<std::vector<int16_t>> decodedSamples(numSamples);
+    std::atomic<bool> isUnsupported(false);
+    Parallel::For(numSamples, [&](const size_t i, uint32_t)
+    {
+        const char* header(&sampleHeaders[i * SHDR_RECORD_SIZE]);
+        const uint32_t start(ReadU32(&header[SHDR_START_OFFSET]));
+        const uint32_t end(ReadU32(&header[SHDR_START_OFFSET + 4u]));
+        const uint16_t sampleType(ReadU16(&header[SHDR_TYPE_OFFSET]));
+        auto& decoded(decodedSamples[i]);
+
+        if ((sampleType & SAMPLE_TYPE_COMPRESSED) != 0u)
+        {
+            if (start >= end || end > layout.m_sampleData.size()) { return; }
+
+            const auto* compressed(reinterpret_cast<const uint8_t*>(&layout.m_sampleData[start]));
+            uint32_t numChannels(0u), sampleRate(0u);
+            if (!FLACCodec::Decode(compressed, end - start, decoded, numChannels, sampleRate))
+            {
+                isUnsupported = true;
+                decoded.clear();
+                return;
+            }
+
+            // Sample headers are mono, keep the first channel if an encoder wrote more
+            if (numChannels > 1u)
+            {
+                for (size_t frame(0); frame < decoded.size() / numChannels; ++frame) { decoded[frame] = decoded[frame * numChannels]; }
+                decoded.resize(decoded.size() / numChannels);
+            }
+        }
+        else if ((sampleType & SAMPLE_TYPE_ROM) == 0u && start < end && static_cast<size_t>(end) * sizeof(int16_t) <= layout.m_sampleData.size())
+        {
+            decoded.resize(end - start);
+            std::memcpy(decoded.data(), &layout.m_sampleData[start * sizeof(int16_t)], decoded.size() * sizeof(int16_t));
+        }
+    });
+
+    if (isUnsupported)
+    {
+        Logger::LogMessage("SF3 samples could not be decoded, only FLAC compressed samples are supported");
+        return false;
+    }
+
+    // sdta: PCM samples, each followed by the zeroed samples the SF2 spec asks for
+    BinaryBuffer sampleList{};
+    AppendChunkHeader(sampleList, "LIST", 0u);
+    sampleList.insert(sampleList.end(), {'s', 'd', 't', 'a'});
+    AppendChunkHeader(sampleList, "smpl", 0u);
+    const size_t sampleDataOffset(sampleList.size());
+
+    BinaryBuffer presetList(layout.m_presetList.begin(), layout.m_presetList.end());
+    char* newSampleHeaders(&presetList[layout.m_shdrOffset]);
+    uint32_t sampleOffset(0u);
+    for (uint32_t i(0u); i < numSamples; ++i)
+    {
+        char* header(&newSampleHeaders[i * SHDR_RECORD_SIZE]);
+        const uint32_t oldStart(ReadU32(&header[SHDR_START_OFFSET]));
+        const uint16_t sampleType(ReadU16(&header[SHDR_TYPE_OFFSET]));
+        const auto& decoded(decodedSamples[i]);
+
+        // Compressed loops are relative to the sample, uncompressed ones are absolute
+        const uint32_t loopBase((sampleType & SAMPLE_TYPE_COMPRESSED) != 0u ? 0u : oldStart);
+        const auto numFrames(static_cast<uint32_t>(decoded.size()));
+        const auto toLocalFrame([loopBase, numFrames](const uint32_t frame) { return std::min(frame - std::min(frame, loopBase), numFrames); });
+        const uint32_t loopStart(toLocalFrame(ReadU32(&header[SHDR_START_OFFSET + 8u])));
+        const uint32_t loopEnd(toLocalFrame(ReadU32(&header[SHDR_START_OFFSET + 12u])));
+
+        WriteU32(&header[SHDR_START_OFFSET], sampleOffset);
+        WriteU32(&header[SHDR_START_OFFSET + 4u], sampleOffset + numFrames);
+        WriteU32(&header[SHDR_START_OFFSET + 8u], sampleOffset + loopStart);
+        WriteU32(&header[SHDR_START_OFFSET + 12u], sampleOffset + loopEnd);
+        WriteU16(&header[SHDR_TYPE_OFFSET], static_cast<uint16_t>(sampleType & ~SAMPLE_TYPE_COMPRESSED));
+
+        const size_t writeOffset(sampleList.size());
+        sampleList.resize(writeOffset + (decoded.size() + NUM_TERMINATOR_SAMPLES) * sizeof(int16_t));
+        std::memcpy(&sampleList[writeOffset], decoded.data(), decoded.size() * sizeof(int16_t));
+        std::memset(&sampleList[writeOffset + decoded.size() * sizeof(int16_t)], 0, NUM_TERMINATOR_SAMPLES * sizeof(int16_t));
+        sampleOffset += numFrames + NUM_TERMINATOR_SAMPLES;
+    }
+
+    WriteU32(&sampleList[4], static_cast<uint32_t>(sampleList.size() - RIFF_HEADER_SIZE));
+    WriteU32(&sampleList[sampleDataOffset - 4u], static_cast<uint32_t>(sampleList.size() - sampleDataOffset));
+
+    // The version is only a hint, readers go by the sample types
+    BinaryBuffer infoList(layout.m_infoList.begin(), layout.m_infoList.end());
+    ForEachChunk(&infoList[RIFF_HEADER_SIZE + 4u], static_cast<uint32_t>(infoList.size()) - RIFF_HEADER_SIZE - 4u,
+        [](const std::string_view& id, const char* chunkData, const uint32_t chunkSize)
+    {
+        if (id != "ifil" || chunkSize < 4u) { return true; }
+
+        char* version(const_cast<char*>(chunkData));
+        if (ReadU16(version) == 3u)
+        {
+            WriteU16(version, 2u);
+            WriteU16(&version[2], 4u);
+        }
+
+        return false;
+    });
+
+    outSF2.clear();
+    AppendChunkHeader(outSF2, "RIFF", static_cast<uint32_t>(4u + infoList.size() + sampleList.size() + presetList.size()));
+    outSF2.insert(outSF2.end(), {'s', 'f', 'b', 'k'});
+    outSF2.insert(outSF2.end(), infoList.begin(), infoList.end());
+    outSF2.insert(outSF2.end(), sampleList.begin(), sampleList.end());
+    outSF2.insert(outSF2.end(), presetList.begin(), presetList.end());
+    return true;
+}
@@ -0,0 +1,127 @@
+#include "Header/SampleTrimmer.h"
+#include "Header/Data/Soundbank.h"
+#include "Header/Parallel.h"
+#include "Header/Profiler.h"
+#include <algorithm>
+#include <atomic>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // Compared as x > T || x < -T rather than abs(x) > T, abs(-32768) does not fit in 16 bits
+    bool IsAudible(const int16_t value)
+    {
+        return value > SampleTrimmerStatics::SILENCE_THRESHOLD || value < -SampleTrimmerStatics::SILENCE_THRESHOLD;
+    }
+
+    // Index of the first audible value in [begin, end), or end
+    size_t FindFirstAudible(const int16_t* data, size_t begin, const size_t end)
+    {
+#if defined(_M_X64) || defined(__SSE2__)
+        const __m128i upper(_mm_set1_epi16(SampleTrimmerStatics::SILENCE_THRESHOLD));
+        const __m128i lower(_mm_set1_epi16(static_cast<int16_t>(-SampleTrimmerStatics::SILENCE_THRESHOLD)));
+        for (; begin + 8 <= end; begin += 8)
+        {
+            const __m128i values(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[begin])));
+            const int mask(_mm_movemask_epi8(_mm_or_si128(_mm_cmpgt_epi16(values, upper), _mm_cmplt_epi16(values, lower))));
+            if (mask != 0) { break; }
+        }
+#endif
+        for (; begin < end; ++begin)
+        {
+            if (IsAudible(data[begin])) { return begin; }
+        }
+
+        return end;
+    }
+
+    // Index one past the last audible value in [begin, end), or begin
+    size_t FindLastAudible(const int16_t* data, const size_t begin, size_t end)
+    {
+#if defined(_M_X64) || defined(__SSE2__)
+        const __m128i upper(_mm_set1_epi16(SampleTrimmerStatics::SILENCE_THRESHOLD));
+        const __m128i lower(_mm_set1_epi16(static_cast<int16_t>(-SampleTrimmerStatics::SILENCE_THRESHOLD)));
+        for (; end >= begin + 8; end -= 8)
+        {
+            const __m128i values(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[end - 8])));
+            const int mask(_mm_movemask_epi8(_mm_or_si128(_mm_cmpgt_epi16(values, upper), _mm_cmplt_epi16(values, lower))));
+            if (mask != 0) { break; }
+        }
+#endif
+        for (; end > begin; --end)
+        {
+            if (IsAudible(data[end - 1])) { return end; }
+        }
+
+        return begin;
+    }
+}
+
+uint64_t SampleTrimmer::TrimSample(BankSample& sample)
+{
+    using namespace SampleTrimmerStatics;
+
+    const uint32_t numChannels(std::max(sample.m_channels, 1u));
+    const size_t numFrames(sample.m_sampleData.size() / numChannels);
+    if (numFrames <= MIN_FRAMES) { return 0u; }
+
+    // Channels are interleaved, so the scan works on values and rounds out to whole frames
+    const int16_t* data(sample.m_sampleData.data());
+    const size_t numValues(numFrames * numChannels);
+    const size_t firstValue(FindFirstAudible(data, 0, numValues));
+    size_t startFrame(0), endFrame(MIN_FRAMES);
+    if (firstValue != numValues)
+    {
+        const size_t firstFrame(firstValue / numChannels);
+        startFrame = firstFrame > ATTACK_MARGIN_FRAMES ? firstFrame - ATTACK_MARGIN_FRAMES : 0;
+        endFrame = (FindLastAudible(data, firstValue, numValues) + numChannels - 1) / numChannels;
+    }
+
+    if (sample.m_isLooping && sample.m_loopEnd > sample.m_loopStart)
+    {
+        startFrame = std::min<size_t>(startFrame, sample.m_loopStart > LOOP_GUARD_FRAMES ? sample.m_loopStart - LOOP_GUARD_FRAMES : 0u);
+        endFrame = std::max<size_t>(endFrame, static_cast<size_t>(sample.m_loopEnd) + LOOP_GUARD_FRAMES);
+    }
+
+    endFrame = std::min(std::max(endFrame, startFrame + MIN_FRAMES), numFrames);
+    if (startFrame == 0 && endFrame == numFrames) { return 0u; }
+
+    auto& sampleData(sample.m_sampleData);
+    sampleData.erase(sampleData.begin() + static_cast<ptrdiff_t>(endFrame * numChannels), sampleData.end());
+    sampleData.erase(sampleData.begin(), sampleData.begin() + static_cast<ptrdiff_t>(startFrame * numChannels));
+    sampleData.shrink_to_fit();
+
+    // Non-looping samples can still carry loop points, keep them inside the sample either way
+    const auto newNumFrames(static_cast<uint32_t>(endFrame - startFrame));
+    const auto shiftPosition([startFrame, newNumFrames](const uint32_t position)
+    {
+        return std::min(static_cast<uint32_t>(position > startFrame ? position - startFrame : 0u), newNumFrames);
+    });
+
+    sample.m_loopStart = shiftPosition(sample.m_loopStart);
+    sample.m_loopEnd = shiftPosition(sample.m_loopEnd);
+    return numFrames - newNumFrames;
+}
+
+SampleTrimResult SampleTrimmer::TrimBank(Soundbank& bank)
+{
+    const Profiler::StageScope trimScope(EProfileStage::SAMPLE_TRIM);
+
+    std::atomic<uint32_t> numTrimmedSamples(0u);
+    std::atomic<uint64_t> bytesSaved(0u);
+    Parallel::For(bank.m_samples.size(), [&](const size_t i, uint32_t)
+    {
+        auto& sample(bank.m_samples[i]);
+        const uint64_t numFramesRemoved(TrimSample(sample));
+        if (numFramesRemoved == 0u) { return; }
+
+        ++numTrimmedSamples;
+        bytesSaved += numFramesRemoved * std::max(sample.m_channels, 1u) * sizeof(int16_t);
+    });
+
+    Profiler::AddCounter(EProfileCounter::BYTES_TRIMMED, bytesSaved.load());
+    return {numTrimmedSamples.load(), bytesSaved.load()};
+}
@@ -0,0 +1,84 @@
+#include "Header/SequenceQuery.h"
+#include "Header/BatchManifest.h"
+#include "Header/IO/E4BReader.h"
+#include "Header/Logger.h"
+#include "Header/Parallel.h"
+
+void SequenceQuery::Start(std::vector<std::filesystem::path> files)
+{
+    Cancel();
+
+    {
+        std::lock_guard lock(m_resultsMutex);
+        m_results.assign(files.size(), nullptr);
+    }
+
+    m_numFiles = static_cast<uint32_t>(files.size());
+    m_numFilesDone = 0u;
+    m_isCancelled = false;
+    m_isRunning = true;
+    m_thread = std::thread([this, files = std::move(files)]
+    {
+        Run(files);
+        m_isRunning = false;
+    });
+}
+
+void SequenceQuery::Cancel()
+{
+    m_isCancelled = true;
+    if (m_thread.joinable()) { m_thread.join(); }
+}
+
+std::vector<std::shared_ptr<const SequenceQueryResult>> SequenceQuery::GetResults() const
+{
+    std::vector<std::shared_ptr<const SequenceQueryResult>> outResults{};
+
+    std::lock_guard lock(m_resultsMutex);
+    for (const auto& result : m_results)
+    {
+        if (result != nullptr) { outResults.emplace_back(result); }
+    }
+
+    return outResults;
+}
+
+void SequenceQuery::Run(const std::vector<std::filesystem::path>& files)
+{
+    Parallel::For(files.size(), [&](const size_t index, uint32_t)
+    {
+        if (m_isCancelled.load()) { return; }
+
+        const auto& file(files[index]);
+        const auto cacheKey(BatchManifest::PathToUTF8(file.lexically_normal()));
+
+        // Separate codes, a successful last_write_time would clear a failed file_size
+        std::error_code sizeErrorCode, timeErrorCode;
+        const auto fileSize(std::filesystem::file_size(file, sizeErrorCode));
+        const auto fileWriteTime(std::filesystem::last_write_time(file, timeErrorCode).time_since_epoch().count());
+        const bool hasFileStamp(!sizeErrorCode && !timeErrorCode);
+        if (hasFileStamp)
+        {
+            std::lock_guard lock(m_resultsMutex);
+            if (const auto it(m_cache.find(cacheKey)); it != m_cache.end() && it->second.m_fileSize == fileSize && it->second.m_fileWriteTime == fileWriteTime)
+            {
+                m_results[index] = it->second.m_result;
+                ++m_numFilesDone;
+                return;
+            }
+        }
+
+        auto result(std::make_shared<SequenceQueryResult>());
+        result->m_file = file;
+        result->m_bankName = file.filename().replace_extension("").string();
+        if (hasFileStamp && E4BReader::ReadSequences(file, result->m_sequences))
+        {
+            std::lock_guard lock(m_resultsMutex);
+            m_cache.insert_or_assign(cacheKey, CacheEntry{result, fileSize, fileWriteTime});
+            m_results[index] = std::move(result);
+        }
+        else { Logger::LogMessage("Unable to read the sequences of '%s'", file.filename().string().c_str()); }
+
+        ++m_numFilesDone;
+    });
+}